@@ -146,6 +146,12 @@ namespace TrenchBroom {
     
     static Func2<GLint, GLuint, const GLchar*>& _glGetUniformLocation = glGetUniformLocation;
     
+    static Func0<GLboolean>& _glTimerQueriesAvailable = glTimerQueriesAvailable;
+    static Func2<void, GLsizei, GLuint*>& _glGenQueries = glGenQueries;
+    static Func2<void, GLuint, GLenum>& _glQueryCounter = glQueryCounter;
+    static Func3<void, GLuint, GLenum, GLint*>& _glGetQueryObjectiv = glGetQueryObjectiv;
+    static Func3<void, GLuint, GLenum, GLuint64*>& _glGetQueryObjectui64v = glGetQueryObjectui64v;
+    
 #ifdef __APPLE__
     static Func2<void, GLenum, GLint>& _glFinishObjectAPPLE = glFinishObjectAPPLE;
 #endif
@@ -154,6 +160,10 @@ namespace TrenchBroom {
 #include <GL/glew.h>
 
 namespace TrenchBroom {
+    static GLboolean timerQueriesAvailable() {
+        return GLEW_ARB_timer_query;
+    }
+    
     static void initRemainingFunctions() {
         _glGetError.bindFunc(&::glGetError);
         _glGetString.bindFunc(&::glGetString);
@@ -275,6 +285,14 @@ namespace TrenchBroom {
         
         _glGetUniformLocation.bindFunc(glGetUniformLocation);
         
+        _glTimerQueriesAvailable.bindFunc(&timerQueriesAvailable);
+        if (GLEW_ARB_timer_query) {
+            _glGenQueries.bindFunc(glGenQueries);
+            _glQueryCounter.bindFunc(glQueryCounter);
+            _glGetQueryObjectiv.bindFunc(glGetQueryObjectiv);
+            _glGetQueryObjectui64v.bindFunc(glGetQueryObjectui64v);
+        }
+        
 #ifdef __APPLE__
         _glFinishObjectAPPLE.bindFunc(glFinishObjectAPPLE);
 #endif
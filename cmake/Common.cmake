@@ -15,4 +15,10 @@ FILE(GLOB_RECURSE COMMON_HEADER
 	SET_XCODE_ATTRIBUTES(common)
 #ENDIF()
 
+# OBJECT libraries cannot link to other libraries, so the thread library is linked into the executables that use
+# the common objects, but the common sources must still be compiled with the thread flag
+IF(THREADS_HAVE_PTHREAD_ARG)
+	TARGET_COMPILE_OPTIONS(common PRIVATE "-pthread")
+ENDIF()
+
 INCLUDE_DIRECTORIES(${COMMON_SOURCE_DIR})
@@ -20,183 +20,431 @@
 #ifndef TrenchBroom_Allocator_h
 #define TrenchBroom_Allocator_h
 
+#include <atomic>
 #include <cassert>
-#include <iostream>
-#include <limits>
-#include <stack>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <type_traits>
 #include <vector>
 
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef _MSC_VER
+#include <cstdint>
+#elif defined __GNUC__
+#include <stdint.h>
+#endif
+
 // Undefine this to prevent false positives when looking for memory leaks.
 #define TB_ENABLE_ALLOCATOR 1
 
-template <class T, size_t PoolSize = 64, size_t BlocksPerChunk = 256>
+/**
+ Pooled allocation for small objects which are created and destroyed in large numbers. Blocks are carved
+ out of chunks, and every thread allocates from its own heap of chunks so that no locking is necessary on
+ the common paths.
+ 
+ A block may be freed on any thread. If the freeing thread does not own the block's heap, the block is
+ pushed onto the owning heap's lock free list of remote frees, which the owner collects when it runs out of
+ free blocks or when a chunk's worth of remote frees has piled up. When a thread exits, its heap is parked,
+ including any live blocks, and handed to the next thread which needs one, so blocks can safely outlive the
+ thread that allocated them. Blocks freed into a parked heap are collected right away under the registry's
+ lock, so that the chunks of a heap without an owner are still released.
+ 
+ Chunks are aligned to their size, which is a power of two, so a block finds its chunk by masking its address
+ and needs no header. A chunk holds at least MinBlocksPerChunk blocks and uses the rest of its size for more.
+ */
+template <class T, size_t MinBlocksPerChunk = 256, size_t SpareChunks = 1>
 class Allocator {
+public:
+    struct Statistics {
+        size_t liveBlocks;
+        size_t peakLiveBlocks;
+        size_t chunks;
+        size_t heaps;
+    };
+private:
+    struct Chunk;
+    class Heap;
+    
+    union Block {
+        Block* next;
+        typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+        
+        static Block* fromPointer(void* t) {
+            return reinterpret_cast<Block*>(t);
+        }
+    };
+    
+    struct ChunkHeader {
+        Heap* owner;
+        Chunk* previous;
+        Chunk* next;
+        Block* freeBlocks;
+        size_t freeCount;
+        
+        ChunkHeader(Heap* i_owner, Block* i_freeBlocks, const size_t i_freeCount) :
+        owner(i_owner),
+        previous(NULL),
+        next(NULL),
+        freeBlocks(i_freeBlocks),
+        freeCount(i_freeCount) {}
+    };
+    
+    template <size_t N, size_t P = 1, bool Done = (P >= N)>
+    struct NextPowerOfTwo {
+        static const size_t value = NextPowerOfTwo<N, 2 * P>::value;
+    };
+    
+    template <size_t N, size_t P>
+    struct NextPowerOfTwo<N, P, true> {
+        static const size_t value = P;
+    };
+    
+    static const size_t BlockAlignment = std::alignment_of<Block>::value;
+    static const size_t HeaderSize = (sizeof(ChunkHeader) + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+    static const size_t ChunkSize = NextPowerOfTwo<HeaderSize + MinBlocksPerChunk * sizeof(Block)>::value;
+public:
+    static const size_t BlocksPerChunk = (ChunkSize - HeaderSize) / sizeof(Block);
 private:
-    class Chunk {
+    struct Chunk : public ChunkHeader {
+        Block blocks[BlocksPerChunk];
+        
+        explicit Chunk(Heap* i_owner) :
+        ChunkHeader(i_owner, &blocks[0], BlocksPerChunk) {
+            for (size_t i = 0; i < BlocksPerChunk; ++i)
+                blocks[i].next = i + 1 < BlocksPerChunk ? &blocks[i + 1] : NULL;
+        }
+        
+        static Chunk* fromBlock(Block* block) {
+            return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(block) & ~static_cast<uintptr_t>(ChunkSize - 1));
+        }
+        
+        static Chunk* create(Heap* owner) {
+            static_assert(sizeof(Chunk) <= ChunkSize, "chunk does not fit into its alignment");
+#ifdef _WIN32
+            void* memory = _aligned_malloc(ChunkSize, ChunkSize);
+            if (memory == NULL)
+                throw std::bad_alloc();
+#else
+            void* memory = NULL;
+            if (posix_memalign(&memory, ChunkSize, ChunkSize) != 0)
+                throw std::bad_alloc();
+#endif
+            return new (memory) Chunk(owner);
+        }
+        
+        static void destroy(Chunk* chunk) {
+            chunk->~Chunk();
+#ifdef _WIN32
+            _aligned_free(chunk);
+#else
+            std::free(chunk);
+#endif
+        }
+        
+        bool full() const {
+            return this->freeCount == 0;
+        }
+        
+        bool empty() const {
+            return this->freeCount == BlocksPerChunk;
+        }
+    };
+    
+    /**
+     A list of chunks with free blocks, which is only ever touched by the thread that currently owns the
+     heap, and a stack of blocks which other threads have freed.
+     */
+    class Heap {
     private:
-        unsigned char m_blocks[BlocksPerChunk * sizeof(T)];
-        unsigned char m_firstFreeBlock;
-        unsigned char m_numFreeBlocks;
+        static const size_t RemoteFreeThreshold = BlocksPerChunk;
+        
+        Chunk* m_available;
+        size_t m_spareChunks;
+        std::atomic<Block*> m_remoteFrees;
+        std::atomic<size_t> m_remoteFreeCount;
+        std::atomic<bool> m_parked;
     public:
-        Chunk() :
-        m_firstFreeBlock(0),
-        m_numFreeBlocks(BlocksPerChunk - 1) {
-            for (size_t i = 0; i < BlocksPerChunk - 1; i++)
-                m_blocks[i * sizeof(T)] = static_cast<unsigned char>(i + 1);
+        Heap() :
+        m_available(NULL),
+        m_spareChunks(0),
+        m_remoteFrees(NULL),
+        m_remoteFreeCount(0),
+        m_parked(false) {}
+        
+        void* allocate() {
+            if (m_available == NULL || remoteFreesPending())
+                collectRemoteFrees();
+            if (m_available == NULL) {
+                link(Chunk::create(this));
+                ++m_spareChunks;
+                ++counters().chunks;
+            }
+            
+            Chunk* chunk = m_available;
+            if (chunk->empty())
+                --m_spareChunks;
+            
+            Block* block = chunk->freeBlocks;
+            chunk->freeBlocks = block->next;
+            --chunk->freeCount;
+            
+            if (chunk->full())
+                unlink(chunk);
+            return &block->storage;
         }
         
-        bool contains(const T* t) const {
-            const unsigned char* block = reinterpret_cast<const unsigned char*>(t);
-            if (block < m_blocks)
-                return false;
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            return offset < (BlocksPerChunk - 1) * sizeof(T);
+        void deallocate(Block* block) {
+            release(block);
+            if (remoteFreesPending())
+                collectRemoteFrees();
         }
         
-        T* allocate() {
-            if (m_numFreeBlocks == 0)
-                return NULL;
-            
-            unsigned char* block = m_blocks + m_firstFreeBlock * sizeof(T);
-            m_firstFreeBlock = *block;
-            m_numFreeBlocks--;
-            return reinterpret_cast<T*>(block);
+        void deallocateRemote(Block* block) {
+            // count first so that the count never drops below the number of blocks in the list
+            m_remoteFreeCount.fetch_add(1, std::memory_order_relaxed);
+            Block* head = m_remoteFrees.load(std::memory_order_relaxed);
+            do {
+                block->next = head;
+            } while (!m_remoteFrees.compare_exchange_weak(head, block));
+        }
+        
+        // Must only be called by the heap's owner, or with the registry's lock held if the heap is parked.
+        void collectRemoteFrees() {
+            Block* block = m_remoteFrees.exchange(NULL);
+            size_t count = 0;
+            while (block != NULL) {
+                Block* next = block->next;
+                release(block);
+                block = next;
+                ++count;
+            }
+            if (count > 0)
+                m_remoteFreeCount.fetch_sub(count, std::memory_order_relaxed);
+        }
+        
+        bool parked() const {
+            return m_parked.load();
         }
         
-        void deallocate(T* t) {
-            assert(m_numFreeBlocks < BlocksPerChunk - 1);
-            assert(contains(t));
+        void park() {
+            m_parked.store(true);
+            collectRemoteFrees();
+        }
+        
+        void adopt() {
+            m_parked.store(false);
+            collectRemoteFrees();
+        }
+    private:
+        bool remoteFreesPending() const {
+            return m_remoteFreeCount.load(std::memory_order_relaxed) >= RemoteFreeThreshold;
+        }
+        
+        void release(Block* block) {
+            Chunk* chunk = Chunk::fromBlock(block);
+            assert(chunk->owner == this);
+            
+            if (chunk->full())
+                link(chunk);
             
-            unsigned char* block = reinterpret_cast<unsigned char*>(t);
-            assert(block >= m_blocks);
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            assert(offset % sizeof(T) == 0);
+            block->next = chunk->freeBlocks;
+            chunk->freeBlocks = block;
+            ++chunk->freeCount;
             
-            size_t index = offset / sizeof(T);
-            assert(index < BlocksPerChunk);
+            if (chunk->empty()) {
+                if (m_spareChunks < SpareChunks) {
+                    ++m_spareChunks;
+                } else {
+                    unlink(chunk);
+                    Chunk::destroy(chunk);
+                    --counters().chunks;
+                }
+            }
+        }
+        
+        void link(Chunk* chunk) {
+            chunk->previous = NULL;
+            chunk->next = m_available;
+            if (m_available != NULL)
+                m_available->previous = chunk;
+            m_available = chunk;
+        }
+        
+        void unlink(Chunk* chunk) {
+            if (chunk->previous != NULL)
+                chunk->previous->next = chunk->next;
+            else
+                m_available = chunk->next;
+            if (chunk->next != NULL)
+                chunk->next->previous = chunk->previous;
+            chunk->previous = chunk->next = NULL;
+        }
+    };
+    
+    /**
+     Keeps every heap ever created. Heaps are never destroyed because other threads may still free blocks
+     into them after their thread has exited.
+     */
+    class HeapRegistry {
+    private:
+        std::mutex m_mutex;
+        std::vector<Heap*> m_unusedHeaps;
+        size_t m_heapCount;
+    public:
+        HeapRegistry() :
+        m_heapCount(0) {}
+        
+        Heap* acquire() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_unusedHeaps.empty()) {
+                ++m_heapCount;
+                return new Heap();
+            }
             
-            *block = m_firstFreeBlock;
-            m_firstFreeBlock = static_cast<unsigned char>(index);
-            m_numFreeBlocks++;
+            Heap* heap = m_unusedHeaps.back();
+            m_unusedHeaps.pop_back();
+            heap->adopt();
+            return heap;
         }
         
-        bool empty() const {
-            return m_numFreeBlocks == BlocksPerChunk - 1;
+        void release(Heap* heap) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            heap->park();
+            m_unusedHeaps.push_back(heap);
         }
         
-        bool full() const {
-            return m_numFreeBlocks == 0;
+        // Allocates a block for a thread that is exiting and has already released its heap.
+        void* allocateParked() {
+            Heap* heap = acquire();
+            void* block = heap->allocate();
+            release(heap);
+            return block;
+        }
+        
+        // Collects the remote frees of a heap which has no owner. The lock keeps the heap from being adopted meanwhile.
+        void collect(Heap* heap) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (heap->parked())
+                heap->collectRemoteFrees();
+        }
+        
+        size_t heapCount() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_heapCount;
         }
     };
     
-    typedef std::vector<Chunk*> ChunkList;
-    typedef std::stack<T*> Pool;
+    /**
+     The heap of a thread. It is trivially destructible, so it can still be read while the thread's other thread
+     local objects are destroyed.
+     */
+    struct ThreadHeap {
+        Heap* heap;
+        bool released;
+    };
+    
+    // Acquires a heap for the calling thread and releases it when the thread exits.
+    class LocalHeap {
+    public:
+        LocalHeap() {
+            threadHeap().heap = registry().acquire();
+        }
+        
+        ~LocalHeap() {
+            ThreadHeap& local = threadHeap();
+            registry().release(local.heap);
+            local.heap = NULL;
+            local.released = true;
+        }
+    };
+    
+    struct Counters {
+        std::atomic<size_t> liveBlocks;
+        std::atomic<size_t> peakLiveBlocks;
+        std::atomic<size_t> chunks;
+        
+        Counters() :
+        liveBlocks(0),
+        peakLiveBlocks(0),
+        chunks(0) {}
+    };
+    
+    static HeapRegistry& registry() {
+        static HeapRegistry* registry = new HeapRegistry();
+        return *registry;
+    }
+    
+    static ThreadHeap& threadHeap() {
+        static thread_local ThreadHeap local = { NULL, false };
+        return local;
+    }
     
-    static Pool& pool() {
-        static Pool p;
-        return p;
+    // Returns the calling thread's heap, acquiring one on its first allocation, or null if the thread is exiting.
+    static Heap* localHeap() {
+        const ThreadHeap& local = threadHeap();
+        if (local.heap == NULL && !local.released) {
+            static thread_local LocalHeap heap;
+        }
+        return local.heap;
     }
     
-    static ChunkList& fullChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static Counters& counters() {
+        static Counters counters;
+        return counters;
     }
     
-    static ChunkList& mixedChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static void countAllocation() {
+        const size_t live = counters().liveBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t peak = counters().peakLiveBlocks.load(std::memory_order_relaxed);
+        while (live > peak && !counters().peakLiveBlocks.compare_exchange_weak(peak, live, std::memory_order_relaxed));
     }
     
-    static ChunkList emptyChunks() {
-        static ChunkList chunks;
-        return chunks;
+    static void countDeallocation() {
+        counters().liveBlocks.fetch_sub(1, std::memory_order_relaxed);
     }
 public:
+    static Statistics statistics() {
+        Statistics result;
+        result.liveBlocks = counters().liveBlocks.load(std::memory_order_relaxed);
+        result.peakLiveBlocks = counters().peakLiveBlocks.load(std::memory_order_relaxed);
+        result.chunks = counters().chunks.load(std::memory_order_relaxed);
+        result.heaps = registry().heapCount();
+        return result;
+    }
 #ifdef TB_ENABLE_ALLOCATOR
     void* operator new(size_t size) {
         assert(size == sizeof(T));
-        
-        if (!pool().empty()) {
-            T* t = pool().top();
-            pool().pop();
-            return t;
-        }
-        
-        Chunk* chunk = NULL;
-        if (mixedChunks().empty()) {
-            if (!emptyChunks().empty()) {
-                chunk = emptyChunks().back();
-                emptyChunks().pop_back();
-            } else {
-                chunk = new Chunk();
-            }
-        } else {
-            chunk = mixedChunks().back();
-            mixedChunks().pop_back();
-        }
-        
-        assert(!chunk->full());
-        T* block = chunk->allocate();
-        
-        if (chunk->full())
-            fullChunks().push_back(chunk);
-            else
-                mixedChunks().push_back(chunk);
-                return block;
+        Heap* heap = localHeap();
+        void* t = heap != NULL ? heap->allocate() : registry().allocateParked();
+        countAllocation();
+        return t;
     }
     
-    void operator delete(void* block) {
-        T* t = reinterpret_cast<T*>(block);
-        
-        if (PoolSize > 0 && pool().size() < PoolSize) {
-            pool().push(t);
+    void operator delete(void* t) {
+        if (t == NULL)
             return;
-        }
         
-        typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
-        fullIt = fullChunks().rbegin();
-        fullEnd = fullChunks().rend();
-        mixedIt = mixedChunks().rbegin();
-        mixedEnd = mixedChunks().rend();
-        
-        Chunk* chunk = NULL;
-        while (fullIt < fullEnd || mixedIt < mixedEnd) {
-            if (fullIt < fullEnd) {
-                Chunk* fullChunk = *fullIt;
-                if (fullChunk->contains(t)) {
-                    chunk = fullChunk;
-                    break;
-                }
-                ++fullIt;
-            }
-            if (mixedIt < mixedEnd) {
-                Chunk* mixedChunk = *mixedIt;
-                if (mixedChunk->contains(t)) {
-                    chunk = mixedChunk;
-                    break;
-                }
-                ++mixedIt;
-            }
-        }
-        
-        assert(chunk != NULL);
-        
-        if (chunk->full()) {
-            fullChunks().erase((fullIt + 1).base());
-            mixedChunks().push_back(chunk);
-        }
-        
-        chunk->deallocate(t);
-        
-        if (chunk->empty()) {
-            mixedChunks().erase((mixedIt + 1).base());
-            if (emptyChunks().size() < 2)
-                emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
+        // never acquire a heap here, since threads that only free blocks don't need one
+        Block* block = Block::fromPointer(t);
+        Heap* owner = Chunk::fromBlock(block)->owner;
+        if (owner == threadHeap().heap) {
+            owner->deallocate(block);
+        } else {
+            owner->deallocateRemote(block);
+            if (owner->parked())
+                registry().collect(owner);
         }
+        countDeallocation();
     }
 #endif
 };
 
+template <class T, size_t MinBlocksPerChunk, size_t SpareChunks>
+const size_t Allocator<T, MinBlocksPerChunk, SpareChunks>::BlocksPerChunk;
+
 #endif
@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelLoadQueue.h"
+
+#include "Exceptions.h"
+#include "Assets/EntityModel.h"
+#include "IO/EntityModelLoader.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Assets {
+        EntityModelLoadQueue::Result::Result(const IO::Path& i_path, EntityModel* i_model, const String& i_error) :
+        path(i_path),
+        model(i_model),
+        error(i_error) {}
+
+        EntityModelLoadQueue::EntityModelLoadQueue() :
+        m_loader(nullptr),
+        // hardware_concurrency returns 0 if the number of cores is unknown, so clamp it before leaving a core to the UI
+        m_maxWorkers(std::min(4u, std::max(2u, std::thread::hardware_concurrency()) - 1)),
+        m_stop(false) {}
+        
+        EntityModelLoadQueue::~EntityModelLoadQueue() {
+            cancel();
+            stopWorkers();
+        }
+
+        void EntityModelLoadQueue::setLoader(const IO::EntityModelLoader* loader) {
+            cancel();
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_loader = loader;
+        }
+
+        bool EntityModelLoadQueue::enqueue(const IO::Path& path) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_loader == nullptr || !m_pending.insert(path).second)
+                return false;
+            
+            m_queue.push_back(path);
+            startWorkers();
+            m_workAvailable.notify_one();
+            return true;
+        }
+
+        bool EntityModelLoadQueue::pending(const IO::Path& path) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_pending.count(path) > 0;
+        }
+        
+        bool EntityModelLoadQueue::hasPending() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return !m_pending.empty();
+        }
+
+        void EntityModelLoadQueue::waitFor(const IO::Path& path) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            
+            const PathQueue::iterator it = std::find(std::begin(m_queue), std::end(m_queue), path);
+            if (it != std::end(m_queue)) {
+                // not started yet, the caller is going to load it anyway
+                m_queue.erase(it);
+                m_pending.erase(path);
+            } else {
+                while (m_inProgress.count(path) > 0)
+                    m_workDone.wait(lock);
+            }
+        }
+
+        EntityModelLoadQueue::ResultList EntityModelLoadQueue::collect() {
+            ResultList results;
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            using std::swap;
+            swap(results, m_results);
+            
+            for (const Result& result : results)
+                m_pending.erase(result.path);
+            return results;
+        }
+
+        void EntityModelLoadQueue::cancel() {
+            ResultList results;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_queue.clear();
+                while (!m_inProgress.empty())
+                    m_workDone.wait(lock);
+                
+                using std::swap;
+                swap(results, m_results);
+                m_pending.clear();
+            }
+            deleteModels(results);
+        }
+
+        void EntityModelLoadQueue::startWorkers() {
+            // the caller must hold the lock
+            if (m_workers.size() < std::min(m_maxWorkers, m_queue.size() + m_inProgress.size()))
+                m_workers.push_back(std::thread(&EntityModelLoadQueue::run, this));
+        }
+        
+        void EntityModelLoadQueue::stopWorkers() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_workAvailable.notify_all();
+            
+            for (std::thread& worker : m_workers)
+                worker.join();
+            m_workers.clear();
+        }
+
+        void EntityModelLoadQueue::run() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                while (!m_stop && m_queue.empty())
+                    m_workAvailable.wait(lock);
+                if (m_stop)
+                    return;
+                
+                const IO::Path path = m_queue.front();
+                const IO::EntityModelLoader* loader = m_loader;
+                m_queue.pop_front();
+                m_inProgress.insert(path);
+                
+                lock.unlock();
+
+                EntityModel* model = nullptr;
+                String error;
+                try {
+                    model = loader->loadEntityModel(path);
+                    if (model == nullptr)
+                        error = "Unknown error";
+                } catch (const Exception& e) {
+                    error = e.what();
+                }
+                
+                lock.lock();
+                m_inProgress.erase(path);
+                m_results.push_back(Result(path, model, error));
+                m_workDone.notify_all();
+            }
+        }
+
+        void EntityModelLoadQueue::deleteModels(ResultList& results) {
+            for (Result& result : results)
+                delete result.model;
+            results.clear();
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_EntityModelLoadQueue
+#define TrenchBroom_EntityModelLoadQueue
+
+#include "Macros.h"
+#include "StringUtils.h"
+#include "IO/Path.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class EntityModelLoader;
+    }
+    
+    namespace Assets {
+        class EntityModel;
+        
+        // Parses entity models on background threads. The loader must only read from the game file system, and it
+        // must remain valid until the queue has been cancelled.
+        class EntityModelLoadQueue {
+        public:
+            struct Result {
+                IO::Path path;
+                EntityModel* model;
+                String error;
+                
+                Result(const IO::Path& i_path, EntityModel* i_model, const String& i_error);
+            };
+            typedef std::vector<Result> ResultList;
+        private:
+            typedef std::vector<std::thread> WorkerList;
+            typedef std::deque<IO::Path> PathQueue;
+            typedef std::set<IO::Path> PathSet;
+            
+            const IO::EntityModelLoader* m_loader;
+            const size_t m_maxWorkers;
+            WorkerList m_workers;
+            
+            mutable std::mutex m_mutex;
+            std::condition_variable m_workAvailable;
+            std::condition_variable m_workDone;
+            
+            PathQueue m_queue;
+            PathSet m_pending;
+            PathSet m_inProgress;
+            ResultList m_results;
+            bool m_stop;
+        public:
+            EntityModelLoadQueue();
+            ~EntityModelLoadQueue();
+            
+            void setLoader(const IO::EntityModelLoader* loader);
+            
+            bool enqueue(const IO::Path& path);
+            bool pending(const IO::Path& path) const;
+            bool hasPending() const;
+            
+            void waitFor(const IO::Path& path);
+            ResultList collect();
+            
+            void cancel();
+        private:
+            void startWorkers();
+            void stopWorkers();
+            void run();
+            
+            static void deleteModels(ResultList& results);
+            
+            deleteCopyAndAssignment(EntityModelLoadQueue)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityModelLoadQueue) */
@@ -34,13 +34,15 @@ namespace TrenchBroom {
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_modelGeneration(0) {}
         
         EntityModelManager::~EntityModelManager() {
             clear();
         }
         
         void EntityModelManager::clear() {
+            m_loadQueue.cancel();
             MapUtils::clearAndDelete(m_renderers);
             MapUtils::clearAndDelete(m_models);
             m_rendererMismatches.clear();
@@ -61,6 +63,7 @@ namespace TrenchBroom {
         void EntityModelManager::setLoader(const IO::EntityModelLoader* loader) {
             clear();
             m_loader = loader;
+            m_loadQueue.setLoader(loader);
         }
 
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
@@ -74,6 +77,18 @@ namespace TrenchBroom {
             if (m_modelMismatches.count(path) > 0)
                 return nullptr;
             
+            if (m_loadQueue.pending(path)) {
+                // the caller needs the model right now, so take it from the background loader or load it here
+                m_loadQueue.waitFor(path);
+                addLoadedModels();
+                
+                it = m_models.find(path);
+                if (it != std::end(m_models))
+                    return it->second;
+                if (m_modelMismatches.count(path) > 0)
+                    return nullptr;
+            }
+            
             try {
                 EntityModel* model = loadModel(path);
                 ensure(model != nullptr, "model is null");
@@ -99,11 +114,19 @@ namespace TrenchBroom {
         }
         
         Renderer::TexturedIndexRangeRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
-            EntityModel* entityModel = safeGetModel(spec.path);
-
-            if (entityModel == nullptr)
+            if (spec.path.isEmpty())
                 return nullptr;
             
+            // don't block the caller, the model will be parsed in the background and picked up by collectLoadedModels
+            ModelCache::const_iterator modelIt = m_models.find(spec.path);
+            if (modelIt == std::end(m_models)) {
+                if (m_modelMismatches.count(spec.path) == 0)
+                    m_loadQueue.enqueue(spec.path);
+                return nullptr;
+            }
+            
+            EntityModel* entityModel = modelIt->second;
+            
             RendererCache::const_iterator it = m_renderers.find(spec);
             if (it != std::end(m_renderers))
                 return it->second;
@@ -135,10 +158,44 @@ namespace TrenchBroom {
             return renderer(spec) != nullptr;
         }
 
+        bool EntityModelManager::hasPendingModels() const {
+            return m_loadQueue.hasPending();
+        }
+        
+        bool EntityModelManager::collectLoadedModels() {
+            if (!addLoadedModels())
+                return false;
+            ++m_modelGeneration;
+            return true;
+        }
+        
+        size_t EntityModelManager::modelGeneration() const {
+            return m_modelGeneration;
+        }
+
         EntityModel* EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->loadEntityModel(path);
         }
+        
+        bool EntityModelManager::addLoadedModels() const {
+            const EntityModelLoadQueue::ResultList results = m_loadQueue.collect();
+            for (const EntityModelLoadQueue::Result& result : results) {
+                if (result.model != nullptr) {
+                    m_models[result.path] = result.model;
+                    m_unpreparedModels.push_back(result.model);
+                    
+                    if (m_logger != nullptr)
+                        m_logger->debug("Loaded entity model %s", result.path.asString().c_str());
+                } else {
+                    m_modelMismatches.insert(result.path);
+                    
+                    if (m_logger != nullptr)
+                        m_logger->debug("Failed to load entity model %s: %s", result.path.asString().c_str(), result.error.c_str());
+                }
+            }
+            return !results.empty();
+        }
 
         void EntityModelManager::prepare(Renderer::Vbo& vbo) {
             resetTextureMode();
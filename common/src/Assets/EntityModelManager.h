@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Assets/EntityModelLoadQueue.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
@@ -67,6 +68,9 @@ namespace TrenchBroom {
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+            
+            mutable EntityModelLoadQueue m_loadQueue;
+            size_t m_modelGeneration;
         public:
             EntityModelManager(Logger* logger, int minFilter, int magFilter);
             ~EntityModelManager();
@@ -82,8 +86,13 @@ namespace TrenchBroom {
             
             bool hasModel(const Model::Entity* entity) const;
             bool hasModel(const Assets::ModelSpecification& spec) const;
+            
+            bool hasPendingModels() const;
+            bool collectLoadedModels();
+            size_t modelGeneration() const;
         private:
             EntityModel* loadModel(const IO::Path& path) const;
+            bool addLoadedModels() const;
         public:
             void prepare(Renderer::Vbo& vbo);
         private:
@@ -60,28 +60,51 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
-        Md2Model::Md2Model(const String& name, const TextureList& skins, const FrameList& frames) :
+        Md2Model::FrameBuilder::~FrameBuilder() {}
+        
+        size_t Md2Model::FrameBuilder::frameCount() const {
+            return doGetFrameCount();
+        }
+        
+        Md2Model::Frame* Md2Model::FrameBuilder::buildFrame(const size_t frameIndex) const {
+            assert(frameIndex < frameCount());
+            return doBuildFrame(frameIndex);
+        }
+
+        Md2Model::Md2Model(const String& name, const TextureList& skins, FrameBuilder* frameBuilder) :
         m_name(name),
         m_skins(new TextureCollection(IO::Path(name), skins)),
-        m_frames(frames) {}
+        m_frameBuilder(frameBuilder),
+        m_frames(m_frameBuilder->frameCount(), NULL) {}
         
         Md2Model::~Md2Model() {
             VectorUtils::clearAndDelete(m_frames);
+            delete m_frameBuilder;
+            m_frameBuilder = NULL;
             delete m_skins;
             m_skins = NULL;
         }
 
+        const Md2Model::Frame* Md2Model::frame(const size_t frameIndex) const {
+            ensure(frameIndex < m_frames.size(), "frame index out of range");
+            
+            // most models are only ever displayed in one frame, so we only expand the frames that are requested
+            Frame*& result = m_frames[frameIndex];
+            if (result == NULL)
+                result = m_frameBuilder->buildFrame(frameIndex);
+            return result;
+        }
+
         Renderer::TexturedIndexRangeRenderer* Md2Model::doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             const TextureList& textures = m_skins->textures();
             
             ensure(skinIndex < textures.size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
 
             const Assets::Texture* skin = textures[skinIndex];
-            const Frame* frame = m_frames[frameIndex];
+            const Frame* modelFrame = frame(frameIndex);
             
-            const VertexList& vertices = frame->vertices();
-            const Renderer::IndexRangeMap& indices = frame->indices();
+            const VertexList& vertices = modelFrame->vertices();
+            const Renderer::IndexRangeMap& indices = modelFrame->indices();
             
             const Renderer::VertexArray vertexArray = Renderer::VertexArray::ref(vertices);
             const Renderer::TexturedIndexRangeMap texturedIndices(skin, indices);
@@ -91,18 +114,12 @@ namespace TrenchBroom {
         
         BBox3f Md2Model::doGetBounds(const size_t skinIndex, const size_t frameIndex) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
-            
-            const Frame* frame = m_frames[frameIndex];
-            return frame->bounds();
+            return frame(frameIndex)->bounds();
         }
         
         BBox3f Md2Model::doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
-            
-            const Frame* frame = m_frames[frameIndex];
-            return frame->transformedBounds(transformation);
+            return frame(frameIndex)->transformedBounds(transformation);
         }
 
         void Md2Model::doPrepare(const int minFilter, const int magFilter) {
@@ -54,14 +54,29 @@ namespace TrenchBroom {
             };
 
             typedef std::vector<Frame*> FrameList;
+            
+            // Builds the expanded vertices of a frame from the compact data in the model file.
+            class FrameBuilder {
+            public:
+                virtual ~FrameBuilder();
+                
+                size_t frameCount() const;
+                Frame* buildFrame(size_t frameIndex) const;
+            private:
+                virtual size_t doGetFrameCount() const = 0;
+                virtual Frame* doBuildFrame(size_t frameIndex) const = 0;
+            };
         private:
             String m_name;
             TextureCollection* m_skins;
-            FrameList m_frames;
+            FrameBuilder* m_frameBuilder;
+            mutable FrameList m_frames;
         public:
-            Md2Model(const String& name, const TextureList& skins, const FrameList& frames);
+            Md2Model(const String& name, const TextureList& skins, FrameBuilder* frameBuilder);
             ~Md2Model();
         private:
+            const Frame* frame(size_t frameIndex) const;
+            
             Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const;
             BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const;
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const;
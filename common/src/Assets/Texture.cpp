@@ -20,6 +20,7 @@
 #include "Texture.h"
 #include "Assets/ImageUtils.h"
 #include "Assets/TextureCollection.h"
+#include "Renderer/RenderProfiler.h"
 
 #include <cassert>
 
@@ -86,6 +87,10 @@ namespace TrenchBroom {
         }
         
         const String& Texture::name() const {
+            return m_name.name();
+        }
+        
+        const TextureName& Texture::internedName() const {
             return m_name;
         }
         
@@ -101,6 +106,18 @@ namespace TrenchBroom {
             return m_averageColor;
         }
         
+        size_t Texture::memoryUsage() const {
+            size_t result = sizeof(Texture);
+            if (isPrepared()) {
+                // textures are uploaded as RGBA, and the mip levels add about a third to the size of the base level
+                result += m_width * m_height * 4 * 4 / 3;
+            } else {
+                for (const TextureBuffer& buffer : m_buffers)
+                    result += buffer.size();
+            }
+            return result;
+        }
+        
         size_t Texture::usageCount() const {
             return m_usageCount;
         }
@@ -164,6 +181,7 @@ namespace TrenchBroom {
                                       static_cast<GLsizei>(mipWidth),
                                       static_cast<GLsizei>(mipHeight),
                                       0, m_format, GL_UNSIGNED_BYTE, data));
+                Renderer::RenderProfiler::countUpload(m_buffers[j].size());
                 mipWidth  /= 2;
                 mipHeight /= 2;
             }
@@ -182,6 +200,7 @@ namespace TrenchBroom {
         void Texture::activate() const {
             assert(isPrepared());
             glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+            Renderer::RenderProfiler::countTextureBind();
         }
         
         void Texture::deactivate() const {
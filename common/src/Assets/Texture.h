@@ -23,6 +23,7 @@
 #include "ByteBuffer.h"
 #include "Color.h"
 #include "StringUtils.h"
+#include "Assets/TextureName.h"
 #include "Renderer/GL.h"
 
 #include <cassert>
@@ -38,7 +39,7 @@ namespace TrenchBroom {
         class Texture {
         private:
             TextureCollection* m_collection;
-            String m_name;
+            TextureName m_name;
             
             size_t m_width;
             size_t m_height;
@@ -58,10 +59,17 @@ namespace TrenchBroom {
             ~Texture();
 
             const String& name() const;
+            const TextureName& internedName() const;
             
             size_t width() const;
             size_t height() const;
             const Color& averageColor() const;
+            
+            /**
+             Returns the approximate number of bytes used by this texture. Once a texture is prepared, its
+             pixel data is only held by OpenGL, so the size of the uploaded mip levels is estimated instead.
+             */
+            size_t memoryUsage() const;
 
             size_t usageCount() const;
             void incUsageCount();
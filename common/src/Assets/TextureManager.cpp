@@ -39,6 +39,13 @@ namespace TrenchBroom {
             }
         };
         
+        class CompareByKey {
+        public:
+            bool operator() (const Texture* left, const Texture* right) const {
+                return *left->internedName().key() < *right->internedName().key();
+            }
+        };
+        
         class CompareByUsage {
         public:
             bool operator() (const Texture* left, const Texture* right) const {
@@ -127,7 +134,18 @@ namespace TrenchBroom {
         }
         
         Texture* TextureManager::texture(const String& name) const {
-            TextureMap::const_iterator it = m_texturesByName.find(StringUtils::toLower(name));
+            const TextureName::Key key = TextureName::findKey(name);
+            if (key == NULL)
+                return NULL;
+            
+            TextureMap::const_iterator it = m_texturesByName.find(key);
+            if (it == std::end(m_texturesByName))
+                return NULL;
+            return it->second;
+        }
+        
+        Texture* TextureManager::texture(const TextureName& name) const {
+            TextureMap::const_iterator it = m_texturesByName.find(name.key());
             if (it == std::end(m_texturesByName))
                 return NULL;
             return it->second;
@@ -169,7 +187,7 @@ namespace TrenchBroom {
             
             for (TextureCollection* collection : m_collections) {
                 for (Texture* texture : collection->textures()) {
-                    const String key = StringUtils::toLower(texture->name());
+                    const TextureName::Key key = texture->internedName().key();
                     texture->setOverridden(false);
                     
                     TextureMap::iterator mIt = m_texturesByName.find(key);
@@ -182,7 +200,10 @@ namespace TrenchBroom {
                 }
             }
 
-            m_textures = MapUtils::valueList(m_texturesByName);
+            m_textures.reserve(m_texturesByName.size());
+            for (const auto& entry : m_texturesByName)
+                m_textures.push_back(entry.second);
+            std::sort(std::begin(m_textures), std::end(m_textures), CompareByKey());
         }
     }
 }
@@ -22,10 +22,12 @@
 
 #include "Notifier.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/TextureName.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -40,7 +42,7 @@ namespace TrenchBroom {
         private:
             typedef std::map<IO::Path, TextureCollection*> TextureCollectionMap;
             typedef std::pair<IO::Path, TextureCollection*> TextureCollectionMapEntry;
-            typedef std::map<String, Texture*> TextureMap;
+            typedef std::unordered_map<TextureName::Key, Texture*> TextureMap;
             
             Logger* m_logger;
             
@@ -72,6 +74,7 @@ namespace TrenchBroom {
             void commitChanges();
             
             Texture* texture(const String& name) const;
+            Texture* texture(const TextureName& name) const;
             const TextureList& textures() const;
             const TextureCollectionList& collections() const;
             const StringList collectionNames() const;
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextureName.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        // Maps each interned name to its key, which is again an interned name. References to the
+        // elements of an unordered map remain valid when it grows, so we can hand out pointers to them.
+        class TextureName::SymbolTable {
+        private:
+            typedef std::unordered_map<String, TextureName::Key> Map;
+            
+            mutable std::mutex m_mutex;
+            Map m_symbols;
+            size_t m_stringBytes;
+        public:
+            SymbolTable() :
+            m_stringBytes(0) {}
+            
+            std::pair<const String*, TextureName::Key> intern(const String& name) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                
+                const auto it = m_symbols.find(name);
+                if (it != std::end(m_symbols))
+                    return std::make_pair(&it->first, it->second);
+                
+                const TextureName::Key key = internKey(StringUtils::toLower(name));
+                if (*key == name)
+                    return std::make_pair(key, key);
+                
+                const String& symbol = m_symbols.insert(std::make_pair(name, key)).first->first;
+                m_stringBytes += symbol.size();
+                return std::make_pair(&symbol, key);
+            }
+            
+            TextureName::Key findKey(const String& name) const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                
+                auto it = m_symbols.find(name);
+                if (it == std::end(m_symbols))
+                    it = m_symbols.find(StringUtils::toLower(name));
+                if (it == std::end(m_symbols))
+                    return NULL;
+                return it->second;
+            }
+            
+            size_t size() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_symbols.size();
+            }
+            
+            size_t memoryUsage() const {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return (sizeof(SymbolTable) +
+                        m_symbols.bucket_count() * sizeof(void*) +
+                        m_symbols.size() * (sizeof(Map::value_type) + sizeof(void*)) +
+                        m_stringBytes);
+            }
+        private:
+            TextureName::Key internKey(const String& key) {
+                const auto it = m_symbols.find(key);
+                if (it != std::end(m_symbols))
+                    return it->second;
+                
+                auto& entry = *m_symbols.insert(std::make_pair(key, TextureName::Key(NULL))).first;
+                entry.second = &entry.first;
+                m_stringBytes += entry.first.size();
+                return entry.second;
+            }
+        };
+        
+        TextureName::SymbolTable& TextureName::symbolTable() {
+            static SymbolTable table;
+            return table;
+        }
+        
+        TextureName::TextureName() {
+            const auto symbol = symbolTable().intern("");
+            m_name = symbol.first;
+            m_key = symbol.second;
+        }
+        
+        TextureName::TextureName(const String& name) {
+            const auto symbol = symbolTable().intern(name);
+            m_name = symbol.first;
+            m_key = symbol.second;
+        }
+        
+        bool TextureName::operator==(const TextureName& other) const {
+            return m_name == other.m_name;
+        }
+        
+        bool TextureName::operator!=(const TextureName& other) const {
+            return !(*this == other);
+        }
+        
+        const String& TextureName::name() const {
+            return *m_name;
+        }
+        
+        TextureName::Key TextureName::key() const {
+            return m_key;
+        }
+        
+        TextureName::Key TextureName::findKey(const String& name) {
+            return symbolTable().findKey(name);
+        }
+        
+        size_t TextureName::symbolCount() {
+            return symbolTable().size();
+        }
+        
+        size_t TextureName::memoryUsage() {
+            return symbolTable().memoryUsage();
+        }
+    }
+}
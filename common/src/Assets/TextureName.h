@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_TextureName
+#define TrenchBroom_TextureName
+
+#include "StringUtils.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         An interned texture name. All texture names are stored once in a global symbol table, so copying
+         and comparing texture names is cheap and many faces with the same texture share a single string.
+         
+         Every name also refers to the interned lower case version of itself, its key. Two names that only
+         differ in case have the same key, which can be used to look up textures without regard to case.
+         Interned names are never released.
+         */
+        class TextureName {
+        public:
+            typedef const String* Key;
+        private:
+            class SymbolTable;
+            
+            const String* m_name;
+            Key m_key;
+        public:
+            TextureName();
+            explicit TextureName(const String& name);
+            
+            bool operator==(const TextureName& other) const;
+            bool operator!=(const TextureName& other) const;
+            
+            const String& name() const;
+            Key key() const;
+            
+            /**
+             Returns the key of the given name without interning it, or NULL if no name that is equal to
+             the given name without regard to case has been interned yet.
+             */
+            static Key findKey(const String& name);
+            
+            static size_t symbolCount();
+            static size_t memoryUsage();
+        private:
+            static SymbolTable& symbolTable();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureName) */
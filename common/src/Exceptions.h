@@ -127,4 +127,9 @@ public:
     using ExceptionStream::ExceptionStream;
 };
 
+class OperationCancelledException : public ExceptionStream<OperationCancelledException> {
+public:
+    using ExceptionStream::ExceptionStream;
+};
+
 #endif
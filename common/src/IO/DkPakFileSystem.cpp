@@ -20,11 +20,13 @@
 #include "DkPakFileSystem.h"
 
 #include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "IO/CharArrayReader.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/IOUtils.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
@@ -35,13 +37,59 @@ namespace TrenchBroom {
             static const String HeaderMagic       = "PACK";
         }
         
-        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize) :
+        DkPakFileSystem::DecompressedFileCache::DecompressedFileCache(const size_t budget) :
+        m_budget(budget),
+        m_size(0) {}
+        
+        MappedFile::Ptr DkPakFileSystem::DecompressedFileCache::find(const CompressedFile* file) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            EntryIndex::iterator it = m_index.find(file);
+            if (it == std::end(m_index))
+                return MappedFile::Ptr();
+            
+            // move the entry to the front so that it is evicted last
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            return it->second->second;
+        }
+        
+        void DkPakFileSystem::DecompressedFileCache::insert(const CompressedFile* file, MappedFile::Ptr decompressed) {
+            if (decompressed->size() > m_budget)
+                return;
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_index.count(file) > 0)
+                return;
+            
+            m_entries.push_front(Entry(file, decompressed));
+            m_index[file] = std::begin(m_entries);
+            m_size += decompressed->size();
+            evict();
+        }
+        
+        void DkPakFileSystem::DecompressedFileCache::evict() {
+            // evicted entries stay alive for as long as they are still open elsewhere
+            while (m_size > m_budget) {
+                const Entry& entry = m_entries.back();
+                m_size -= entry.second->size();
+                m_index.erase(entry.first);
+                m_entries.pop_back();
+            }
+        }
+        
+        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize, DecompressedFileCache& cache) :
         m_file(file),
-        m_uncompressedSize(uncompressedSize) {}
+        m_uncompressedSize(uncompressedSize),
+        m_cache(cache) {}
 
         MappedFile::Ptr DkPakFileSystem::CompressedFile::doOpen() {
-            const char* data = decompress();
-            return MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+            MappedFile::Ptr result = m_cache.find(this);
+            if (result == NULL) {
+                const char* data = decompress();
+                result = MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+                m_cache.insert(this, result);
+            }
+            return result;
         }
 
         char* DkPakFileSystem::CompressedFile::decompress() const {
@@ -49,49 +97,67 @@ namespace TrenchBroom {
             
             char* result = new char[m_uncompressedSize];
             char* curTarget = result;
+            char* const end = result + m_uncompressedSize;
             
-            unsigned char x;
-            while (!reader.eof() && (x = reader.readUnsignedChar<unsigned char>()) < 0xFF) {
-                if (x < 0x40) {
-                    // x+1 bytes of uncompressed data follow (just read+write them as they are)
-                    const size_t len = static_cast<size_t>(x) + 1;
-                    reader.read(curTarget, len);
-                    curTarget += len;
-                } else if (x < 0x80) {
-                    // run-length encoded zeros, write (x - 62) zero-bytes to output
-                    const size_t len = static_cast<size_t>(x) - 62;
-                    memset(curTarget, 0, len);
-                    curTarget += len;
-                } else if (x < 0xC0) {
-                    // run-length encoded data, read one byte, write it (x-126) times to output
-                    const size_t len = static_cast<size_t>(x) - 126;
-                    const int data = reader.readInt<unsigned char>();
-                    memset(curTarget, data, len);
-                    curTarget += len;
-                } else if (x < 0xFE) {
-                    // this references previously uncompressed data
-                    // read one byte to get _offset_
-                    // read (x-190) bytes from the already uncompressed and written output data,
-                    // starting at (offset+2) bytes before the current write position (and add them to output, of course)
-                    const size_t len = static_cast<size_t>(x) - 190;
-                    const size_t offset = reader.readSize<unsigned char>();
-                    char* from = curTarget - offset + 2;
+            try {
+                while (reader.canRead(1)) {
+                    const unsigned char x = reader.readUnsignedChar<unsigned char>();
+                    if (x == 0xFF)
+                        break;
                     
-                    assert(from >= result);
-                    assert(from <  curTarget - len);
-                    
-                    memcpy(from, curTarget, len);
-                    curTarget += len;
+                    if (x < 0x40) {
+                        // x+1 bytes of uncompressed data follow (just read+write them as they are)
+                        const size_t len = static_cast<size_t>(x) + 1;
+                        if (!reader.canRead(len) || static_cast<size_t>(end - curTarget) < len)
+                            throw FileSystemException("Corrupt compressed entry " + m_file->path().asString());
+                        reader.read(curTarget, len);
+                        curTarget += len;
+                    } else if (x < 0x80) {
+                        // run-length encoded zeros, write (x - 62) zero-bytes to output
+                        const size_t len = static_cast<size_t>(x) - 62;
+                        if (static_cast<size_t>(end - curTarget) < len)
+                            throw FileSystemException("Corrupt compressed entry " + m_file->path().asString());
+                        memset(curTarget, 0, len);
+                        curTarget += len;
+                    } else if (x < 0xC0) {
+                        // run-length encoded data, read one byte, write it (x-126) times to output
+                        const size_t len = static_cast<size_t>(x) - 126;
+                        if (!reader.canRead(1) || static_cast<size_t>(end - curTarget) < len)
+                            throw FileSystemException("Corrupt compressed entry " + m_file->path().asString());
+                        const int data = reader.readInt<unsigned char>();
+                        memset(curTarget, data, len);
+                        curTarget += len;
+                    } else if (x < 0xFE) {
+                        // this references previously uncompressed data
+                        // read one byte to get _offset_
+                        // read (x-190) bytes from the already uncompressed and written output data,
+                        // starting at (offset+2) bytes before the current write position (and add them to output, of course)
+                        const size_t len = static_cast<size_t>(x) - 190;
+                        if (!reader.canRead(1))
+                            throw FileSystemException("Corrupt compressed entry " + m_file->path().asString());
+                        const size_t offset = reader.readSize<unsigned char>() + 2;
+                        if (static_cast<size_t>(curTarget - result) < offset || static_cast<size_t>(end - curTarget) < len)
+                            throw FileSystemException("Corrupt compressed entry " + m_file->path().asString());
+                        
+                        // the source range may overlap the target range, so copy byte by byte
+                        const char* from = curTarget - offset;
+                        for (size_t i = 0; i < len; ++i)
+                            curTarget[i] = from[i];
+                        curTarget += len;
+                    }
                 }
-
-                x = reader.readUnsignedChar<unsigned char>();
+            } catch (...) {
+                delete [] result;
+                throw;
             }
             
+            std::memset(curTarget, 0, static_cast<size_t>(end - curTarget));
             return result;
         }
         
         DkPakFileSystem::DkPakFileSystem(const Path& path, MappedFile::Ptr file) :
-        ImageFileSystem(path, file) {
+        ImageFileSystem(path, file),
+        m_cache(DecompressedCacheBudget) {
             initialize();
         }
         
@@ -118,9 +184,9 @@ namespace TrenchBroom {
                 MappedFile::Ptr entryFile(new MappedFileView(m_file, filePath, entryBegin, entryEnd));
                 
                 if (compressed)
-                    m_root.addFile(filePath, new SimpleFile(entryFile));
+                    addFile(filePath, new CompressedFile(entryFile, uncompressedSize, m_cache));
                 else
-                    m_root.addFile(filePath, new CompressedFile(entryFile, uncompressedSize));
+                    addFile(filePath, new SimpleFile(entryFile));
             }
         }
     }
@@ -24,22 +24,56 @@
 #include "IO/ImageFileSystem.h"
 #include "IO/Path.h"
 
+#include <list>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace IO {
         class DkPakFileSystem : public ImageFileSystem {
         private:
+            static const size_t DecompressedCacheBudget = 32 * 1024 * 1024;
+            
+            class CompressedFile;
+            
+            /**
+             Keeps the most recently opened decompressed entries alive so that opening an entry
+             again does not inflate it again. The cache is used by the loader threads, too.
+             */
+            class DecompressedFileCache {
+            private:
+                typedef std::pair<const CompressedFile*, MappedFile::Ptr> Entry;
+                typedef std::list<Entry> EntryList;
+                typedef std::unordered_map<const CompressedFile*, EntryList::iterator> EntryIndex;
+                
+                const size_t m_budget;
+                size_t m_size;
+                EntryList m_entries;
+                EntryIndex m_index;
+                std::mutex m_mutex;
+            public:
+                DecompressedFileCache(size_t budget);
+                
+                MappedFile::Ptr find(const CompressedFile* file);
+                void insert(const CompressedFile* file, MappedFile::Ptr decompressed);
+            private:
+                void evict();
+            };
+            
             class CompressedFile : public File {
             private:
                 MappedFile::Ptr m_file;
                 const size_t m_uncompressedSize;
+                DecompressedFileCache& m_cache;
             public:
-                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize);
+                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize, DecompressedFileCache& cache);
             private:
                 MappedFile::Ptr doOpen();
                 char* decompress() const;
             };
+            
+            DecompressedFileCache m_cache;
         public:
             DkPakFileSystem(const Path& path, MappedFile::Ptr file);
         private:
@@ -37,6 +37,10 @@ namespace TrenchBroom {
             return doMakeAbsolute(relPath);
         }
 
+        bool FileSystem::hasStaticContents() const {
+            return doHasStaticContents();
+        }
+
         bool FileSystem::directoryExists(const Path& path) const {
             try {
                 if (path.isAbsolute())
@@ -89,6 +93,10 @@ namespace TrenchBroom {
             }
         }
 
+        bool FileSystem::doHasStaticContents() const {
+            return false;
+        }
+
         WritableFileSystem::WritableFileSystem() {}
 
         /*
@@ -42,6 +42,7 @@ namespace TrenchBroom {
             FileSystem& operator=(const FileSystem& other);
 
             Path makeAbsolute(const Path& relPath) const;
+            bool hasStaticContents() const;
             
             bool directoryExists(const Path& path) const;
             bool fileExists(const Path& path) const;
@@ -76,6 +77,8 @@ namespace TrenchBroom {
                 }
             }
 
+            // file systems whose contents never change after construction can be indexed by their users
+            virtual bool doHasStaticContents() const;
             virtual Path doMakeAbsolute(const Path& relPath) const = 0;
             virtual bool doDirectoryExists(const Path& path) const = 0;
             virtual bool doFileExists(const Path& path) const = 0;
@@ -36,10 +36,13 @@ namespace TrenchBroom {
         void FileSystemHierarchy::addFileSystem(FileSystem* fileSystem) {
             ensure(fileSystem != NULL, "fileSystem is null");
             m_fileSystems.push_back(fileSystem);
+            if (fileSystem->hasStaticContents())
+                indexFileSystem(m_fileSystems.size() - 1);
         }
 
         void FileSystemHierarchy::clear() {
             VectorUtils::clearAndDelete(m_fileSystems);
+            m_fileIndex.clear();
         }
 
         Path FileSystemHierarchy::doMakeAbsolute(const Path& relPath) const {
@@ -63,13 +66,32 @@ namespace TrenchBroom {
         }
         
         FileSystem* FileSystemHierarchy::findFileSystemContaining(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path))
+            // Only file systems whose contents can change and which take precedence over the indexed candidate have to
+            // be asked; all others are either shadowed by the candidate or are known not to contain the file.
+            const FileIndex::const_iterator indexIt = m_fileIndex.find(indexKey(path));
+            const size_t candidate = indexIt != std::end(m_fileIndex) ? indexIt->second : m_fileSystems.size();
+            
+            for (size_t i = m_fileSystems.size(); i > 0; --i) {
+                const size_t position = i - 1;
+                if (position == candidate)
+                    return m_fileSystems[position];
+                
+                FileSystem* fileSystem = m_fileSystems[position];
+                if (!fileSystem->hasStaticContents() && fileSystem->fileExists(path))
                     return fileSystem;
             }
             return NULL;
         }
+        
+        void FileSystemHierarchy::indexFileSystem(const size_t position) {
+            const FileSystem* fileSystem = m_fileSystems[position];
+            for (const Path& path : fileSystem->findItemsRecursively(Path(""), FileTypeMatcher(true, false)))
+                m_fileIndex[indexKey(path)] = position;
+        }
+        
+        String FileSystemHierarchy::indexKey(const Path& path) {
+            return StringUtils::toLower(path.asString('/'));
+        }
 
         Path::List FileSystemHierarchy::doGetDirectoryContents(const Path& path) const {
             Path::List result;
@@ -86,15 +108,10 @@ namespace TrenchBroom {
         }
         
         const MappedFile::Ptr FileSystemHierarchy::doOpenFile(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                const FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path)) {
-                    const MappedFile::Ptr file = fileSystem->openFile(path);
-                    if (file.get() != NULL)
-                        return file;
-                }
-            }
-            return MappedFile::Ptr();
+            const FileSystem* fileSystem = findFileSystemContaining(path);
+            if (fileSystem == NULL)
+                return MappedFile::Ptr();
+            return fileSystem->openFile(path);
         }
 
         WritableFileSystemHierarchy::WritableFileSystemHierarchy() :
@@ -26,6 +26,7 @@
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -36,6 +37,11 @@ namespace TrenchBroom {
         private:
             typedef std::vector<FileSystem*> FileSystemList;
             FileSystemList m_fileSystems;
+            
+            // maps the lower case path of every file in a file system with static contents to the position of the
+            // topmost such file system that contains it
+            typedef std::unordered_map<String, size_t> FileIndex;
+            FileIndex m_fileIndex;
         public:
             FileSystemHierarchy();
             virtual ~FileSystemHierarchy();
@@ -47,6 +53,8 @@ namespace TrenchBroom {
             bool doDirectoryExists(const Path& path) const;
             bool doFileExists(const Path& path) const;
             FileSystem* findFileSystemContaining(const Path& path) const;
+            void indexFileSystem(size_t position);
+            static String indexKey(const Path& path);
             
             Path::List doGetDirectoryContents(const Path& path) const;
             const MappedFile::Ptr doOpenFile(const Path& path) const;
@@ -23,9 +23,12 @@
 
 namespace TrenchBroom {
     namespace IO {
-        OpenFile::OpenFile(const Path& path, const bool write) :
+        OpenFile::OpenFile(const Path& path, const bool write, const bool binary) :
         file(NULL) {
-            file = fopen(path.asString().c_str(), write ? "w" : "r");
+            if (binary)
+                file = fopen(path.asString().c_str(), write ? "wb" : "rb");
+            else
+                file = fopen(path.asString().c_str(), write ? "w" : "r");
             if (file == NULL)
                 throw FileSystemException("Cannot open file: " + path.asString());
         }
@@ -48,7 +48,7 @@ namespace TrenchBroom {
         public:
             FILE* file;
         public:
-            OpenFile(const Path& path, bool write);
+            OpenFile(const Path& path, bool write, bool binary = false);
             ~OpenFile();
             
             deleteCopyAndAssignment(OpenFile)
@@ -48,10 +48,6 @@ namespace TrenchBroom {
             MapUtils::clearAndDelete(m_files);
         }
         
-        void ImageFileSystem::Directory::addFile(const Path& path, MappedFile::Ptr file) {
-            addFile(path, new SimpleFile(file));
-        }
-
         void ImageFileSystem::Directory::addFile(const Path& path, File* file) {
             ensure(file != NULL, "file is null");
             const Path filename = path.lastComponent();
@@ -64,49 +60,15 @@ namespace TrenchBroom {
             }
         }
         
-        bool ImageFileSystem::Directory::directoryExists(const Path& path) const {
-            if (path.isEmpty())
-                return true;
-            DirMap::const_iterator it = m_directories.find(path.firstComponent());
-            if (it == std::end(m_directories))
-                return false;
-            return it->second->directoryExists(path.deleteFirstComponent());
-        }
-        
-        bool ImageFileSystem::Directory::fileExists(const Path& path) const {
-            if (path.length() == 1)
-                return m_files.count(path) > 0;
-            DirMap::const_iterator it = m_directories.find(path.firstComponent());
-            if (it == std::end(m_directories))
-                return false;
-            return it->second->fileExists(path.deleteFirstComponent());
-        }
-        
         const ImageFileSystem::Directory& ImageFileSystem::Directory::findDirectory(const Path& path) const {
             if (path.isEmpty())
                 return *this;
             DirMap::const_iterator it = m_directories.find(path.firstComponent());
             if (it == std::end(m_directories))
-                throw new FileSystemException("Path does not exist: '" + (m_path + path).asString() + "'");
+                throw FileSystemException("Path does not exist: '" + (m_path + path).asString() + "'");
             return it->second->findDirectory(path.deleteFirstComponent());
         }
         
-        const MappedFile::Ptr ImageFileSystem::Directory::findFile(const Path& path) const {
-            assert(!path.isEmpty());
-            
-            const Path name = path.firstComponent();
-            if (path.length() == 1) {
-                FileMap::const_iterator it = m_files.find(name);
-                if (it == std::end(m_files))
-                    throw new FileSystemException("File not found: '" + (m_path + path).asString() + "'");
-                return it->second->open();
-            }
-            DirMap::const_iterator it = m_directories.find(name);
-            if (it == std::end(m_directories))
-                throw new FileSystemException("File not found: '" + (m_path + path).asString() + "'");
-            return it->second->findFile(path.deleteFirstComponent());
-        }
-        
         Path::List ImageFileSystem::Directory::contents() const {
             Path::List contents;
             
@@ -141,18 +103,40 @@ namespace TrenchBroom {
             doReadDirectory();
         }
         
+        void ImageFileSystem::addFile(const Path& path, MappedFile::Ptr file) {
+            addFile(path, new SimpleFile(file));
+        }
+        
+        void ImageFileSystem::addFile(const Path& path, File* file) {
+            // the directory tree takes ownership and deletes any file it replaces, so the index must be updated afterwards
+            m_root.addFile(path, file);
+            m_fileIndex[indexKey(path)] = file;
+            
+            Path directory = path.deleteLastComponent();
+            while (!directory.isEmpty() && m_directoryIndex.insert(indexKey(directory)).second)
+                directory = directory.deleteLastComponent();
+        }
+
+        String ImageFileSystem::indexKey(const Path& path) {
+            return StringUtils::toLower(path.asString('/'));
+        }
+        
+        bool ImageFileSystem::doHasStaticContents() const {
+            return true;
+        }
+        
         Path ImageFileSystem::doMakeAbsolute(const Path& relPath) const {
             return m_path + relPath.makeCanonical();
         }
         
         bool ImageFileSystem::doDirectoryExists(const Path& path) const {
-            const Path searchPath = path.makeLowerCase();
-            return m_root.directoryExists(searchPath);
+            if (path.isEmpty())
+                return true;
+            return m_directoryIndex.count(indexKey(path)) > 0;
         }
         
         bool ImageFileSystem::doFileExists(const Path& path) const {
-            const Path searchPath = path.makeLowerCase();
-            return m_root.fileExists(searchPath);
+            return m_fileIndex.count(indexKey(path)) > 0;
         }
         
         Path::List ImageFileSystem::doGetDirectoryContents(const Path& path) const {
@@ -162,8 +146,10 @@ namespace TrenchBroom {
         }
         
         const MappedFile::Ptr ImageFileSystem::doOpenFile(const Path& path) const {
-            const Path searchPath = path.makeLowerCase();
-            return m_root.findFile(path);
+            const FileIndex::const_iterator it = m_fileIndex.find(indexKey(path));
+            if (it == std::end(m_fileIndex))
+                throw FileSystemException("File not found: '" + path.asString() + "'");
+            return it->second->open();
         }
     }
 }
@@ -25,6 +25,8 @@
 #include "IO/Path.h"
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace IO {
@@ -60,29 +62,36 @@ namespace TrenchBroom {
                 Directory(const Path& path);
                 ~Directory();
                 
-                void addFile(const Path& path, MappedFile::Ptr file);
                 void addFile(const Path& path, File* file);
                 
-                bool directoryExists(const Path& path) const;
-                bool fileExists(const Path& path) const;
-                
                 const Directory& findDirectory(const Path& path) const;
-                const MappedFile::Ptr findFile(const Path& path) const;
                 Path::List contents() const;
             private:
                 Directory& findOrCreateDirectory(const Path& path);
             };
+        private:
+            // flat indices over all entries, keyed by the lower case path, to avoid walking the directory tree
+            typedef std::unordered_map<String, File*> FileIndex;
+            typedef std::unordered_set<String> DirectoryIndex;
         protected:
             Path m_path;
             MappedFile::Ptr m_file;
+        private:
             Directory m_root;
+            FileIndex m_fileIndex;
+            DirectoryIndex m_directoryIndex;
         protected:
             ImageFileSystem(const Path& path, MappedFile::Ptr file);
         public:
             virtual ~ImageFileSystem();
         protected:
             void initialize();
+            void addFile(const Path& path, MappedFile::Ptr file);
+            void addFile(const Path& path, File* file);
         private:
+            static String indexKey(const Path& path);
+            
+            bool doHasStaticContents() const;
             Path doMakeAbsolute(const Path& relPath) const;
             bool doDirectoryExists(const Path& path) const;
             bool doFileExists(const Path& path) const;
@@ -0,0 +1,466 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Exceptions.h"
+#include "IO/ParserStatus.h"
+#include "IO/Path.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace IO {
+        const char MapCache::Magic[] = "TBMC";
+        
+        class MapCache::Writer : public Model::ConstNodeVisitor {
+        private:
+            static const size_t BufferSize = 64 * 1024;
+            
+            FILE* m_stream;
+            std::vector<char> m_buffer;
+        public:
+            Writer(FILE* stream) :
+            m_stream(stream) {
+                m_buffer.reserve(BufferSize);
+            }
+            
+            template <typename T>
+            void write(const T value) {
+                const char* bytes = reinterpret_cast<const char*>(&value);
+                m_buffer.insert(std::end(m_buffer), bytes, bytes + sizeof(T));
+                if (m_buffer.size() >= BufferSize)
+                    flush();
+            }
+            
+            void write(const String& str) {
+                write<uint32_t>(static_cast<uint32_t>(str.size()));
+                m_buffer.insert(std::end(m_buffer), std::begin(str), std::end(str));
+                if (m_buffer.size() >= BufferSize)
+                    flush();
+            }
+            
+            void write(const Vec3& vec) {
+                for (size_t i = 0; i < 3; ++i)
+                    write<FloatType>(vec[i]);
+            }
+            
+            void write(const BBox3& bounds) {
+                write(bounds.min);
+                write(bounds.max);
+            }
+            
+            // Writes the buffered data to the stream. Must be called explicitly because it may throw.
+            void flush() {
+                if (!m_buffer.empty()) {
+                    if (std::fwrite(&m_buffer.front(), 1, m_buffer.size(), m_stream) != m_buffer.size())
+                        throw FileSystemException("Cannot write map cache");
+                    m_buffer.clear();
+                }
+            }
+        private:
+            
+            void doVisit(const Model::World* world) {
+                writeNode(NT_World, world);
+                writeAttributes(world);
+                writeChildren(world);
+            }
+            
+            void doVisit(const Model::Layer* layer) {
+                writeNode(NT_Layer, layer);
+                write(layer->name());
+                writeChildren(layer);
+            }
+            
+            void doVisit(const Model::Group* group) {
+                writeNode(NT_Group, group);
+                write(group->name());
+                writeChildren(group);
+            }
+            
+            void doVisit(const Model::Entity* entity) {
+                writeNode(NT_Entity, entity);
+                writeAttributes(entity);
+                writeChildren(entity);
+            }
+            
+            void doVisit(const Model::Brush* brush) {
+                writeNode(NT_Brush, brush);
+                
+                const Model::BrushFaceList& faces = brush->faces();
+                write<uint32_t>(static_cast<uint32_t>(faces.size()));
+                for (const Model::BrushFace* face : faces)
+                    writeFace(face);
+                
+                writeGeometry(brush);
+            }
+            
+            void writeNode(const NodeType type, const Model::Node* node) {
+                write<uint8_t>(static_cast<uint8_t>(type));
+                write<uint64_t>(static_cast<uint64_t>(node->lineNumber()));
+                write<uint64_t>(static_cast<uint64_t>(node->lineCount()));
+            }
+            
+            void writeAttributes(const Model::AttributableNode* node) {
+                const Model::EntityAttribute::List& attributes = node->attributes();
+                write<uint32_t>(static_cast<uint32_t>(attributes.size()));
+                for (const Model::EntityAttribute& attribute : attributes) {
+                    write(attribute.name());
+                    write(attribute.value());
+                }
+            }
+            
+            void writeChildren(const Model::Node* node) {
+                const Model::NodeList& children = node->children();
+                write<uint32_t>(static_cast<uint32_t>(children.size()));
+                Model::Node::accept(std::begin(children), std::end(children), *this);
+            }
+            
+            void writeFace(const Model::BrushFace* face) {
+                const Model::BrushFace::Points& points = face->points();
+                for (size_t i = 0; i < 3; ++i)
+                    write(points[i]);
+                
+                const Model::BrushFaceAttributes& attribs = face->attribs();
+                write(attribs.textureName());
+                write<float>(attribs.xOffset());
+                write<float>(attribs.yOffset());
+                write<float>(attribs.xScale());
+                write<float>(attribs.yScale());
+                write<float>(attribs.rotation());
+                write<int32_t>(static_cast<int32_t>(attribs.surfaceContents()));
+                write<int32_t>(static_cast<int32_t>(attribs.surfaceFlags()));
+                write<float>(attribs.surfaceValue());
+                
+                write(face->textureXAxis());
+                write(face->textureYAxis());
+            }
+            
+            void writeGeometry(const Model::Brush* brush) {
+                typedef std::unordered_map<const Model::BrushVertex*, uint32_t> VertexIndex;
+                VertexIndex indices;
+                
+                const Model::Brush::VertexList vertices = brush->vertices();
+                write<uint32_t>(static_cast<uint32_t>(vertices.size()));
+                for (const Model::BrushVertex* vertex : vertices) {
+                    indices.insert(std::make_pair(vertex, static_cast<uint32_t>(indices.size())));
+                    write(vertex->position());
+                }
+                
+                for (const Model::BrushFace* face : brush->faces()) {
+                    const Model::BrushHalfEdgeList& boundary = face->geometry()->boundary();
+                    write<uint32_t>(static_cast<uint32_t>(boundary.size()));
+                    for (const Model::BrushHalfEdge* halfEdge : boundary)
+                        write<uint32_t>(indices[halfEdge->origin()]);
+                }
+            }
+        };
+        
+        class MapCache::Reader {
+        private:
+            const char* const m_begin;
+            const char* m_cur;
+            const char* const m_end;
+            const BBox3& m_worldBounds;
+            ParserStatus& m_status;
+            Model::World* m_world;
+        public:
+            Reader(const char* begin, const char* end, const BBox3& worldBounds, ParserStatus& status) :
+            m_begin(begin),
+            m_cur(begin),
+            m_end(end),
+            m_worldBounds(worldBounds),
+            m_status(status),
+            m_world(NULL) {}
+            
+            template <typename T>
+            T read() {
+                if (static_cast<size_t>(m_end - m_cur) < sizeof(T))
+                    throw FileFormatException("Map cache is truncated");
+                T value;
+                std::memcpy(&value, m_cur, sizeof(T));
+                m_cur += sizeof(T);
+                return value;
+            }
+            
+            String readString() {
+                const size_t size = read<uint32_t>();
+                if (static_cast<size_t>(m_end - m_cur) < size)
+                    throw FileFormatException("Map cache is truncated");
+                const String result(m_cur, size);
+                m_cur += size;
+                return result;
+            }
+            
+            Vec3 readVec3() {
+                Vec3 result;
+                for (size_t i = 0; i < 3; ++i)
+                    result[i] = read<FloatType>();
+                return result;
+            }
+            
+            BBox3 readBBox3() {
+                const Vec3 min = readVec3();
+                const Vec3 max = readVec3();
+                return BBox3(min, max);
+            }
+            
+            bool eof() const {
+                return m_cur == m_end;
+            }
+            
+            Model::World* readWorld(const Model::MapFormat::Type format, const Model::BrushContentTypeBuilder* brushContentTypeBuilder) {
+                if (read<uint8_t>() != NT_World)
+                    throw FileFormatException("Map cache does not start with a world");
+                
+                m_world = new Model::World(format, brushContentTypeBuilder, m_worldBounds);
+                try {
+                    readFilePosition(m_world);
+                    m_world->setAttributes(readAttributes());
+                    
+                    const size_t layerCount = read<uint32_t>();
+                    for (size_t i = 0; i < layerCount; ++i)
+                        readLayer(i == 0);
+                    return m_world;
+                } catch (...) {
+                    delete m_world;
+                    m_world = NULL;
+                    throw;
+                }
+            }
+        private:
+            void readLayer(const bool defaultLayer) {
+                if (read<uint8_t>() != NT_Layer)
+                    throw FileFormatException("Expected a layer in map cache");
+                
+                const size_t lineNumber = read<uint64_t>();
+                const size_t lineCount = read<uint64_t>();
+                const String name = readString();
+                
+                Model::Layer* layer = defaultLayer ? m_world->defaultLayer() : m_world->createLayer(name, m_worldBounds);
+                layer->setFilePosition(lineNumber, lineCount);
+                if (!defaultLayer)
+                    m_world->addChild(layer);
+                readChildren(layer);
+            }
+            
+            void readChildren(Model::Node* parent) {
+                const size_t childCount = read<uint32_t>();
+                for (size_t i = 0; i < childCount; ++i) {
+                    parent->addChild(readNode());
+                    m_status.progress(static_cast<double>(m_cur - m_begin) / static_cast<double>(m_end - m_begin));
+                }
+            }
+            
+            Model::Node* readNode() {
+                const uint8_t type = read<uint8_t>();
+                switch (type) {
+                    case NT_Group:
+                        return readGroup();
+                    case NT_Entity:
+                        return readEntity();
+                    case NT_Brush:
+                        return readBrush();
+                    default:
+                        throw FileFormatException("Unexpected node type in map cache");
+                }
+            }
+            
+            Model::Node* readGroup() {
+                const size_t lineNumber = read<uint64_t>();
+                const size_t lineCount = read<uint64_t>();
+                
+                Model::Group* group = m_world->createGroup(readString());
+                group->setFilePosition(lineNumber, lineCount);
+                try {
+                    readChildren(group);
+                } catch (...) {
+                    delete group;
+                    throw;
+                }
+                return group;
+            }
+            
+            Model::Node* readEntity() {
+                Model::Entity* entity = m_world->createEntity();
+                try {
+                    readFilePosition(entity);
+                    entity->setAttributes(readAttributes());
+                    readChildren(entity);
+                } catch (...) {
+                    delete entity;
+                    throw;
+                }
+                return entity;
+            }
+            
+            Model::Node* readBrush() {
+                const size_t lineNumber = read<uint64_t>();
+                const size_t lineCount = read<uint64_t>();
+                
+                Model::BrushFaceList faces;
+                try {
+                    const size_t faceCount = read<uint32_t>();
+                    faces.reserve(faceCount);
+                    for (size_t i = 0; i < faceCount; ++i)
+                        faces.push_back(readFace());
+                    
+                    const size_t vertexCount = read<uint32_t>();
+                    Vec3::List positions;
+                    positions.reserve(vertexCount);
+                    for (size_t i = 0; i < vertexCount; ++i)
+                        positions.push_back(readVec3());
+                    
+                    std::vector<size_t> faceSizes;
+                    std::vector<size_t> faceIndices;
+                    faceSizes.reserve(faceCount);
+                    for (size_t i = 0; i < faceCount; ++i) {
+                        const size_t faceSize = read<uint32_t>();
+                        faceSizes.push_back(faceSize);
+                        for (size_t j = 0; j < faceSize; ++j)
+                            faceIndices.push_back(read<uint32_t>());
+                    }
+                    
+                    // the brush takes ownership of the faces, and it deletes them if its geometry cannot be restored
+                    Model::BrushFaceList brushFaces;
+                    brushFaces.swap(faces);
+                    Model::Brush* brush = m_world->createBrush(m_worldBounds, brushFaces, positions, faceSizes, faceIndices);
+                    brush->setFilePosition(lineNumber, lineCount);
+                    return brush;
+                } catch (...) {
+                    VectorUtils::clearAndDelete(faces);
+                    throw;
+                }
+            }
+            
+            Model::BrushFace* readFace() {
+                const Vec3 p1 = readVec3();
+                const Vec3 p2 = readVec3();
+                const Vec3 p3 = readVec3();
+                
+                Model::BrushFaceAttributes attribs(readString());
+                attribs.setXOffset(read<float>());
+                attribs.setYOffset(read<float>());
+                attribs.setXScale(read<float>());
+                attribs.setYScale(read<float>());
+                attribs.setRotation(read<float>());
+                attribs.setSurfaceContents(static_cast<int>(read<int32_t>()));
+                attribs.setSurfaceFlags(static_cast<int>(read<int32_t>()));
+                attribs.setSurfaceValue(read<float>());
+                
+                const Vec3 texAxisX = readVec3();
+                const Vec3 texAxisY = readVec3();
+                return m_world->createFace(p1, p2, p3, attribs, texAxisX, texAxisY);
+            }
+            
+            void readFilePosition(Model::Node* node) {
+                const size_t lineNumber = read<uint64_t>();
+                const size_t lineCount = read<uint64_t>();
+                node->setFilePosition(lineNumber, lineCount);
+            }
+            
+            Model::EntityAttribute::List readAttributes() {
+                const size_t count = read<uint32_t>();
+                Model::EntityAttribute::List result;
+                for (size_t i = 0; i < count; ++i) {
+                    const String name = readString();
+                    const String value = readString();
+                    result.push_back(Model::EntityAttribute(name, value));
+                }
+                return result;
+            }
+        };
+        
+        MapCache::MapCache(const char* mapBegin, const char* mapEnd) :
+        m_mapSize(static_cast<uint64_t>(mapEnd - mapBegin)),
+        m_mapHash(hash(mapBegin, mapEnd)) {}
+        
+        Path MapCache::cachePath(const Path& cacheDirectory, const Path& mapPath) {
+            const String mapPathStr = mapPath.asString();
+            
+            StringStream name;
+            name << mapPath.lastComponent().deleteExtension().asString() << "-" << std::hex << hash(mapPathStr.data(), mapPathStr.data() + mapPathStr.size());
+            return cacheDirectory + Path(name.str()).addExtension("tbcache");
+        }
+        
+        Model::World* MapCache::read(const char* begin, const char* end, const Model::MapFormat::Type format, const BBox3& worldBounds, const Model::BrushContentTypeBuilder* brushContentTypeBuilder, ParserStatus& status) const {
+            try {
+                Reader reader(begin, end, worldBounds, status);
+                
+                for (size_t i = 0; i < 4; ++i) {
+                    if (reader.read<char>() != Magic[i])
+                        return NULL;
+                }
+                if (reader.read<uint32_t>() != Version ||
+                    reader.read<uint64_t>() != m_mapSize ||
+                    reader.read<uint64_t>() != m_mapHash ||
+                    reader.read<uint32_t>() != static_cast<uint32_t>(format) ||
+                    reader.readBBox3() != worldBounds)
+                    return NULL;
+                
+                Model::World* world = reader.readWorld(format, brushContentTypeBuilder);
+                if (!reader.eof()) {
+                    delete world;
+                    return NULL;
+                }
+                return world;
+            } catch (const OperationCancelledException&) {
+                throw;
+            } catch (const Exception&) {
+                return NULL;
+            }
+        }
+        
+        void MapCache::write(const Model::World* world, const BBox3& worldBounds, FILE* stream) const {
+            Writer writer(stream);
+            for (size_t i = 0; i < 4; ++i)
+                writer.write<char>(Magic[i]);
+            writer.write<uint32_t>(Version);
+            writer.write<uint64_t>(m_mapSize);
+            writer.write<uint64_t>(m_mapHash);
+            writer.write<uint32_t>(static_cast<uint32_t>(world->format()));
+            writer.write(worldBounds);
+            world->accept(writer);
+            
+            writer.flush();
+            if (std::fflush(stream) != 0)
+                throw FileSystemException("Cannot write map cache");
+        }
+        
+        uint64_t MapCache::hash(const char* begin, const char* end) {
+            // 64 bit FNV-1a
+            uint64_t result = 14695981039346656037ULL;
+            for (const char* cur = begin; cur != end; ++cur) {
+                result ^= static_cast<unsigned char>(*cur);
+                result *= 1099511628211ULL;
+            }
+            return result;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapCache
+#define TrenchBroom_MapCache
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+#include "StringUtils.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelTypes.h"
+
+#include <cstdio>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <cstdint>
+#elif defined __GNUC__
+#include <stdint.h>
+#endif
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushContentTypeBuilder;
+    }
+    
+    namespace IO {
+        class ParserStatus;
+        class Path;
+        
+        /**
+         A binary sidecar for a map file that stores the node tree together with the precomputed brush
+         geometry. Restoring a world from the cache skips both parsing the map and intersecting the face
+         planes of every brush. The cache is keyed by the size and a hash of the map file's contents, so a
+         cache that was written for a different version of the map is never used.
+         */
+        class MapCache {
+        private:
+            static const char Magic[];
+            static const uint32_t Version = 1;
+            
+            typedef enum {
+                NT_World  = 0,
+                NT_Layer  = 1,
+                NT_Group  = 2,
+                NT_Entity = 3,
+                NT_Brush  = 4
+            } NodeType;
+            
+            class Reader;
+            class Writer;
+            
+            uint64_t m_mapSize;
+            uint64_t m_mapHash;
+        public:
+            MapCache(const char* mapBegin, const char* mapEnd);
+            
+            /**
+             Returns the path of the cache file for the given map in the given cache directory. The name of the
+             cache file includes a hash of the map path, so maps with the same name in different directories do
+             not share a cache file.
+             */
+            static Path cachePath(const Path& cacheDirectory, const Path& mapPath);
+            
+            /**
+             Restores the world from the given cache contents. Returns NULL if the cache belongs to a different
+             map, format or world bounds, or if it cannot be read. Progress is reported to the given status, which
+             may cancel restoring the world by throwing an OperationCancelledException.
+             */
+            Model::World* read(const char* begin, const char* end, Model::MapFormat::Type format, const BBox3& worldBounds, const Model::BrushContentTypeBuilder* brushContentTypeBuilder, ParserStatus& status) const;
+            void write(const Model::World* world, const BBox3& worldBounds, FILE* stream) const;
+        private:
+            static uint64_t hash(const char* begin, const char* end);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapCache) */
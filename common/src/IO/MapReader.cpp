@@ -69,6 +69,10 @@ namespace TrenchBroom {
         
         MapReader::~MapReader() {
             VectorUtils::clearAndDelete(m_faces);
+            
+            // only non-empty if parsing was aborted before the nodes could be resolved
+            for (const auto& entry : m_unresolvedNodes)
+                delete entry.first;
         }
 
         void MapReader::readEntities(Model::MapFormat::Type format, const BBox3& worldBounds, ParserStatus& status) {
@@ -308,6 +312,7 @@ namespace TrenchBroom {
                 else
                     onNode(parent, node, status);
             }
+            m_unresolvedNodes.clear();
         }
 
         Model::Node* MapReader::resolveParent(const ParentInfo& parentInfo) const {
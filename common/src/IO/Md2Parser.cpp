@@ -221,6 +221,24 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
+        class Md2Parser::FrameBuilder : public Assets::Md2Model::FrameBuilder {
+        private:
+            Md2FrameList m_frames;
+            Md2MeshList m_meshes;
+        public:
+            FrameBuilder(const Md2FrameList& frames, const Md2MeshList& meshes) :
+            m_frames(frames),
+            m_meshes(meshes) {}
+        private:
+            size_t doGetFrameCount() const {
+                return m_frames.size();
+            }
+            
+            Assets::Md2Model::Frame* doBuildFrame(const size_t frameIndex) const {
+                return Md2Parser::buildFrame(m_frames[frameIndex], m_meshes);
+            }
+        };
+        
         Md2Parser::Md2Parser(const String& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
         m_name(name),
         m_begin(begin),
@@ -305,8 +323,7 @@ namespace TrenchBroom {
 
         Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes) {
             const Assets::TextureList modelTextures = loadTextures(skins);
-            const Assets::Md2Model::FrameList modelFrames = buildFrames(frames, meshes);
-            return new Assets::Md2Model(m_name, modelTextures, modelFrames);
+            return new Assets::Md2Model(m_name, modelTextures, new FrameBuilder(frames, meshes));
         }
 
         Assets::TextureList Md2Parser::loadTextures(const Md2SkinList& skins) {
@@ -337,15 +354,6 @@ namespace TrenchBroom {
             return new Assets::Texture(skin.name, image.width(), image.height(), avgColor, rgbImage);
         }
 
-        Assets::Md2Model::FrameList Md2Parser::buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes) {
-            Assets::Md2Model::FrameList modelFrames;
-            modelFrames.reserve(frames.size());
-            
-            for (const Md2Frame& frame : frames)
-                modelFrames.push_back(buildFrame(frame, meshes));
-            return modelFrames;
-        }
-
         Assets::Md2Model::Frame* Md2Parser::buildFrame(const Md2Frame& frame, const Md2MeshList& meshes) {
             size_t vertexCount = 0;
             Renderer::IndexRangeMap::Size size;
@@ -371,7 +379,7 @@ namespace TrenchBroom {
             return new Assets::Md2Model::Frame(builder.vertices(), builder.indexArray());
         }
         
-        Assets::Md2Model::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const {
+        Assets::Md2Model::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) {
             typedef Assets::Md2Model::Vertex Vertex;
 
             Vertex::List result(0);
@@ -93,6 +93,7 @@ namespace TrenchBroom {
             };
             typedef std::vector<Md2Mesh> Md2MeshList;
             
+            class FrameBuilder;
             
             String m_name;
             const char* m_begin;
@@ -109,9 +110,8 @@ namespace TrenchBroom {
             Assets::EntityModel* buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes);
             Assets::TextureList loadTextures(const Md2SkinList& skins);
             Assets::Texture* readTexture(const Md2Skin& skin);
-            Assets::Md2Model::FrameList buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes);
-            Assets::Md2Model::Frame* buildFrame(const Md2Frame& frame, const Md2MeshList& meshes);
-            Assets::Md2Model::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const;
+            static Assets::Md2Model::Frame* buildFrame(const Md2Frame& frame, const Md2MeshList& meshes);
+            static Assets::Md2Model::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices);
         };
     }
 }
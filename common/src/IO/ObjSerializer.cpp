@@ -25,6 +25,9 @@
 #include "Model/BrushGeometry.h"
 
 #include <cassert>
+#include <cstdarg>
+#include <exception>
+#include <thread>
 
 namespace TrenchBroom {
     namespace IO {
@@ -33,67 +36,192 @@ namespace TrenchBroom {
         texCoords(i_texCoords),
         normal(i_normal) {}
 
+        ObjFileSerializer::Chunk::Chunk() :
+        firstObject(0),
+        lastObject(0) {}
+        
         ObjFileSerializer::ObjFileSerializer(FILE* stream) :
-        m_stream(stream) {
+        m_stream(stream),
+        m_maxWorkers(std::max(1u, std::thread::hardware_concurrency())) {
             ensure(m_stream != NULL, "stream is null");
         }
 
+        ObjFileSerializer::ObjFileSerializer(FILE* stream, const size_t maxWorkers) :
+        m_stream(stream),
+        m_maxWorkers(std::max(static_cast<size_t>(1), maxWorkers)) {
+            ensure(m_stream != NULL, "stream is null");
+        }
+        
         void ObjFileSerializer::doBeginFile() {}
         
         void ObjFileSerializer::doEndFile() {
+            ChunkList chunks;
+            tessellateObjects(chunks);
+            
+            // merging the chunks in order assigns the same indices as tessellating the objects one after the other
+            for (Chunk& chunk : chunks)
+                mergeChunk(chunk);
+            
             writeVertices();
-            std::fprintf(m_stream, "\n");
+            write("\n");
             writeTexCoords();
-            std::fprintf(m_stream, "\n");
+            write("\n");
             writeNormals();
-            std::fprintf(m_stream, "\n");
-            writeObjects();
+            write("\n");
+            writeObjects(chunks);
+            flush();
         }
 
+        void ObjFileSerializer::tessellateObjects(ChunkList& chunks) const {
+            const size_t workerCount = std::max(static_cast<size_t>(1), std::min(m_maxWorkers, m_objects.size() / MinObjectsPerWorker));
+            const size_t rangeSize = (m_objects.size() + workerCount - 1) / workerCount;
+            
+            chunks.resize(workerCount);
+            for (size_t i = 0; i < workerCount; ++i) {
+                chunks[i].firstObject = std::min(i * rangeSize, m_objects.size());
+                chunks[i].lastObject = std::min(chunks[i].firstObject + rangeSize, m_objects.size());
+            }
+            
+            if (workerCount == 1) {
+                tessellateObjects(chunks.front());
+                return;
+            }
+            
+            // every worker only writes to its own chunk
+            std::vector<std::exception_ptr> errors(workerCount);
+            std::vector<std::thread> workers;
+            workers.reserve(workerCount);
+            
+            for (size_t i = 0; i < workerCount; ++i) {
+                workers.push_back(std::thread([this, &chunks, &errors, i]() {
+                    try {
+                        tessellateObjects(chunks[i]);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                }));
+            }
+            
+            for (std::thread& worker : workers)
+                worker.join();
+            
+            for (const std::exception_ptr& error : errors) {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        }
+        
+        void ObjFileSerializer::tessellateObjects(Chunk& chunk) const {
+            for (size_t i = chunk.firstObject; i < chunk.lastObject; ++i) {
+                for (const Model::BrushFace* face : m_objects[i].faces) {
+                    const size_t normalIndex = chunk.normals.index(face->boundary().normal);
+                    
+                    Vec3::List positions;
+                    positions.reserve(face->vertexCount());
+                    for (const Model::BrushVertex* vertex : face->vertices())
+                        positions.push_back(vertex->position());
+                    
+                    const Vec2f::List texCoords = face->textureCoords(positions);
+                    chunk.faceSizes.push_back(positions.size());
+                    
+                    for (size_t j = 0; j < positions.size(); ++j) {
+                        const size_t vertexIndex = chunk.vertices.index(positions[j]);
+                        const size_t texCoordsIndex = chunk.texCoords.index(texCoords[j]);
+                        
+                        chunk.faceVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
+                    }
+                }
+            }
+        }
+        
+        void ObjFileSerializer::mergeChunk(Chunk& chunk) {
+            std::vector<size_t> vertexIndices, texCoordsIndices, normalIndices;
+            vertexIndices.reserve(chunk.vertices.list().size());
+            texCoordsIndices.reserve(chunk.texCoords.list().size());
+            normalIndices.reserve(chunk.normals.list().size());
+            
+            for (const Vec3& vertex : chunk.vertices.list())
+                vertexIndices.push_back(m_vertices.index(vertex));
+            for (const Vec2f& texCoords : chunk.texCoords.list())
+                texCoordsIndices.push_back(m_texCoords.index(texCoords));
+            for (const Vec3& normal : chunk.normals.list())
+                normalIndices.push_back(m_normals.index(normal));
+            
+            for (IndexedVertex& vertex : chunk.faceVertices) {
+                vertex.vertex = vertexIndices[vertex.vertex];
+                vertex.texCoords = texCoordsIndices[vertex.texCoords];
+                vertex.normal = normalIndices[vertex.normal];
+            }
+            
+            chunk.vertices.clear();
+            chunk.texCoords.clear();
+            chunk.normals.clear();
+        }
+        
         void ObjFileSerializer::writeVertices() {
-            std::fprintf(m_stream, "# vertices\n");
+            write("# vertices\n");
             for (const Vec3& elem : m_vertices.list())
-                std::fprintf(m_stream, "v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+                write("v %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
         }
         
         void ObjFileSerializer::writeTexCoords() {
-            std::fprintf(m_stream, "# texture coordinates\n");
+            write("# texture coordinates\n");
             for (const Vec2f& elem : m_texCoords.list())
-                std::fprintf(m_stream, "vt %.17g %.17g\n", elem.x(), elem.y());
+                write("vt %.17g %.17g\n", elem.x(), elem.y());
         }
         
         void ObjFileSerializer::writeNormals() {
-            std::fprintf(m_stream, "# face normals\n");
+            write("# face normals\n");
             for (const Vec3& elem : m_normals.list())
-                std::fprintf(m_stream, "vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
+                write("vn %.17g %.17g %.17g\n", elem.x(), elem.z(), -elem.y()); // no idea why I have to switch Y and Z
         }
         
-        void ObjFileSerializer::writeObjects() {
-            std::fprintf(m_stream, "# objects\n");
-            for (const Object& object : m_objects) {
-            ObjectList::const_iterator fIt, fEnd;
-                std::fprintf(m_stream, "o entity%u_brush%u\n",
-                             static_cast<unsigned long>(object.entityNo),
-                             static_cast<unsigned long>(object.brushNo));
+        void ObjFileSerializer::writeObjects(const ChunkList& chunks) {
+            write("# objects\n");
+            for (const Chunk& chunk : chunks) {
+                std::vector<size_t>::const_iterator faceSize = std::begin(chunk.faceSizes);
+                IndexedVertexList::const_iterator vertex = std::begin(chunk.faceVertices);
                 
-                writeFaces(object.faces);
-                std::fprintf(m_stream, "\n");
-            }
-        }
-
-        void ObjFileSerializer::writeFaces(const FaceList& faces) {
-            for (const IndexedVertexList& face : faces) {
-                std::fprintf(m_stream, "f");
-                for (const IndexedVertex& vertex : face) {
-                    std::fprintf(m_stream, " %u/%u/%u",
-                                 static_cast<unsigned long>(vertex.vertex) + 1,
-                                 static_cast<unsigned long>(vertex.texCoords) + 1,
-                                 static_cast<unsigned long>(vertex.normal) + 1);
+                for (size_t i = chunk.firstObject; i < chunk.lastObject; ++i) {
+                    const Object& object = m_objects[i];
+                    write("o entity%u_brush%u\n", object.entityNo, object.brushNo);
+                    
+                    for (size_t j = 0; j < object.faces.size(); ++j) {
+                        write("f");
+                        for (size_t k = 0; k < *faceSize; ++k) {
+                            write(" %lu/%lu/%lu",
+                                  static_cast<unsigned long>(vertex->vertex) + 1,
+                                  static_cast<unsigned long>(vertex->texCoords) + 1,
+                                  static_cast<unsigned long>(vertex->normal) + 1);
+                            ++vertex;
+                        }
+                        write("\n");
+                        ++faceSize;
+                    }
+                    write("\n");
                 }
-                std::fprintf(m_stream, "\n");
             }
         }
 
+        void ObjFileSerializer::write(const char* format, ...) {
+            char line[128];
+            
+            va_list args;
+            va_start(args, format);
+            const int length = std::vsnprintf(line, sizeof(line), format, args);
+            va_end(args);
+            
+            assert(length >= 0 && static_cast<size_t>(length) < sizeof(line));
+            m_buffer.append(line, static_cast<size_t>(length));
+            if (m_buffer.size() >= OutputBufferSize)
+                flush();
+        }
+        
+        void ObjFileSerializer::flush() {
+            std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_stream);
+            m_buffer.clear();
+        }
+        
         void ObjFileSerializer::doBeginEntity(const Model::Node* node) {}
         void ObjFileSerializer::doEndEntity(Model::Node* node) {}
         void ObjFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {}
@@ -109,25 +237,8 @@ namespace TrenchBroom {
         }
         
         void ObjFileSerializer::doBrushFace(Model::BrushFace* face) {
-            const Vec3& normal = face->boundary().normal;
-            const size_t normalIndex = m_normals.index(normal);
-            
-            const Model::BrushFace::VertexList vertices = face->vertices();
-            IndexedVertexList indexedVertices;
-            indexedVertices.reserve(vertices.size());
-            
-            for (const Model::BrushVertex* vertex : vertices) {
-            Model::BrushFace::VertexList::const_iterator it, end;
-                const Vec3& position = vertex->position();
-                const Vec2f texCoords = face->textureCoords(position);
-                
-                const size_t vertexIndex = m_vertices.index(position);
-                const size_t texCoordsIndex = m_texCoords.index(texCoords);
-                
-                indexedVertices.push_back(IndexedVertex(vertexIndex, texCoordsIndex, normalIndex));
-            }
-            
-            m_currentObject.faces.push_back(indexedVertices);
+            // the faces are tessellated concurrently once the whole map has been traversed
+            m_currentObject.faces.push_back(face);
         }
     }
 }
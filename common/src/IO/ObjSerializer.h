@@ -24,21 +24,40 @@
 #include "VecMath.h"
 #include "Model/ModelTypes.h"
 
+#include <algorithm>
 #include <cstdio>
-#include <list>
-#include <map>
+#include <cstring>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
         class ObjFileSerializer : public NodeSerializer {
         private:
+            static const size_t MinObjectsPerWorker = 256;
+            static const size_t OutputBufferSize = 64 * 1024;
+            
+            struct VecHash {
+                template <typename T, size_t S>
+                size_t operator()(const Vec<T,S>& v) const {
+                    size_t result = 0;
+                    for (size_t i = 0; i < S; ++i) {
+                        // vectors compare equal if their components do, so -0 and +0 must hash alike
+                        const T c = v[i] == static_cast<T>(0.0) ? static_cast<T>(0.0) : v[i];
+                        size_t bits = 0;
+                        std::memcpy(&bits, &c, std::min(sizeof(bits), sizeof(c)));
+                        result ^= bits + 0x9e3779b9 + (result << 6) + (result >> 2);
+                    }
+                    return result;
+                }
+            };
+            
             template <typename V>
             class IndexMap {
             public:
                 typedef std::vector<V> List;
             private:
-                typedef std::map<V, size_t> Map;
+                typedef std::unordered_map<V, size_t, VecHash> Map;
                 Map m_map;
                 List m_list;
             public:
@@ -47,12 +66,16 @@ namespace TrenchBroom {
                 }
                 
                 size_t index(const V& v) {
-                    typename Map::iterator indexIt = MapUtils::findOrInsert(m_map, v, m_list.size());
-                    const size_t index = indexIt->second;
+                    const size_t index = m_map.insert(std::make_pair(v, m_list.size())).first->second;
                     if (index == m_list.size())
                         m_list.push_back(v);
                     return index;
                 }
+                
+                void clear() {
+                    Map().swap(m_map);
+                    List().swap(m_list);
+                }
             };
 
             struct IndexedVertex {
@@ -64,17 +87,38 @@ namespace TrenchBroom {
             };
             
             typedef std::vector<IndexedVertex> IndexedVertexList;
-            typedef std::list<IndexedVertexList> FaceList;
 
             struct Object {
-                size_t entityNo;
-                size_t brushNo;
-                FaceList faces;
+                ObjectNo entityNo;
+                ObjectNo brushNo;
+                Model::BrushFaceList faces;
+            };
+            
+            typedef std::vector<Object> ObjectList;
+            
+            /**
+             The tessellated faces of a contiguous range of objects. The indices refer to the chunk's
+             own index maps until they are remapped to the global index maps.
+             */
+            struct Chunk {
+                size_t firstObject;
+                size_t lastObject;
+                
+                IndexMap<Vec3> vertices;
+                IndexMap<Vec2f> texCoords;
+                IndexMap<Vec3> normals;
+                
+                std::vector<size_t> faceSizes;
+                IndexedVertexList faceVertices;
+                
+                Chunk();
             };
             
-            typedef std::list<Object> ObjectList;
+            typedef std::vector<Chunk> ChunkList;
             
             FILE* m_stream;
+            size_t m_maxWorkers;
+            String m_buffer;
 
             IndexMap<Vec3> m_vertices;
             IndexMap<Vec2f> m_texCoords;
@@ -84,15 +128,22 @@ namespace TrenchBroom {
             ObjectList m_objects;
         public:
             ObjFileSerializer(FILE* stream);
+            ObjFileSerializer(FILE* stream, size_t maxWorkers);
         private:
             void doBeginFile();
             void doEndFile();
             
+            void tessellateObjects(ChunkList& chunks) const;
+            void tessellateObjects(Chunk& chunk) const;
+            void mergeChunk(Chunk& chunk);
+            
             void writeVertices();
             void writeTexCoords();
             void writeNormals();
-            void writeObjects();
-            void writeFaces(const FaceList& faces);
+            void writeObjects(const ChunkList& chunks);
+            
+            void write(const char* format, ...);
+            void flush();
             
             void doBeginEntity(const Model::Node* node);
             void doEndEntity(Model::Node* node);
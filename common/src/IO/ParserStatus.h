@@ -53,6 +53,10 @@ namespace TrenchBroom {
             void log(Logger::LogLevel level, size_t line, const String& str);
             String buildMessage(size_t line, const String& str) const;
         private:
+            /**
+             Called with the fraction of the input that has been consumed so far. Implementations may abort
+             parsing by throwing an OperationCancelledException.
+             */
             virtual void doProgress(double progress) = 0;
         };
     }
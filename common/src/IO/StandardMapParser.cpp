@@ -178,8 +178,10 @@ namespace TrenchBroom {
             while (token.type() != QuakeMapToken::Eof) {
                 expect(QuakeMapToken::OBrace, token);
                 parseEntity(status);
+                status.progress(m_tokenizer.progress());
                 token = m_tokenizer.peekToken();
             }
+            status.progress(1.0);
         }
         
         void StandardMapParser::parseBrushes(const Model::MapFormat::Type format, ParserStatus& status) {
@@ -245,6 +247,7 @@ namespace TrenchBroom {
                             beginEntityCalled = true;
                         }
                         parseBrush(status);
+                        status.progress(m_tokenizer.progress());
                         break;
                     case QuakeMapToken::CBrace:
                         m_tokenizer.nextToken();
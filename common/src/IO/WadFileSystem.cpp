@@ -78,7 +78,7 @@ namespace TrenchBroom {
                 
                 IO::Path path(entryName);
                 MappedFile::Ptr file(new MappedFileView(m_file, path, entryBegin, entryEnd));
-                m_root.addFile(path, file);
+                addFile(path, file);
             }
         }
     }
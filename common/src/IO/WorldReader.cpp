@@ -37,7 +37,13 @@ namespace TrenchBroom {
         m_world(NULL) {}
         
         Model::World* WorldReader::read(Model::MapFormat::Type format, const BBox3& worldBounds, ParserStatus& status) {
-            readEntities(format, worldBounds, status);
+            try {
+                readEntities(format, worldBounds, status);
+            } catch (...) {
+                delete m_world;
+                m_world = NULL;
+                throw;
+            }
             return m_world;
         }
 
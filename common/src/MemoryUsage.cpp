@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace TrenchBroom {
+    MemoryUsage::Entry::Entry(const String& i_category, const size_t i_count, const size_t i_bytes) :
+    category(i_category),
+    count(i_count),
+    bytes(i_bytes) {}
+    
+    void MemoryUsage::add(const String& category, const size_t count, const size_t bytes) {
+        for (Entry& entry : m_entries) {
+            if (entry.category == category) {
+                entry.count += count;
+                entry.bytes += bytes;
+                return;
+            }
+        }
+        m_entries.push_back(Entry(category, count, bytes));
+    }
+    
+    const MemoryUsage::EntryList& MemoryUsage::entries() const {
+        return m_entries;
+    }
+    
+    const MemoryUsage::Entry* MemoryUsage::entry(const String& category) const {
+        for (const Entry& entry : m_entries) {
+            if (entry.category == category)
+                return &entry;
+        }
+        return NULL;
+    }
+    
+    size_t MemoryUsage::totalBytes() const {
+        size_t result = 0;
+        for (const Entry& entry : m_entries)
+            result += entry.bytes;
+        return result;
+    }
+    
+    String MemoryUsage::asString() const {
+        size_t width = 5;
+        for (const Entry& entry : m_entries)
+            width = std::max(width, entry.category.size());
+        
+        StringStream str;
+        str << std::left << std::setw(static_cast<int>(width)) << "Category" << std::right << std::setw(12) << "Count" << std::setw(16) << "Bytes" << std::endl;
+        for (const Entry& entry : m_entries)
+            str << std::left << std::setw(static_cast<int>(width)) << entry.category << std::right << std::setw(12) << entry.count << std::setw(16) << entry.bytes << std::endl;
+        str << std::left << std::setw(static_cast<int>(width)) << "Total" << std::right << std::setw(12) << "" << std::setw(16) << totalBytes() << std::endl;
+        return str.str();
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_MemoryUsage
+#define TrenchBroom_MemoryUsage
+
+#include "StringUtils.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     Collects the approximate number of bytes used by the parts of a document, grouped into categories.
+     Categories are reported in the order in which they were first added.
+     */
+    class MemoryUsage {
+    public:
+        struct Entry {
+            String category;
+            size_t count;
+            size_t bytes;
+            
+            Entry(const String& i_category, size_t i_count, size_t i_bytes);
+        };
+        typedef std::vector<Entry> EntryList;
+    private:
+        EntryList m_entries;
+    public:
+        void add(const String& category, size_t count, size_t bytes);
+        
+        const EntryList& entries() const;
+        const Entry* entry(const String& category) const;
+        size_t totalBytes() const;
+        
+        String asString() const;
+    };
+}
+
+#endif /* defined(TrenchBroom_MemoryUsage) */
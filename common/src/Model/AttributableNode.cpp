@@ -21,6 +21,8 @@
 
 #include "Assets/AttributeDefinition.h"
 
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Model {
         Assets::EntityDefinition* AttributableNode::selectEntityDefinition(const AttributableNodeList& attributables) {
@@ -235,7 +237,7 @@ namespace TrenchBroom {
             if (!attributes.empty()) {
                 const NotifyAttributeChange notifyChange(this);
 
-                for (const EntityAttribute& attribute : m_attributes.attributes()) {
+                for (const EntityAttribute& attribute : attributes) {
                     const AttributeName& name = attribute.name();
                     const AttributeValue& value = attribute.value();
                     
@@ -291,8 +293,8 @@ namespace TrenchBroom {
             EntityAttribute::List oldSorted = m_attributes.attributes();
             EntityAttribute::List newSorted = newAttributes;
             
-            oldSorted.sort();
-            newSorted.sort();
+            std::sort(std::begin(oldSorted), std::end(oldSorted));
+            std::sort(std::begin(newSorted), std::end(newSorted));
             
             auto oldIt = std::begin(oldSorted);
             auto oldEnd = std::end(oldSorted);
@@ -22,7 +22,9 @@
 #include "CollectionUtils.h"
 #include "Macros.h"
 #include "Model/AttributableNode.h"
+#include "Model/EntityAttributes.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace TrenchBroom {
@@ -43,18 +45,12 @@ namespace TrenchBroom {
             return AttributableNodeIndexQuery(Type_Any);
         }
         
-        AttributableNodeSet AttributableNodeIndexQuery::execute(const AttributableNodeStringIndex& index) const {
-            switch (m_type) {
-                case Type_Exact:
-                    return index.queryExactMatches(m_pattern);
-                case Type_Prefix:
-                    return index.queryPrefixMatches(m_pattern);
-                case Type_Numbered:
-                    return index.queryNumberedMatches(m_pattern);
-                case Type_Any:
-                    return EmptyAttributableNodeSet;
-                switchDefault()
-            }
+        AttributableNodeIndexQuery::Type AttributableNodeIndexQuery::type() const {
+            return m_type;
+        }
+        
+        const String& AttributableNodeIndexQuery::pattern() const {
+            return m_pattern;
         }
         
         bool AttributableNodeIndexQuery::execute(const AttributableNode* node, const String& value) const {
@@ -86,35 +82,67 @@ namespace TrenchBroom {
         }
 
         void AttributableNodeIndex::addAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.insert(name, attributable);
-            m_valueIndex.insert(value, attributable);
+            insert(m_nameIndex, name, attributable);
+            insert(m_valueIndex, value, attributable);
         }
         
         void AttributableNodeIndex::removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value) {
-            m_nameIndex.remove(name, attributable);
-            m_valueIndex.remove(value, attributable);
+            remove(m_nameIndex, name, attributable);
+            remove(m_valueIndex, value, attributable);
         }
 
         AttributableNodeList AttributableNodeIndex::findAttributableNodes(const AttributableNodeIndexQuery& nameQuery, const AttributeValue& value) const {
-            const AttributableNodeSet nameResult = nameQuery.execute(m_nameIndex);
-            const AttributableNodeSet valueResult = m_valueIndex.queryExactMatches(value);
-            
-            if (nameResult.empty() || valueResult.empty())
+            const AttributableNodeCounts* valueNodes = find(m_valueIndex, value);
+            if (valueNodes == NULL)
                 return EmptyAttributableNodeList;
-
-            AttributableNodeList result;
-            SetUtils::intersection(nameResult, valueResult, result);
             
-            AttributableNodeList::iterator it = std::begin(result);
-            while (it != std::end(result)) {
-                const AttributableNode* node = *it;
-                if (!nameQuery.execute(node, value))
-                    it = result.erase(it);
-                else
-                    ++it;
+            // for exact queries, start with whichever of the two candidate sets is smaller
+            const AttributableNodeCounts* candidates = valueNodes;
+            if (nameQuery.type() == AttributableNodeIndexQuery::Type_Exact) {
+                const AttributableNodeCounts* nameNodes = find(m_nameIndex, nameQuery.pattern());
+                if (nameNodes == NULL)
+                    return EmptyAttributableNodeList;
+                if (nameNodes->size() < valueNodes->size())
+                    candidates = nameNodes;
             }
             
+            AttributableNodeList result;
+            for (const auto& entry : *candidates) {
+                AttributableNode* node = entry.first;
+                if (valueNodes->count(node) > 0 && nameQuery.execute(node, value))
+                    result.push_back(node);
+            }
+            
+            std::sort(std::begin(result), std::end(result));
             return result;
         }
+        
+        void AttributableNodeIndex::insert(AttributableNodeStringIndex& index, const String& key, AttributableNode* node) {
+            ++index[key][node];
+        }
+        
+        void AttributableNodeIndex::remove(AttributableNodeStringIndex& index, const String& key, AttributableNode* node) {
+            const auto keyIt = index.find(key);
+            if (keyIt == std::end(index))
+                return;
+            
+            AttributableNodeCounts& nodes = keyIt->second;
+            const auto nodeIt = nodes.find(node);
+            if (nodeIt == std::end(nodes))
+                return;
+            
+            if (--nodeIt->second == 0) {
+                nodes.erase(nodeIt);
+                if (nodes.empty())
+                    index.erase(keyIt);
+            }
+        }
+        
+        const AttributableNodeCounts* AttributableNodeIndex::find(const AttributableNodeStringIndex& index, const String& key) {
+            const auto it = index.find(key);
+            if (it == std::end(index))
+                return NULL;
+            return &it->second;
+        }
     }
 }
@@ -22,14 +22,15 @@
 
 #include "StringUtils.h"
 #include "Model/ModelTypes.h"
-#include "StringMap.h"
 
-#include <map>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Model {
-        typedef StringMultiMapValueContainer<AttributableNode*> AttributableNodeIndexValueContainer;
-        typedef StringMap<AttributableNode*, AttributableNodeIndexValueContainer> AttributableNodeStringIndex;
+        // maps each node to the number of times it was added for a key, since a node can have several attributes
+        // with the same value
+        typedef std::unordered_map<AttributableNode*, size_t> AttributableNodeCounts;
+        typedef std::unordered_map<String, AttributableNodeCounts> AttributableNodeStringIndex;
         
         class AttributableNodeIndexQuery {
         public:
@@ -48,12 +49,19 @@ namespace TrenchBroom {
             static AttributableNodeIndexQuery numbered(const String& pattern);
             static AttributableNodeIndexQuery any();
 
-            AttributableNodeSet execute(const AttributableNodeStringIndex& index) const;
+            Type type() const;
+            const String& pattern() const;
+            
             bool execute(const AttributableNode* node, const String& value) const;
         private:
             AttributableNodeIndexQuery(Type type, const String& pattern = "");
         };
         
+        /**
+         Indexes attributable nodes by the names and values of their attributes. Values are only looked up
+         exactly, so queries start with the nodes that have the given value and then check the names, which
+         may be matched exactly, by prefix or as numbered attributes.
+         */
         class AttributableNodeIndex {
         private:
             AttributableNodeStringIndex m_nameIndex;
@@ -66,6 +74,10 @@ namespace TrenchBroom {
             void removeAttribute(AttributableNode* attributable, const AttributeName& name, const AttributeValue& value);
             
             AttributableNodeList findAttributableNodes(const AttributableNodeIndexQuery& keyQuery, const AttributeValue& value) const;
+        private:
+            static void insert(AttributableNodeStringIndex& index, const String& key, AttributableNode* node);
+            static void remove(AttributableNodeStringIndex& index, const String& key, AttributableNode* node);
+            static const AttributableNodeCounts* find(const AttributableNodeStringIndex& index, const String& key);
         };
     }
 }
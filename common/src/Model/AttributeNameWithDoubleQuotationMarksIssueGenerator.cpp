@@ -68,6 +68,10 @@ namespace TrenchBroom {
                                                               [] (const AttributeValue& value) { return value; }));
         }
         
+        bool AttributeNameWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void AttributeNameWithDoubleQuotationMarksIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const AttributeName& attributeName = attribute.name();
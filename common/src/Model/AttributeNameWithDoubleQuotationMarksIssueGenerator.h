@@ -31,6 +31,7 @@ namespace TrenchBroom {
         public:
             AttributeNameWithDoubleQuotationMarksIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(AttributableNode* node, IssueList& issues) const;
         };
     }
@@ -68,6 +68,10 @@ namespace TrenchBroom {
                                                               [] (const AttributeValue& value) { return StringUtils::replaceAll(value, "\"", "'"); }));
         }
         
+        bool AttributeValueWithDoubleQuotationMarksIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void AttributeValueWithDoubleQuotationMarksIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             for (const EntityAttribute& attribute : node->attributes()) {
                 const AttributeName& attributeName = attribute.name();
@@ -365,6 +365,23 @@ namespace TrenchBroom {
         };
         
 
+        class Brush::RestoreGeometryCallback : public BrushGeometry::Callback {
+        private:
+            const BrushFaceList& m_faces;
+            size_t m_index;
+        public:
+            RestoreGeometryCallback(const BrushFaceList& faces) :
+            m_faces(faces),
+            m_index(0) {}
+            
+            void faceWasCreated(BrushFaceGeometry* face) {
+                ensure(m_index < m_faces.size(), "more geometry faces than brush faces");
+                BrushFace* brushFace = m_faces[m_index++];
+                face->setPayload(brushFace);
+                brushFace->setGeometry(face);
+            }
+        };
+
         Brush::Brush(const BBox3& worldBounds, const BrushFaceList& faces) :
         m_geometry(NULL),
         m_contentTypeBuilder(NULL),
@@ -380,6 +397,48 @@ namespace TrenchBroom {
             }
         }
 
+        Brush::Brush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) :
+        m_geometry(NULL),
+        m_contentTypeBuilder(NULL),
+        m_contentType(0),
+        m_transparent(false),
+        m_contentTypeValid(true) {
+            addFaces(faces);
+            try {
+                if (faceSizes.size() != m_faces.size())
+                    throw GeometryException("Brush topology does not match brush faces");
+                
+                RestoreGeometryCallback callback(m_faces);
+                m_geometry = new BrushGeometry(positions, faceSizes, faceIndices, callback);
+                updateFacesFromGeometry(worldBounds);
+                nodeBoundsDidChange();
+            } catch (const GeometryException&) {
+                cleanup();
+                throw;
+            }
+        }
+
+        Brush::Brush(const BBox3& worldBounds, const BrushFaceList& faces, const BrushGeometry& geometry) :
+        m_geometry(NULL),
+        m_contentTypeBuilder(NULL),
+        m_contentType(0),
+        m_transparent(false),
+        m_contentTypeValid(true) {
+            assert(faces.size() == geometry.faceCount());
+            addFaces(faces);
+            m_geometry = new BrushGeometry(geometry);
+            
+            BrushFaceList::const_iterator faceIt = std::begin(m_faces);
+            for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
+                BrushFace* face = *faceIt++;
+                faceGeometry->setPayload(face);
+                face->setGeometry(faceGeometry);
+            }
+            
+            updateFacesFromGeometry(worldBounds);
+            nodeBoundsDidChange();
+        }
+
         Brush::~Brush() {
             cleanup();
         }
@@ -800,21 +859,17 @@ namespace TrenchBroom {
         }
 
         bool Brush::canSnapVertices(const BBox3& worldBounds, const size_t snapTo) {
-            const FloatType snapToF = static_cast<FloatType>(snapTo);
-            BrushGeometry newGeometry;
-            
-            for (const BrushVertex* vertex : m_geometry->vertices()) {
-                const Vec3& origin = vertex->position();
-                const Vec3 destination = snapToF * (origin / snapToF).rounded();
-                newGeometry.addPoint(destination);
-            }
-            
-            return newGeometry.polyhedron();
+            return snappedGeometry(snapTo).polyhedron();
         }
 
         void Brush::snapVertices(const BBox3& worldBounds, const size_t snapTo) {
+            BrushGeometry newGeometry = snappedGeometry(snapTo);
+            snapVertices(worldBounds, snapTo, newGeometry);
+        }
+        
+        BrushGeometry Brush::snappedGeometry(const size_t snapTo) const {
             ensure(m_geometry != NULL, "geometry is null");
-
+            
             const FloatType snapToF = static_cast<FloatType>(snapTo);
             BrushGeometry newGeometry;
             
@@ -823,7 +878,14 @@ namespace TrenchBroom {
                 const Vec3 destination = snapToF * (origin / snapToF).rounded();
                 newGeometry.addPoint(destination);
             }
-
+            
+            return newGeometry;
+        }
+        
+        void Brush::snapVertices(const BBox3& worldBounds, const size_t snapTo, BrushGeometry& newGeometry) {
+            ensure(m_geometry != NULL, "geometry is null");
+            
+            const FloatType snapToF = static_cast<FloatType>(snapTo);
             Vec3::Map vertexMapping;
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
@@ -1138,10 +1200,31 @@ namespace TrenchBroom {
         }
 
         void Brush::findIntegerPlanePoints(const BBox3& worldBounds) {
+            setPlanePoints(worldBounds, integerPlanePoints());
+        }
+
+        Vec3::List Brush::integerPlanePoints() const {
+            Vec3::List result;
+            result.reserve(3 * m_faces.size());
+            
+            for (const BrushFace* face : m_faces) {
+                BrushFace::Points points;
+                face->findIntegerPlanePoints(points);
+                result.insert(std::end(result), std::begin(points), std::end(points));
+            }
+            
+            return result;
+        }
+        
+        void Brush::setPlanePoints(const BBox3& worldBounds, const Vec3::List& points) {
+            ensure(points.size() == 3 * m_faces.size(), "wrong number of plane points");
+            
             const NotifyNodeChange nodeChange(this);
             
-            for (BrushFace* face : m_faces)
-                face->findIntegerPlanePoints();
+            for (size_t i = 0; i < m_faces.size(); ++i) {
+                const BrushFace::Points facePoints = { points[3 * i + 0], points[3 * i + 1], points[3 * i + 2] };
+                m_faces[i]->setIntegerPlanePoints(facePoints);
+            }
             rebuildGeometry(worldBounds);
         }
 
@@ -1216,10 +1299,19 @@ namespace TrenchBroom {
             BrushFaceList faceClones;
             faceClones.reserve(m_faces.size());
             
-            for (const BrushFace* face : m_faces)
-                faceClones.push_back(face->clone());
+            Brush* brush = NULL;
+            if (fullySpecified()) {
+                // the geometry is copied rather than recomputed from the face planes, so the face clones
+                // must be in the order of the geometry's faces
+                for (const BrushFaceGeometry* faceGeometry : m_geometry->faces())
+                    faceClones.push_back(faceGeometry->payload()->clone());
+                brush = new Brush(worldBounds, faceClones, *m_geometry);
+            } else {
+                for (const BrushFace* face : m_faces)
+                    faceClones.push_back(face->clone());
+                brush = new Brush(worldBounds, faceClones);
+            }
             
-            Brush* brush = new Brush(worldBounds, faceClones);
             brush->setContentTypeBuilder(m_contentTypeBuilder);
             cloneAttributes(brush);
             return brush;
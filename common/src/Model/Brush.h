@@ -60,6 +60,7 @@ namespace TrenchBroom {
             typedef MoveVerticesCallback RemoveVertexCallback;
             class QueryCallback;
             class FaceMatchingCallback;
+            class RestoreGeometryCallback;
         public:
             typedef ConstProjectingSequence<BrushVertexList, ProjectToVertex> VertexList;
             typedef ConstProjectingSequence<BrushEdgeList, ProjectToEdge> EdgeList;
@@ -73,8 +74,18 @@ namespace TrenchBroom {
             mutable bool m_contentTypeValid;
         public:
             Brush(const BBox3& worldBounds, const BrushFaceList& faces);
+            /**
+             Creates a brush whose geometry is restored from the given topology instead of being computed by
+             intersecting the face planes. The i-th face is bound to the i-th face of the topology.
+             */
+            Brush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices);
             ~Brush();
         private:
+            /**
+             Creates a brush with a copy of the given geometry. The i-th face is bound to the i-th face of the geometry.
+             */
+            Brush(const BBox3& worldBounds, const BrushFaceList& faces, const BrushGeometry& geometry);
+            
             void cleanup();
         public:
             Brush* clone(const BBox3& worldBounds) const;
@@ -166,6 +177,15 @@ namespace TrenchBroom {
             
             bool canSnapVertices(const BBox3& worldBounds, size_t snapTo);
             void snapVertices(const BBox3& worldBounds, size_t snapTo);
+            /**
+             Computes the geometry that snapping the vertices to the given grid size would result in. The brush is
+             not modified, so this can be called concurrently for different brushes.
+             */
+            BrushGeometry snappedGeometry(size_t snapTo) const;
+            /**
+             Snaps the vertices using a geometry that was previously computed by snappedGeometry.
+             */
+            void snapVertices(const BBox3& worldBounds, size_t snapTo, BrushGeometry& snappedGeometry);
 
             // edge operations
             bool canMoveEdges(const BBox3& worldBounds, const Edge3::List& edgePositions, const Vec3& delta) const;
@@ -206,6 +226,12 @@ namespace TrenchBroom {
         public: // brush geometry
             void rebuildGeometry(const BBox3& worldBounds);
             void findIntegerPlanePoints(const BBox3& worldBounds);
+            /**
+             Computes integer plane points for the faces without modifying the brush, so this can be called
+             concurrently for different brushes. The result contains three points per face in face order.
+             */
+            Vec3::List integerPlanePoints() const;
+            void setPlanePoints(const BBox3& worldBounds, const Vec3::List& points);
         private:
             bool checkGeometry() const;
         public: // content type
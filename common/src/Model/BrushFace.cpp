@@ -302,7 +302,7 @@ namespace TrenchBroom {
 
         void BrushFace::updateTexture(Assets::TextureManager* textureManager) {
             ensure(textureManager != NULL, "textureManager is null");
-            Assets::Texture* texture = textureManager->texture(textureName());
+            Assets::Texture* texture = textureManager->texture(m_attribs.internedTextureName());
             setTexture(texture);
             invalidateVertexCache();
         }
@@ -471,6 +471,16 @@ namespace TrenchBroom {
             setPoints(m_points[0], m_points[1], m_points[2]);
         }
 
+        void BrushFace::findIntegerPlanePoints(Points& points) const {
+            for (size_t i = 0; i < 3; ++i)
+                points[i] = m_points[i];
+            PlanePointFinder::findPoints(m_boundary, points, 3);
+        }
+        
+        void BrushFace::setIntegerPlanePoints(const Points& points) {
+            setPoints(points[0], points[1], points[2]);
+        }
+
         Mat4x4 BrushFace::projectToBoundaryMatrix() const {
             const Vec3 texZAxis = m_texCoordSystem->fromMatrix(Vec2f::Null, Vec2f::One) * Vec3::PosZ;
             const Mat4x4 worldToPlaneMatrix = planeProjectionMatrix(m_boundary.distance, m_boundary.normal, texZAxis);
@@ -605,6 +615,13 @@ namespace TrenchBroom {
         Vec2f BrushFace::textureCoords(const Vec3& point) const {
             return m_texCoordSystem->getTexCoords(point, m_attribs);
         }
+        
+        Vec2f::List BrushFace::textureCoords(const Vec3::List& points) const {
+            Vec2f::List result(points.size());
+            if (!points.empty())
+                m_texCoordSystem->getTexCoords(&points.front(), points.size(), m_attribs, &result.front());
+            return result;
+        }
 
         bool BrushFace::containsPoint(const Vec3& point) const {
             const Vec3 toPoint = point - m_boundary.anchor();
@@ -625,6 +642,10 @@ namespace TrenchBroom {
             return intersectPolygonWithRay(ray, m_boundary, m_geometry->boundary().begin(), m_geometry->boundary().end(), BrushGeometry::GetVertexPosition());
         }
 
+        size_t BrushFace::memoryUsage() const {
+            return sizeof(BrushFace) + m_cachedVertices.capacity() * sizeof(Vertex);
+        }
+        
         void BrushFace::printPoints() const {
             std::for_each(std::begin(m_points), std::end(m_points), [](const Vec3& p) { std::cout << "( " << p.asString(3) << " ) "; });
             std::cout << std::endl;
@@ -663,19 +684,26 @@ namespace TrenchBroom {
         
         void BrushFace::validateVertexCache() const {
             if (!m_verticesValid) {
-                m_cachedVertices.clear();
-                m_cachedVertices.reserve(vertexCount());
+                Vec3::List positions;
+                positions.reserve(vertexCount());
                 
                 const BrushHalfEdge* first = m_geometry->boundary().front();
                 const BrushHalfEdge* current = first;
                 do {
-                    const Vec3& position = current->origin()->position();
-                    m_cachedVertices.push_back(Vertex(position, m_boundary.normal, textureCoords(position)));
+                    positions.push_back(current->origin()->position());
                     
                     // The boundary is in CCW order, but the renderer expects CW order:
                     current = current->previous();
                 } while (current != first);
                 
+                // compute the texture coordinates of all vertices at once instead of one virtual call per vertex
+                const Vec2f::List texCoords = textureCoords(positions);
+                
+                m_cachedVertices.clear();
+                m_cachedVertices.reserve(positions.size());
+                for (size_t i = 0; i < positions.size(); ++i)
+                    m_cachedVertices.push_back(Vertex(positions[i], m_boundary.normal, texCoords[i]));
+                
                 m_verticesValid = true;
             }
         }
@@ -174,6 +174,12 @@ namespace TrenchBroom {
             void updatePointsFromVertices();
             void snapPlanePointsToInteger();
             void findIntegerPlanePoints();
+            /**
+             Computes the points that findIntegerPlanePoints would set without modifying this face, and
+             setIntegerPlanePoints sets them later on.
+             */
+            void findIntegerPlanePoints(Points& points) const;
+            void setIntegerPlanePoints(const Points& points);
             
             Mat4x4 projectToBoundaryMatrix() const;
             Mat4x4 toTexCoordSystemMatrix(const Vec2f& offset, const Vec2f& scale, bool project) const;
@@ -203,10 +209,17 @@ namespace TrenchBroom {
             void getFaceIndices(Renderer::TexturedIndexArrayBuilder& builder) const;
             
             Vec2f textureCoords(const Vec3& point) const;
+            Vec2f::List textureCoords(const Vec3::List& points) const;
 
             bool containsPoint(const Vec3& point) const;
             FloatType intersectWithRay(const Ray3& ray) const;
             
+            /**
+             Returns the number of bytes used by this face and its vertex cache. The texture name is
+             interned and shared with other faces, so it is not included.
+             */
+            size_t memoryUsage() const;
+            
             void printPoints() const;
         private:
             void setPoints(const Vec3& point0, const Vec3& point1, const Vec3& point2);
@@ -33,6 +33,16 @@ namespace TrenchBroom {
         m_surfaceFlags(0),
         m_surfaceValue(0.0f) {}
         
+        BrushFaceAttributes::BrushFaceAttributes(const Assets::TextureName& textureName) :
+        m_textureName(textureName),
+        m_texture(NULL),
+        m_offset(Vec2f::Null),
+        m_scale(Vec2f(1.0f, 1.0f)),
+        m_rotation(0.0f),
+        m_surfaceContents(0),
+        m_surfaceFlags(0),
+        m_surfaceValue(0.0f) {}
+        
         BrushFaceAttributes::BrushFaceAttributes(const BrushFaceAttributes& other) :
         m_textureName(other.m_textureName),
         m_texture(other.m_texture),
@@ -81,6 +91,10 @@ namespace TrenchBroom {
         }
 
         const String& BrushFaceAttributes::textureName() const {
+            return m_textureName.name();
+        }
+        
+        const Assets::TextureName& BrushFaceAttributes::internedTextureName() const {
             return m_textureName;
         }
         
@@ -146,7 +160,7 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != NULL) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                m_textureName = m_texture->internedName();
             }
         }
         
@@ -154,7 +168,9 @@ namespace TrenchBroom {
             if (m_texture != NULL)
                 m_texture->decUsageCount();
             m_texture = NULL;
-            m_textureName = BrushFace::NoTextureName;
+            
+            static const Assets::TextureName NoTextureName(BrushFace::NoTextureName);
+            m_textureName = NoTextureName;
         }
 
         void BrushFaceAttributes::setOffset(const Vec2f& offset) {
@@ -23,6 +23,7 @@
 #include "TrenchBroom.h"
 #include "VecMath.h"
 #include "StringUtils.h"
+#include "Assets/TextureName.h"
 
 namespace TrenchBroom {
     namespace Assets {
@@ -30,9 +31,13 @@ namespace TrenchBroom {
     }
     
     namespace Model {
+        /**
+         The texture and texture alignment of a brush face. Every face keeps its own copy, but the texture name is
+         interned, so the copy only consists of a few numbers and two pointers.
+         */
         class BrushFaceAttributes {
         private:
-            String m_textureName;
+            Assets::TextureName m_textureName;
             Assets::Texture* m_texture;
             
             Vec2f m_offset;
@@ -44,6 +49,7 @@ namespace TrenchBroom {
             float m_surfaceValue;
         public:
             BrushFaceAttributes(const String& textureName);
+            BrushFaceAttributes(const Assets::TextureName& textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
             ~BrushFaceAttributes();
             BrushFaceAttributes& operator=(BrushFaceAttributes other);
@@ -52,6 +58,7 @@ namespace TrenchBroom {
             BrushFaceAttributes takeSnapshot() const;
             
             const String& textureName() const;
+            const Assets::TextureName& internedTextureName() const;
             Assets::Texture* texture() const;
             Vec2f textureSize() const;
             
@@ -39,5 +39,9 @@ namespace TrenchBroom {
             if (m_coordSystemSnapshot != nullptr)
                 face->restoreTexCoordSystemSnapshot(m_coordSystemSnapshot);
         }
+        
+        size_t BrushFaceSnapshot::memoryUsage() const {
+            return sizeof(BrushFaceSnapshot) + (m_coordSystemSnapshot != nullptr ? sizeof(TexCoordSystemSnapshot) : 0);
+        }
     }
 }
@@ -34,6 +34,7 @@ namespace TrenchBroom {
             BrushFaceSnapshot(BrushFace* face, TexCoordSystem* coordSystemSnapshot);
             ~BrushFaceSnapshot();
             void restore();
+            size_t memoryUsage() const;
         };
     }
 }
@@ -46,5 +46,12 @@ namespace TrenchBroom {
             m_brush->setFaces(worldBounds, m_faces);
             m_faces.clear();
         }
+        
+        size_t BrushSnapshot::doGetMemoryUsage() const {
+            size_t result = sizeof(BrushSnapshot) + m_faces.capacity() * sizeof(BrushFace*);
+            for (const BrushFace* face : m_faces)
+                result += face->memoryUsage();
+            return result;
+        }
     }
 }
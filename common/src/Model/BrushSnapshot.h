@@ -40,6 +40,7 @@ namespace TrenchBroom {
         private:
             void takeSnapshot(Brush* brush);
             void doRestore(const BBox3& worldBounds);
+            size_t doGetMemoryUsage() const;
         };
     }
 }
@@ -71,6 +71,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyAttributeNameIssueQuickFix());
         }
         
+        bool EmptyAttributeNameIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void EmptyAttributeNameIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             if (node->hasAttribute(""))
                 issues.push_back(new EmptyAttributeNameIssue(node));
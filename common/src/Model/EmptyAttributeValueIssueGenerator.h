@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             EmptyAttributeValueIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(AttributableNode* node, IssueList& issues) const;
         };
     }
@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyBrushEntityIssueQuickFix());
         }
         
+        bool EmptyBrushEntityIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void EmptyBrushEntityIssueGenerator::doGenerate(Entity* entity, IssueList& issues) const {
             ensure(entity != NULL, "entity is null");
             const Assets::EntityDefinition* definition = entity->definition();
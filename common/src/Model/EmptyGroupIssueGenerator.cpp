@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new EmptyGroupIssueQuickFix());
         }
         
+        bool EmptyGroupIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void EmptyGroupIssueGenerator::doGenerate(Group* group, IssueList& issues) const {
             ensure(group != NULL, "group is null");
             if (!group->hasChildren())
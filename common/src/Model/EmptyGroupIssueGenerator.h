@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             EmptyGroupIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(Group* group, IssueList& issues) const;
         };
     }
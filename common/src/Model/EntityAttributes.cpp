@@ -22,6 +22,8 @@
 #include "Exceptions.h"
 #include "Assets/EntityDefinition.h"
 
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Model {
         const String AttributeEscapeChars = "\"\n\\";
@@ -159,7 +161,6 @@ namespace TrenchBroom {
         
         void EntityAttributes::setAttributes(const EntityAttribute::List& attributes) {
             m_attributes = attributes;
-            rebuildIndex();
         }
 
         const EntityAttribute& EntityAttributes::addOrUpdateAttribute(const AttributeName& name, const AttributeValue& value, const Assets::AttributeDefinition* definition) {
@@ -170,7 +171,6 @@ namespace TrenchBroom {
                 return *it;
             } else {
                 m_attributes.push_back(EntityAttribute(name, value, definition));
-                m_index.insert(name, --std::end(m_attributes));
                 return m_attributes.back();
             }
         }
@@ -188,7 +188,6 @@ namespace TrenchBroom {
             EntityAttribute::List::iterator it = findAttribute(name);
             if (it == std::end(m_attributes))
                 return;
-            m_index.remove(name, it);
             m_attributes.erase(it);
         }
 
@@ -212,33 +211,26 @@ namespace TrenchBroom {
         }
         
         bool EntityAttributes::hasAttributeWithPrefix(const AttributeName& prefix, const AttributeValue& value) const {
-            return containsValue(m_index.queryPrefixMatches(prefix), value);
+            for (const EntityAttribute& attribute : m_attributes) {
+                if (attribute.value() == value && StringUtils::isPrefix(attribute.name(), prefix))
+                    return true;
+            }
+            return false;
         }
         
         bool EntityAttributes::hasNumberedAttribute(const AttributeName& prefix, const AttributeValue& value) const {
-            return containsValue(m_index.queryNumberedMatches(prefix), value);
+            for (const EntityAttribute& attribute : m_attributes) {
+                if (attribute.value() == value && isNumberedAttribute(prefix, attribute.name()))
+                    return true;
+            }
+            return false;
         }
 
         EntityAttributeSnapshot EntityAttributes::snapshot(const AttributeName& name) const {
-            const AttributeIndex::QueryResult matches = m_index.queryExactMatches(name);
-            if (matches.empty())
+            const EntityAttribute::List::const_iterator it = findAttribute(name);
+            if (it == std::end(m_attributes))
                 return EntityAttributeSnapshot(name);
-            
-            assert(matches.size() == 1);
-            return EntityAttributeSnapshot(name, matches.front()->value());
-        }
-
-        bool EntityAttributes::containsValue(const AttributeIndex::QueryResult& matches, const AttributeValue& value) const {
-            if (matches.empty())
-                return false;
-            
-            for (auto attrIt : matches) {
-                const EntityAttribute& attribute = *attrIt;
-                if (attribute.value() == value)
-                    return true;
-            }
-            
-            return false;
+            return EntityAttributeSnapshot(name, it->value());
         }
 
         const AttributeNameSet EntityAttributes::names() const {
@@ -274,30 +266,13 @@ namespace TrenchBroom {
         }
 
         EntityAttribute::List::const_iterator EntityAttributes::findAttribute(const AttributeName& name) const {
-            const AttributeIndex::QueryResult matches = m_index.queryExactMatches(name);
-            if (matches.empty())
-                return std::end(m_attributes);
-            
-            assert(matches.size() == 1);
-            return matches.front();
+            return std::find_if(std::begin(m_attributes), std::end(m_attributes),
+                                [&name](const EntityAttribute& attribute) { return attribute.name() == name; });
         }
         
         EntityAttribute::List::iterator EntityAttributes::findAttribute(const AttributeName& name) {
-            const AttributeIndex::QueryResult matches = m_index.queryExactMatches(name);
-            if (matches.empty())
-                return std::end(m_attributes);
-            
-            assert(matches.size() == 1);
-            return matches.front();
-        }
-
-        void EntityAttributes::rebuildIndex() {
-            m_index.clear();
-            
-            for (auto it = std::begin(m_attributes), end = std::end(m_attributes); it != end; ++it) {
-                const EntityAttribute& attribute = *it;
-                m_index.insert(attribute.name(), it);
-            }
+            return std::find_if(std::begin(m_attributes), std::end(m_attributes),
+                                [&name](const EntityAttribute& attribute) { return attribute.name() == name; });
         }
     }
 }
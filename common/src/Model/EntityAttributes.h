@@ -21,12 +21,11 @@
 #define TrenchBroom_EntityProperties
 
 #include "StringUtils.h"
-#include "StringMap.h"
 #include "Model/EntityAttributeSnapshot.h"
 #include "Model/ModelTypes.h"
 
 #include <map>
-#include <list>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -77,7 +76,7 @@ namespace TrenchBroom {
         class EntityAttribute {
         public:
             typedef std::map<AttributableNode*, EntityAttribute> Map;
-            typedef std::list<EntityAttribute> List;
+            typedef std::vector<EntityAttribute> List;
             static const List EmptyList;
         private:
             AttributeName m_name;
@@ -102,14 +101,14 @@ namespace TrenchBroom {
         bool isWorldspawn(const String& classname, const EntityAttribute::List& attributes);
         const AttributeValue& findAttribute(const EntityAttribute::List& attributes, const AttributeName& name, const AttributeValue& defaultValue = EmptyString);
         
+        /**
+         The attributes of an entity. Entities only have a handful of attributes, so they are stored in a
+         flat array and searched linearly, which is faster and much smaller than maintaining an index for
+         every entity.
+         */
         class EntityAttributes {
         private:
             EntityAttribute::List m_attributes;
-            
-            typedef EntityAttribute::List::iterator IndexValue;
-            typedef StringMapValueContainer<IndexValue> IndexValueContainer;
-            typedef StringMap<IndexValue, IndexValueContainer> AttributeIndex;
-            AttributeIndex m_index;
         public:
             const EntityAttribute::List& attributes() const;
             void setAttributes(const EntityAttribute::List& attributes);
@@ -125,9 +124,8 @@ namespace TrenchBroom {
             bool hasNumberedAttribute(const AttributeName& prefix, const AttributeValue& value) const;
             
             EntityAttributeSnapshot snapshot(const AttributeName& name) const;
-        private:
-            bool containsValue(const AttributeIndex::QueryResult& matches, const AttributeValue& value) const;
-        public:
+            
+
             const AttributeNameSet names() const;
             const AttributeValue* attribute(const AttributeName& name) const;
             const AttributeValue& safeAttribute(const AttributeName& name, const AttributeValue& defaultValue) const;
@@ -136,8 +134,6 @@ namespace TrenchBroom {
         private:
             EntityAttribute::List::const_iterator findAttribute(const AttributeName& name) const;
             EntityAttribute::List::iterator findAttribute(const AttributeName& name);
-            
-            void rebuildIndex();
         };
     }
 }
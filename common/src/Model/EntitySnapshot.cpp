@@ -48,5 +48,11 @@ namespace TrenchBroom {
             restoreAttribute(m_entity, m_origin);
             restoreAttribute(m_entity, m_rotation);
         }
+        
+        size_t EntitySnapshot::doGetMemoryUsage() const {
+            return (sizeof(EntitySnapshot) +
+                    m_origin.name().size() + m_origin.value().size() +
+                    m_rotation.name().size() + m_rotation.value().size());
+        }
     }
 }
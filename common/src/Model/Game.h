@@ -41,6 +41,10 @@ namespace TrenchBroom {
         class TextureManager;
     }
     
+    namespace IO {
+        class ParserStatus;
+    }
+    
     namespace Model {
         class BrushContentTypeBuilder;
         
@@ -72,7 +76,7 @@ namespace TrenchBroom {
             size_t maxPropertyLength() const;
         public: // loading and writing map files
             World* newMap(MapFormat::Type format, const BBox3& worldBounds) const;
-            World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            World* loadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status, Logger* logger) const;
             void writeMap(World* world, const IO::Path& path) const;
             void exportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
         public: // parsing and serializing objects
@@ -114,7 +118,7 @@ namespace TrenchBroom {
             virtual size_t doMaxPropertyLength() const = 0;
             
             virtual World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const = 0;
-            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const = 0;
+            virtual World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status, Logger* logger) const = 0;
             virtual void doWriteMap(World* world, const IO::Path& path) const = 0;
             virtual void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const = 0;
             
@@ -20,6 +20,8 @@
 #include "GameImpl.h"
 
 #include "Macros.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "Assets/Palette.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/Bsp29Parser.h"
@@ -32,6 +34,7 @@
 #include "IO/IdPakFileSystem.h"
 #include "IO/IdWalTextureReader.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MapParser.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
@@ -145,11 +148,51 @@ namespace TrenchBroom {
             return new World(format, brushContentTypeBuilder(), worldBounds);
         }
 
-        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const {
-            IO::SimpleParserStatus parserStatus(logger);
-            const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
+        World* GameImpl::doLoadMap(const MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status, Logger* logger) const {
+            const IO::Path mapPath = IO::Disk::fixPath(path);
+            const IO::MappedFile::Ptr file = IO::Disk::openFile(mapPath);
+            
+            if (!PreferenceManager::instance().get(Preferences::UseMapCache)) {
+                IO::WorldReader reader(file->begin(), file->end(), brushContentTypeBuilder());
+                return reader.read(format, worldBounds, status);
+            }
+            
+            // Restoring the world from an up to date cache skips parsing the map and building the brush geometry.
+            const IO::MapCache cache(file->begin(), file->end());
+            const IO::Path cacheDirectory = IO::SystemPaths::userDataDirectory() + IO::Path("Map cache");
+            const IO::Path cachePath = IO::MapCache::cachePath(cacheDirectory, mapPath);
+            try {
+                if (IO::Disk::fileExists(cachePath)) {
+                    const IO::MappedFile::Ptr cacheFile = IO::Disk::openFile(cachePath);
+                    World* world = cache.read(cacheFile->begin(), cacheFile->end(), format, worldBounds, brushContentTypeBuilder(), status);
+                    if (world != NULL)
+                        return world;
+                }
+            } catch (const FileSystemException&) {}
+            
             IO::WorldReader reader(file->begin(), file->end(), brushContentTypeBuilder());
-            return reader.read(format, worldBounds, parserStatus);
+            World* world = reader.read(format, worldBounds, status);
+            
+            try {
+                writeMapCache(cache, world, worldBounds, cachePath);
+            } catch (const FileSystemException& e) {
+                if (logger != NULL)
+                    logger->debug("Unable to write map cache '" + cachePath.asString() + "': " + String(e.what()));
+            }
+            return world;
+        }
+
+        void GameImpl::writeMapCache(const IO::MapCache& cache, const World* world, const BBox3& worldBounds, const IO::Path& cachePath) const {
+            try {
+                IO::Disk::ensureDirectoryExists(cachePath.deleteLastComponent());
+                IO::OpenFile open(cachePath, true, true);
+                cache.write(world, worldBounds, open.file);
+            } catch (const FileSystemException&) {
+                // a truncated cache would only be rejected when the map is loaded again
+                if (IO::Disk::fileExists(cachePath))
+                    IO::Disk::deleteFile(cachePath);
+                throw;
+            }
         }
 
         void GameImpl::doWriteMap(World* world, const IO::Path& path) const {
@@ -33,6 +33,10 @@
 namespace TrenchBroom {
     class Logger;
     
+    namespace IO {
+        class MapCache;
+    }
+    
     namespace Model {
         class GameImpl : public Game {
         private:
@@ -59,7 +63,8 @@ namespace TrenchBroom {
             size_t doMaxPropertyLength() const;
 
             World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const;
-            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status, Logger* logger) const;
+            void writeMapCache(const IO::MapCache& cache, const World* world, const BBox3& worldBounds, const IO::Path& cachePath) const;
             void doWriteMap(World* world, const IO::Path& path) const;
             void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
 
@@ -24,6 +24,7 @@
 #include "Model/EditorContext.h"
 #include "Model/Node.h"
 
+#include <atomic>
 #include <cassert>
 
 namespace TrenchBroom {
@@ -79,6 +80,10 @@ namespace TrenchBroom {
         void Issue::setHidden(const bool hidden) {
             m_node->setIssueHidden(type(), hidden);
         }
+        
+        void Issue::renumber() {
+            m_seqId = nextSeqId();
+        }
 
         Issue::Issue(Node* node) :
         m_seqId(nextSeqId()),
@@ -87,7 +92,7 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            static std::atomic<size_t> seqId(0);
             return seqId++;
         }
 
@@ -47,6 +47,9 @@ namespace TrenchBroom {
             
             bool hidden() const;
             void setHidden(bool hidden);
+            
+            // makes this the most recent issue
+            void renumber();
         protected:
             Issue(Node* node);
             static size_t nextSeqId();
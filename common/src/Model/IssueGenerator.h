@@ -36,6 +36,9 @@ namespace TrenchBroom {
             const String& description() const;
             const IssueQuickFixList& quickFixes() const;
             
+            // whether this generator may be run on different nodes at the same time, false unless overridden
+            bool threadSafe() const;
+            
             void generate(World* world,   IssueList& issues) const;
             void generate(Layer* layer,   IssueList& issues) const;
             void generate(Group* group,   IssueList& issues) const;
@@ -45,6 +48,8 @@ namespace TrenchBroom {
             IssueGenerator(IssueType type, const String& description);
             void addQuickFix(IssueQuickFix* quickFix);
         private:
+            virtual bool doIsThreadSafe() const;
+            
             virtual void doGenerate(World* world,           IssueList& issues) const;
             virtual void doGenerate(Layer* layer,           IssueList& issues) const;
             virtual void doGenerate(Group* group,           IssueList& issues) const;
@@ -0,0 +1,260 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueTracker.h"
+
+#include "CollectionUtils.h"
+#include "Model/AttributableNode.h"
+#include "Model/Brush.h"
+#include "Model/CollectNodesVisitor.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/Layer.h"
+#include "Model/NodeVisitor.h"
+#include "Model/World.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+namespace TrenchBroom {
+    namespace Model {
+        /*
+         A change to a node invalidates the issues of its ancestors and of the nodes it is linked to. Changes
+         to groups and entities are usually applied to their children, too, but changes to the world or to a
+         layer don't affect their children.
+         */
+        class IssueTracker::CollectDirtyNodesVisitor : public NodeVisitor {
+        private:
+            IssueTracker& m_tracker;
+        public:
+            CollectDirtyNodesVisitor(IssueTracker& tracker) :
+            m_tracker(tracker) {}
+        private:
+            void doVisit(World* world)   { addNode(world); addLinkedNodes(world); }
+            void doVisit(Layer* layer)   { addNode(layer); }
+            void doVisit(Group* group)   { addNode(group); group->recurse(*this); }
+            void doVisit(Entity* entity) { addNode(entity); addLinkedNodes(entity); entity->recurse(*this); }
+            void doVisit(Brush* brush)   { addNode(brush); }
+            
+            void addNode(Node* node) {
+                m_tracker.addDirtyNode(node);
+            }
+            
+            void addLinkedNodes(AttributableNode* node) {
+                addNodes(node->linkSources());
+                addNodes(node->linkTargets());
+                addNodes(node->killSources());
+                addNodes(node->killTargets());
+            }
+            
+            void addNodes(const AttributableNodeList& nodes) {
+                m_tracker.addDirtyNodes(std::begin(nodes), std::end(nodes));
+            }
+        };
+        
+        class IssueTracker::CollectRemovedNodesVisitor : public NodeVisitor {
+        private:
+            IssueTracker& m_tracker;
+        public:
+            CollectRemovedNodesVisitor(IssueTracker& tracker) :
+            m_tracker(tracker) {}
+        private:
+            void doVisit(World* world)   { removeNode(world);  }
+            void doVisit(Layer* layer)   { removeNode(layer);  }
+            void doVisit(Group* group)   { removeNode(group);  }
+            void doVisit(Entity* entity) { removeNode(entity); }
+            void doVisit(Brush* brush)   { removeNode(brush);  }
+            
+            void removeNode(Node* node) {
+                // the node stays in the queue and is skipped when it is dequeued
+                m_tracker.m_dirtyNodes.erase(node);
+                m_tracker.m_nodeIssues.erase(node);
+            }
+        };
+
+        IssueTracker::IssueTracker() :
+        m_maxWorkers(std::max(1u, std::thread::hardware_concurrency())) {}
+
+        IssueTracker::IssueTracker(const size_t maxWorkers) :
+        m_maxWorkers(std::max(static_cast<size_t>(1), maxWorkers)) {}
+
+        void IssueTracker::reset(World* world) {
+            m_dirtyNodeQueue.clear();
+            m_dirtyNodes.clear();
+            m_nodeIssues.clear();
+            
+            if (world != NULL) {
+                CollectNodesVisitor visitor;
+                world->acceptAndRecurse(visitor);
+                
+                const NodeList& nodes = visitor.nodes();
+                addDirtyNodes(std::begin(nodes), std::end(nodes));
+            }
+        }
+
+        void IssueTracker::invalidateNodes(const NodeList& nodes) {
+            CollectDirtyNodesVisitor visitor(*this);
+            for (Node* node : nodes) {
+                node->accept(visitor);
+                
+                Node* parent = node->parent();
+                while (parent != NULL) {
+                    addDirtyNode(parent);
+                    parent = parent->parent();
+                }
+            }
+        }
+        
+        void IssueTracker::removeNodes(const NodeList& nodes) {
+            CollectRemovedNodesVisitor visitor(*this);
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+        }
+
+        bool IssueTracker::hasDirtyNodes() const {
+            return !m_dirtyNodes.empty();
+        }
+
+        bool IssueTracker::update(const IssueGeneratorList& issueGenerators, const size_t maxNodes) {
+            NodeList nodes;
+            nodes.reserve(std::min(maxNodes, m_dirtyNodes.size()));
+            
+            size_t dequeued = 0;
+            while (dequeued < m_dirtyNodeQueue.size() && nodes.size() < maxNodes) {
+                Node* node = m_dirtyNodeQueue[dequeued++];
+                if (m_dirtyNodes.erase(node) > 0)
+                    nodes.push_back(node);
+            }
+            
+            if (m_dirtyNodes.empty())
+                m_dirtyNodeQueue.clear();
+            else
+                m_dirtyNodeQueue.erase(std::begin(m_dirtyNodeQueue), std::begin(m_dirtyNodeQueue) + static_cast<NodeList::difference_type>(dequeued));
+            
+            updateNodes(nodes, issueGenerators);
+            
+            if (!m_dirtyNodes.empty())
+                return false;
+            
+            // Some changes invalidate the issues of nodes without any notification, e.g. when a link is removed.
+            // Revalidating nodes which are still valid is cheap, so we make sure that we don't hand out any stale
+            // issues here.
+            const NodeList nodesWithIssues = MapUtils::keyList(m_nodeIssues);
+            for (Node* node : nodesWithIssues)
+                updateNode(node, issueGenerators);
+            return true;
+        }
+
+        IssueList IssueTracker::issues() const {
+            IssueList result;
+            for (const auto& entry : m_nodeIssues)
+                VectorUtils::append(result, entry.second);
+            return result;
+        }
+
+        void IssueTracker::addDirtyNode(Node* node) {
+            if (m_dirtyNodes.insert(node).second)
+                m_dirtyNodeQueue.push_back(node);
+        }
+
+        void IssueTracker::updateNodes(const NodeList& nodes, const IssueGeneratorList& issueGenerators) {
+            NodeList invalidNodes;
+            for (Node* node : nodes) {
+                if (node->issuesValid())
+                    updateNode(node, issueGenerators);
+                else
+                    invalidNodes.push_back(node);
+            }
+            
+            const size_t workerCount = std::min(m_maxWorkers, invalidNodes.size() / MinNodesPerWorker);
+            if (workerCount > 1) {
+                updateNodesConcurrently(invalidNodes, issueGenerators, workerCount);
+            } else {
+                for (Node* node : invalidNodes)
+                    updateNode(node, issueGenerators);
+            }
+        }
+
+        void IssueTracker::updateNodesConcurrently(const NodeList& nodes, const IssueGeneratorList& issueGenerators, const size_t workerCount) {
+            IssueGeneratorList concurrentGenerators, sequentialGenerators;
+            for (IssueGenerator* generator : issueGenerators) {
+                if (generator->threadSafe())
+                    concurrentGenerators.push_back(generator);
+                else
+                    sequentialGenerators.push_back(generator);
+            }
+            
+            // every worker handles a contiguous range of nodes and only writes to the issue lists of that range
+            std::vector<IssueList> concurrentIssues(nodes.size());
+            std::vector<std::exception_ptr> errors(workerCount);
+            std::vector<std::thread> workers;
+            workers.reserve(workerCount);
+            
+            const size_t rangeSize = (nodes.size() + workerCount - 1) / workerCount;
+            for (size_t i = 0; i < workerCount; ++i) {
+                const size_t first = std::min(i * rangeSize, nodes.size());
+                const size_t last = std::min(first + rangeSize, nodes.size());
+                workers.push_back(std::thread([&nodes, &concurrentGenerators, &concurrentIssues, &errors, i, first, last]() {
+                    try {
+                        for (size_t j = first; j < last; ++j)
+                            concurrentIssues[j] = nodes[j]->generateIssues(concurrentGenerators);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                }));
+            }
+            
+            for (std::thread& worker : workers)
+                worker.join();
+            
+            for (const std::exception_ptr& error : errors) {
+                if (error) {
+                    for (IssueList& issues : concurrentIssues)
+                        VectorUtils::clearAndDelete(issues);
+                    addDirtyNodes(std::begin(nodes), std::end(nodes));
+                    std::rethrow_exception(error);
+                }
+            }
+            
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                Node* node = nodes[i];
+                
+                IssueList issues = concurrentIssues[i];
+                VectorUtils::append(issues, node->generateIssues(sequentialGenerators));
+                
+                // number the issues as if they had been generated one node after the other
+                for (Issue* issue : issues)
+                    issue->renumber();
+                
+                node->setIssues(issues);
+                updateNode(node, issueGenerators);
+            }
+        }
+
+        void IssueTracker::updateNode(Node* node, const IssueGeneratorList& issueGenerators) {
+            const IssueList& issues = node->issues(issueGenerators);
+            if (issues.empty())
+                m_nodeIssues.erase(node);
+            else
+                m_nodeIssues[node] = issues;
+        }
+    }
+}
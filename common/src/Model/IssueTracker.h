@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_IssueTracker
+#define TrenchBroom_IssueTracker
+
+#include "Model/ModelTypes.h"
+
+#include <map>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         Keeps track of the issues of all nodes of a world and only revalidates those nodes that were
+         affected by a change. Changes are reported through the invalidateNodes and removeNodes functions,
+         and the nodes affected by them are queued until they are revalidated by calling update. Nodes are
+         revalidated in the order in which they were queued, which is document order after a reset.
+         
+         Large batches of nodes are validated on several threads. Only generators that are thread safe are
+         run concurrently, and the resulting issues are merged in the order of the nodes so that the result
+         doesn't depend on the scheduling of the threads.
+         */
+        class IssueTracker {
+        private:
+            typedef std::map<Node*, IssueList> NodeIssueMap;
+            
+            static const size_t MinNodesPerWorker = 512;
+            
+            class CollectDirtyNodesVisitor;
+            class CollectRemovedNodesVisitor;
+            
+            size_t m_maxWorkers;
+            NodeList m_dirtyNodeQueue;
+            NodeSet m_dirtyNodes;
+            NodeIssueMap m_nodeIssues;
+        public:
+            IssueTracker();
+            IssueTracker(size_t maxWorkers);
+            
+            void reset(World* world);
+            
+            void invalidateNodes(const NodeList& nodes);
+            void removeNodes(const NodeList& nodes);
+            
+            bool hasDirtyNodes() const;
+            bool update(const IssueGeneratorList& issueGenerators, size_t maxNodes);
+            
+            IssueList issues() const;
+        private:
+            void addDirtyNode(Node* node);
+            template <typename I>
+            void addDirtyNodes(I cur, I end) {
+                while (cur != end)
+                    addDirtyNode(*cur++);
+            }
+            
+            void updateNodes(const NodeList& nodes, const IssueGeneratorList& issueGenerators);
+            void updateNodesConcurrently(const NodeList& nodes, const IssueGeneratorList& issueGenerators, size_t workerCount);
+            void updateNode(Node* node, const IssueGeneratorList& issueGenerators);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_IssueTracker) */
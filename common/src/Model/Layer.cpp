@@ -29,12 +29,84 @@ namespace TrenchBroom {
     namespace Model {
         Layer::Layer(const String& name, const BBox3& worldBounds) :
         m_name(name),
-        m_octree(worldBounds, static_cast<FloatType>(64.0f)) {}
+        m_octree(worldBounds, static_cast<FloatType>(64.0f)),
+        m_xQuadtree(project(worldBounds, Math::Axis::AX), static_cast<FloatType>(64.0f)),
+        m_yQuadtree(project(worldBounds, Math::Axis::AY), static_cast<FloatType>(64.0f)),
+        m_zQuadtree(project(worldBounds, Math::Axis::AZ), static_cast<FloatType>(64.0f)) {}
         
         void Layer::setName(const String& name) {
             m_name = name;
         }
 
+        NodeList Layer::findNodesIntersecting(const BBox3& bounds) const {
+            NodeList result;
+            for (Node* node : m_octree.findObjects(bounds)) {
+                if (node->bounds().intersects(bounds))
+                    result.push_back(node);
+            }
+            return result;
+        }
+
+        NodeList Layer::findNodesIntersecting(const BBox3& bounds, const Math::Axis::Type axis) const {
+            const BBox2 projectedBounds = project(bounds, axis);
+            
+            NodeList result;
+            for (Node* node : quadtree(axis).findObjects(projectedBounds)) {
+                if (project(node->bounds(), axis).intersects(projectedBounds))
+                    result.push_back(node);
+            }
+            return result;
+        }
+
+        const Layer::ProjectedNodeTree& Layer::quadtree(const Math::Axis::Type axis) const {
+            switch (axis) {
+                case Math::Axis::AX:
+                    return m_xQuadtree;
+                case Math::Axis::AY:
+                    return m_yQuadtree;
+                default:
+                    return m_zQuadtree;
+            }
+        }
+        
+        BBox2 Layer::project(const BBox3& bounds, const Math::Axis::Type axis) {
+            return BBox2(project(bounds.min, axis), project(bounds.max, axis));
+        }
+        
+        Vec2 Layer::project(const Vec3& point, const Math::Axis::Type axis) {
+            switch (axis) {
+                case Math::Axis::AX:
+                    return point.yz();
+                case Math::Axis::AY:
+                    return point.xz();
+                default:
+                    return point.xy();
+            }
+        }
+        
+        void Layer::addNodeToTrees(Node* node) {
+            const BBox3& bounds = node->bounds();
+            m_octree.addObject(bounds, node);
+            m_xQuadtree.addObject(project(bounds, Math::Axis::AX), node);
+            m_yQuadtree.addObject(project(bounds, Math::Axis::AY), node);
+            m_zQuadtree.addObject(project(bounds, Math::Axis::AZ), node);
+        }
+        
+        void Layer::removeNodeFromTrees(Node* node) {
+            m_octree.removeObject(node);
+            m_xQuadtree.removeObject(node);
+            m_yQuadtree.removeObject(node);
+            m_zQuadtree.removeObject(node);
+        }
+        
+        void Layer::updateNodeInTrees(Node* node) {
+            const BBox3& bounds = node->bounds();
+            m_octree.updateObject(bounds, node);
+            m_xQuadtree.updateObject(project(bounds, Math::Axis::AX), node);
+            m_yQuadtree.updateObject(project(bounds, Math::Axis::AY), node);
+            m_zQuadtree.updateObject(project(bounds, Math::Axis::AZ), node);
+        }
+
         const String& Layer::doGetName() const {
             return m_name;
         }
@@ -73,60 +145,60 @@ namespace TrenchBroom {
             return false;
         }
 
-        class Layer::AddNodeToOctree : public NodeVisitor {
+        class Layer::AddNodeToTrees : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            Layer& m_layer;
         public:
-            AddNodeToOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            AddNodeToTrees(Layer& layer) :
+            m_layer(layer) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.addObject(group->bounds(), group); }
-            void doVisit(Entity* entity) { m_octree.addObject(entity->bounds(), entity); }
-            void doVisit(Brush* brush)   { m_octree.addObject(brush->bounds(), brush); }
+            void doVisit(Group* group)   { m_layer.addNodeToTrees(group); }
+            void doVisit(Entity* entity) { m_layer.addNodeToTrees(entity); }
+            void doVisit(Brush* brush)   { m_layer.addNodeToTrees(brush); }
         };
         
-        class Layer::RemoveNodeFromOctree : public NodeVisitor {
+        class Layer::RemoveNodeFromTrees : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            Layer& m_layer;
         public:
-            RemoveNodeFromOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            RemoveNodeFromTrees(Layer& layer) :
+            m_layer(layer) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.removeObject(group); }
-            void doVisit(Entity* entity) { m_octree.removeObject(entity); }
-            void doVisit(Brush* brush)   { m_octree.removeObject(brush); }
+            void doVisit(Group* group)   { m_layer.removeNodeFromTrees(group); }
+            void doVisit(Entity* entity) { m_layer.removeNodeFromTrees(entity); }
+            void doVisit(Brush* brush)   { m_layer.removeNodeFromTrees(brush); }
         };
         
-        class Layer::UpdateNodeInOctree : public NodeVisitor {
+        class Layer::UpdateNodeInTrees : public NodeVisitor {
         private:
-            NodeTree& m_octree;
+            Layer& m_layer;
         public:
-            UpdateNodeInOctree(NodeTree& octree) :
-            m_octree(octree) {}
+            UpdateNodeInTrees(Layer& layer) :
+            m_layer(layer) {}
         private:
             void doVisit(World* world)   {}
             void doVisit(Layer* layer)   {}
-            void doVisit(Group* group)   { m_octree.updateObject(group->bounds(), group); }
-            void doVisit(Entity* entity) { m_octree.updateObject(entity->bounds(), entity); }
-            void doVisit(Brush* brush)   { m_octree.updateObject(brush->bounds(), brush); }
+            void doVisit(Group* group)   { m_layer.updateNodeInTrees(group); }
+            void doVisit(Entity* entity) { m_layer.updateNodeInTrees(entity); }
+            void doVisit(Brush* brush)   { m_layer.updateNodeInTrees(brush); }
         };
 
         void Layer::doChildWasAdded(Node* node) {
-            AddNodeToOctree visitor(m_octree);
+            AddNodeToTrees visitor(*this);
             node->accept(visitor);
         }
         
         void Layer::doChildWillBeRemoved(Node* node) {
-            RemoveNodeFromOctree visitor(m_octree);
+            RemoveNodeFromTrees visitor(*this);
             node->accept(visitor);
         }
         
         void Layer::doChildBoundsDidChange(Node* node) {
-            UpdateNodeInOctree visitor(m_octree);
+            UpdateNodeInTrees visitor(*this);
             node->accept(visitor);
         }
 
@@ -147,8 +219,16 @@ namespace TrenchBroom {
         }
 
         void Layer::doPick(const Ray3& ray, PickResult& pickResult) const {
-            for (const Node* node : m_octree.findObjects(ray))
-                node->pick(ray, pickResult);
+            // rays along a coordinate axis, such as the pick rays of the 2D views, can only hit nodes whose
+            // projected bounds contain the projected ray origin
+            const Math::Axis::Type axis = ray.direction.firstComponent();
+            if (ray.direction.equals(ray.direction.firstAxis())) {
+                for (const Node* node : quadtree(axis).findObjects(project(ray.origin, axis)))
+                    node->pick(ray, pickResult);
+            } else {
+                for (const Node* node : m_octree.findObjects(ray))
+                    node->pick(ray, pickResult);
+            }
         }
         
         void Layer::doFindNodesContaining(const Vec3& point, NodeList& result) {
@@ -24,6 +24,7 @@
 #include "Model/ModelTypes.h"
 #include "Model/Node.h"
 #include "Model/Octree.h"
+#include "Model/Quadtree.h"
 
 namespace TrenchBroom {
     namespace Model {
@@ -33,10 +34,30 @@ namespace TrenchBroom {
             
             typedef Octree<FloatType, Node*> NodeTree;
             NodeTree m_octree;
+            
+            // the bounds of the nodes projected along the x, y and z axes, for queries along these axes
+            typedef Quadtree<FloatType, Node*> ProjectedNodeTree;
+            ProjectedNodeTree m_xQuadtree;
+            ProjectedNodeTree m_yQuadtree;
+            ProjectedNodeTree m_zQuadtree;
         public:
             Layer(const String& name, const BBox3& worldBounds);
             
             void setName(const String& name);
+
+            NodeList findNodesIntersecting(const BBox3& bounds) const;
+            /**
+             Returns the nodes whose bounds intersect the given bounds if both are projected along the given axis.
+             */
+            NodeList findNodesIntersecting(const BBox3& bounds, Math::Axis::Type axis) const;
+        private:
+            const ProjectedNodeTree& quadtree(Math::Axis::Type axis) const;
+            static BBox2 project(const BBox3& bounds, Math::Axis::Type axis);
+            static Vec2 project(const Vec3& point, Math::Axis::Type axis);
+            
+            void addNodeToTrees(Node* node);
+            void removeNodeFromTrees(Node* node);
+            void updateNodeInTrees(Node* node);
         private: // implement Node interface
             const String& doGetName() const;
             const BBox3& doGetBounds() const;
@@ -46,9 +67,9 @@ namespace TrenchBroom {
             bool doCanRemoveChild(const Node* child) const;
             bool doRemoveIfEmpty() const;
             
-            class AddNodeToOctree;
-            class RemoveNodeFromOctree;
-            class UpdateNodeInOctree;
+            class AddNodeToTrees;
+            class RemoveNodeFromTrees;
+            class UpdateNodeInTrees;
             
             void doChildWasAdded(Node* node);
             void doChildWillBeRemoved(Node* node);
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             LinkTargetIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(AttributableNode* node, IssueList& issues) const;
             void processKeys(AttributableNode* node, const Model::AttributeNameList& names, IssueList& issues) const;
         };
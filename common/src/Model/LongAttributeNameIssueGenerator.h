@@ -33,6 +33,7 @@ namespace TrenchBroom {
         public:
             LongAttributeNameIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(AttributableNode* node, IssueList& issues) const;
         };
     }
@@ -34,6 +34,7 @@ namespace TrenchBroom {
         public:
             LongAttributeValueIssueGenerator(size_t maxLength);
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(AttributableNode* node, IssueList& issues) const;
         };
     }
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MeasureMemoryUsageVisitor.h"
+
+#include "MemoryUsage.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Issue.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        MeasureMemoryUsageVisitor::MeasureMemoryUsageVisitor(MemoryUsage& usage) :
+        m_usage(usage) {}
+        
+        void MeasureMemoryUsageVisitor::doVisit(const World* world) {
+            m_usage.add("World", 1, sizeof(World));
+            measureAttributes(world);
+            measureIssues(world);
+        }
+        
+        void MeasureMemoryUsageVisitor::doVisit(const Layer* layer) {
+            m_usage.add("Layers", 1, sizeof(Layer));
+            measureIssues(layer);
+        }
+        
+        void MeasureMemoryUsageVisitor::doVisit(const Group* group) {
+            m_usage.add("Groups", 1, sizeof(Group));
+            measureIssues(group);
+        }
+        
+        void MeasureMemoryUsageVisitor::doVisit(const Entity* entity) {
+            m_usage.add("Entities", 1, sizeof(Entity));
+            measureAttributes(entity);
+            measureIssues(entity);
+        }
+        
+        void MeasureMemoryUsageVisitor::doVisit(const Brush* brush) {
+            m_usage.add("Brushes", 1, sizeof(Brush));
+            
+            size_t faceBytes = 0;
+            for (const BrushFace* face : brush->faces())
+                faceBytes += face->memoryUsage();
+            m_usage.add("Brush faces", brush->faceCount(), faceBytes);
+            
+            // every edge consists of two half edges, and every face of the geometry belongs to a brush face
+            m_usage.add("Brush geometry", 1, sizeof(BrushGeometry));
+            m_usage.add("Brush geometry vertices", brush->vertexCount(), brush->vertexCount() * sizeof(BrushVertex));
+            m_usage.add("Brush geometry edges", brush->edgeCount(), brush->edgeCount() * sizeof(BrushEdge));
+            m_usage.add("Brush geometry half edges", 2 * brush->edgeCount(), 2 * brush->edgeCount() * sizeof(BrushHalfEdge));
+            m_usage.add("Brush geometry faces", brush->faceCount(), brush->faceCount() * sizeof(BrushFaceGeometry));
+            
+            measureIssues(brush);
+        }
+        
+        void MeasureMemoryUsageVisitor::measureAttributes(const AttributableNode* node) {
+            const EntityAttribute::List& attributes = node->attributes();
+            
+            // the attributes are stored in a vector, which may have reserved room for more attributes
+            size_t bytes = attributes.capacity() * sizeof(EntityAttribute);
+            for (const EntityAttribute& attribute : attributes)
+                bytes += attribute.name().size() + attribute.value().size();
+            m_usage.add("Entity attributes", attributes.size(), bytes);
+        }
+        
+        void MeasureMemoryUsageVisitor::measureIssues(const Node* node) {
+            const size_t count = node->cachedIssueCount();
+            if (count > 0)
+                m_usage.add("Issues", count, count * sizeof(Issue));
+        }
+        
+        void measureMemoryUsage(const World* world, MemoryUsage& usage) {
+            MeasureMemoryUsageVisitor visitor(usage);
+            world->acceptAndRecurse(visitor);
+        }
+    }
+}
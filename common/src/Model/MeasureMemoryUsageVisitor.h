@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_MeasureMemoryUsageVisitor
+#define TrenchBroom_MeasureMemoryUsageVisitor
+
+#include "Model/NodeVisitor.h"
+
+namespace TrenchBroom {
+    class MemoryUsage;
+    
+    namespace Model {
+        class AttributableNode;
+        class Node;
+        class World;
+        
+        /**
+         Adds the approximate memory used by the visited nodes, their brush faces and geometry, their
+         entity attributes and their cached issues to the given memory usage report.
+         */
+        class MeasureMemoryUsageVisitor : public ConstNodeVisitor {
+        private:
+            MemoryUsage& m_usage;
+        public:
+            MeasureMemoryUsageVisitor(MemoryUsage& usage);
+        private:
+            void doVisit(const World* world);
+            void doVisit(const Layer* layer);
+            void doVisit(const Group* group);
+            void doVisit(const Entity* entity);
+            void doVisit(const Brush* brush);
+            
+            void measureAttributes(const AttributableNode* node);
+            void measureIssues(const Node* node);
+        };
+        
+        void measureMemoryUsage(const World* world, MemoryUsage& usage);
+    }
+}
+
+#endif /* defined(TrenchBroom_MeasureMemoryUsageVisitor) */
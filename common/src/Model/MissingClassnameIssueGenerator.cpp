@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new MissingClassnameIssueQuickFix());
         }
         
+        bool MissingClassnameIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void MissingClassnameIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             if (!node->hasAttribute(AttributeNames::Classname))
                 issues.push_back(new MissingClassnameIssue(node));
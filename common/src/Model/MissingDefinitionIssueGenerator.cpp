@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new MissingDefinitionIssueQuickFix());
         }
         
+        bool MissingDefinitionIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void MissingDefinitionIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             if (node->definition() == NULL)
                 issues.push_back(new MissingDefinitionIssue(node));
@@ -52,6 +52,10 @@ namespace TrenchBroom {
         MixedBrushContentsIssueGenerator::MixedBrushContentsIssueGenerator() :
         IssueGenerator(MixedBrushContentsIssue::Type, "Mixed brush content flags") {}
         
+        bool MixedBrushContentsIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void MixedBrushContentsIssueGenerator::doGenerate(Brush* brush, IssueList& issues) const {
             const BrushFaceList& faces = brush->faces();
             BrushFaceList::const_iterator it = std::begin(faces);
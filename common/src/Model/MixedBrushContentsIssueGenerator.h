@@ -31,6 +31,7 @@ namespace TrenchBroom {
         public:
             MixedBrushContentsIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(Brush* brush, IssueList& issues) const;
         };
     }
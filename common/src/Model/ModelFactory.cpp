@@ -47,6 +47,10 @@ namespace TrenchBroom {
             return doCreateBrush(worldBounds, faces);
         }
         
+        Brush* ModelFactory::createBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const {
+            return doCreateBrush(worldBounds, faces, positions, faceSizes, faceIndices);
+        }
+        
         BrushFace* ModelFactory::createFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const {
             return doCreateFace(point1, point2, point3, attribs);
         }
@@ -37,6 +37,7 @@ namespace TrenchBroom {
             Group* createGroup(const String& name) const;
             Entity* createEntity() const;
             Brush* createBrush(const BBox3& worldBounds, const BrushFaceList& faces) const;
+            Brush* createBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const;
             
             BrushFace* createFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const;
             BrushFace* createFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs, const Vec3& texAxisX, const Vec3& texAxisY) const;
@@ -47,6 +48,7 @@ namespace TrenchBroom {
             virtual Group* doCreateGroup(const String& name) const = 0;
             virtual Entity* doCreateEntity() const = 0;
             virtual Brush* doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces) const = 0;
+            virtual Brush* doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const = 0;
             virtual BrushFace* doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const = 0;
             virtual BrushFace* doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs, const Vec3& texAxisX, const Vec3& texAxisY) const = 0;
         };
@@ -74,6 +74,13 @@ namespace TrenchBroom {
             return brush;
         }
 
+        Brush* ModelFactoryImpl::doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const {
+            assert(m_format != MapFormat::Unknown);
+            Brush* brush = new Brush(worldBounds, faces, positions, faceSizes, faceIndices);
+            brush->setContentTypeBuilder(m_brushContentTypeBuilder);
+            return brush;
+        }
+
         BrushFace* ModelFactoryImpl::doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const {
             assert(m_format != MapFormat::Unknown);
             switch (m_format) {
@@ -539,6 +539,10 @@ namespace TrenchBroom {
             return m_lineNumber;
         }
 
+        size_t Node::lineCount() const {
+            return m_lineCount;
+        }
+
         void Node::setFilePosition(const size_t lineNumber, const size_t lineCount) {
             m_lineNumber = lineNumber;
             m_lineCount = lineCount;
@@ -553,6 +557,26 @@ namespace TrenchBroom {
             return m_issues;
         }
         
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+        
+        size_t Node::cachedIssueCount() const {
+            return m_issuesValid ? m_issues.size() : 0;
+        }
+
+        IssueList Node::generateIssues(const IssueGeneratorList& issueGenerators) {
+            IssueList result;
+            std::for_each(std::begin(issueGenerators), std::end(issueGenerators), [this, &result](const IssueGenerator* generator) { doGenerateIssues(generator, result); });
+            return result;
+        }
+        
+        void Node::setIssues(const IssueList& issues) {
+            clearIssues();
+            m_issues = issues;
+            m_issuesValid = true;
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
@@ -565,10 +589,8 @@ namespace TrenchBroom {
         }
 
         void Node::validateIssues(const IssueGeneratorList& issueGenerators) {
-            if (!m_issuesValid) {
-                std::for_each(std::begin(issueGenerators), std::end(issueGenerators), [this](const IssueGenerator* generator) { doGenerateIssues(generator, m_issues); });
-                m_issuesValid = true;
-            }
+            if (!m_issuesValid)
+                setIssues(generateIssues(issueGenerators));
         }
         
         void Node::invalidateIssues() const {
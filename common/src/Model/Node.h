@@ -238,10 +238,19 @@ namespace TrenchBroom {
             FloatType intersectWithRay(const Ray3& ray) const;
         public: // file position
             size_t lineNumber() const;
+            size_t lineCount() const;
             void setFilePosition(size_t lineNumber, size_t lineCount);
             bool containsLine(size_t lineNumber) const;
         public: // issue management
             const IssueList& issues(const IssueGeneratorList& issueGenerators);
+            bool issuesValid() const;
+            // the number of currently cached issues, does not validate the issues
+            size_t cachedIssueCount() const;
+            
+            // generates issues without caching them, the caller takes ownership of the returned issues
+            IssueList generateIssues(const IssueGeneratorList& issueGenerators);
+            // takes ownership of the given issues and caches them until the issues are invalidated
+            void setIssues(const IssueList& issues);
             
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
@@ -33,8 +33,10 @@ namespace TrenchBroom {
         public:
             virtual ~NodeSnapshot();
             void restore(const BBox3& worldBounds);
+            size_t memoryUsage() const;
         private:
             virtual void doRestore(const BBox3& worldBounds) = 0;
+            virtual size_t doGetMemoryUsage() const = 0;
         };
     }
 }
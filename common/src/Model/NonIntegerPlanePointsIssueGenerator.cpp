@@ -65,6 +65,10 @@ namespace TrenchBroom {
             addQuickFix(new NonIntegerPlanePointsIssueQuickFix());
         }
 
+        bool NonIntegerPlanePointsIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void NonIntegerPlanePointsIssueGenerator::doGenerate(Brush* brush, IssueList& issues) const {
             for (const BrushFace* face : brush->faces()) {
                 const BrushFace::Points& points = face->points();
@@ -64,6 +64,10 @@ namespace TrenchBroom {
             addQuickFix(new NonIntegerVerticesIssueQuickFix());
         }
 
+        bool NonIntegerVerticesIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void NonIntegerVerticesIssueGenerator::doGenerate(Brush* brush, IssueList& issues) const {
             for (const BrushVertex* vertex : brush->vertices()) {
                 if (!vertex->position().isInteger()) {
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             NonIntegerVerticesIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(Brush* brush, IssueList& issues) const;
         };
     }
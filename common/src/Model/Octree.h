@@ -31,27 +31,33 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename F, typename T>
-        class OctreeNode {
+        /**
+         A node of a spatial tree with S dimensions. Each node splits its bounds in half along every axis, so it has
+         up to 2^S children.
+         */
+        template <typename F, size_t S, typename T>
+        class SpatialTreeNode {
+        public:
+            static const size_t ChildCount = static_cast<size_t>(1) << S;
         private:
             typedef std::vector<T> List;
             
-            BBox<F,3> m_bounds;
+            BBox<F,S> m_bounds;
             F m_minSize;
-            OctreeNode* m_parent;
-            OctreeNode* m_children[8];
+            SpatialTreeNode* m_parent;
+            SpatialTreeNode* m_children[ChildCount];
             List m_objects;
         public:
-            OctreeNode(const BBox<F,3>& bounds, const F minSize, OctreeNode* parent) :
+            SpatialTreeNode(const BBox<F,S>& bounds, const F minSize, SpatialTreeNode* parent) :
             m_bounds(bounds),
             m_minSize(minSize),
             m_parent(parent) {
-                for (size_t i = 0; i < 8; ++i)
+                for (size_t i = 0; i < ChildCount; ++i)
                     m_children[i] = NULL;
             }
             
-            ~OctreeNode() {
-                for (size_t i = 0; i < 8; ++i) {
+            ~SpatialTreeNode() {
+                for (size_t i = 0; i < ChildCount; ++i) {
                     if (m_children[i] != NULL) {
                         delete m_children[i];
                         m_children[i] = NULL;
@@ -59,13 +65,13 @@ namespace TrenchBroom {
                 }
             }
             
-            bool contains(const BBox<F,3>& bounds) const {
+            bool contains(const BBox<F,S>& bounds) const {
                 return m_bounds.contains(bounds);
             }
             
-            bool containsObject(const BBox<F,3>& bounds, T object) const {
+            bool containsObject(const BBox<F,S>& bounds, T object) const {
                 assert(contains(bounds));
-                for (size_t i = 0; i < 8; ++i) {
+                for (size_t i = 0; i < ChildCount; ++i) {
                     if (m_children[i] != NULL && m_children[i]->contains(bounds)) {
                         return m_children[i]->containsObject(bounds, object);
                     }
@@ -75,20 +81,19 @@ namespace TrenchBroom {
                 return it != std::end(m_objects);
             }
             
-            OctreeNode* addObject(const BBox<F,3>& bounds, T object) {
+            SpatialTreeNode* addObject(const BBox<F,S>& bounds, T object) {
                 assert(contains(bounds));
                 
-                const Vec3f size = m_bounds.size();
-                if (size.x() > m_minSize || size.y() > m_minSize || size.z() > m_minSize) {
-                    for (size_t i = 0; i < 8; ++i) {
+                if (canSplit()) {
+                    for (size_t i = 0; i < ChildCount; ++i) {
                         if (m_children[i] != NULL && m_children[i]->contains(bounds)) {
                             return m_children[i]->addObject(bounds, object);
-                        } else {
-                            const BBox<F,3> childBounds = octant(i);
+                        } else if (m_children[i] == NULL) {
+                            const BBox<F,S> childBounds = childCell(i);
                             if (childBounds.contains(bounds)) {
-                                OctreeNode<F,T>* child = new OctreeNode<F,T>(childBounds, m_minSize, this);
+                                SpatialTreeNode* child = new SpatialTreeNode(childBounds, m_minSize, this);
                                 try {
-                                    OctreeNode* result = child->addObject(bounds, object);
+                                    SpatialTreeNode* result = child->addObject(bounds, object);
                                     m_children[i] = child;
                                     return result;
                                 } catch (...) {
@@ -113,7 +118,7 @@ namespace TrenchBroom {
                 return true;
             }
 
-            OctreeNode* findContaining(const BBox<F,3>& bounds) {
+            SpatialTreeNode* findContaining(const BBox<F,S>& bounds) {
                 if (contains(bounds))
                     return this;
                 if (m_parent == NULL)
@@ -121,141 +126,169 @@ namespace TrenchBroom {
                 return m_parent->findContaining(bounds);
             }
             
-            void findObjects(const Ray<F,3>& ray, List& result) const {
+            void findObjects(const Ray<F,S>& ray, List& result) const {
                 const F distance = m_bounds.intersectWithRay(ray);
                 if (Math::isnan(distance))
                     return;
                 
-                for (size_t i = 0; i < 8; ++i)
+                for (size_t i = 0; i < ChildCount; ++i)
                     if (m_children[i] != NULL)
                         m_children[i]->findObjects(ray, result);
                 result.insert(std::end(result), std::begin(m_objects), std::end(m_objects));
             }
             
-            void findObjects(const Vec<F,3>& point, List& result) const {
+            void findObjects(const Vec<F,S>& point, List& result) const {
                 if (!m_bounds.contains(point))
                     return;
                 
-                for (size_t i = 0; i < 8; ++i)
+                for (size_t i = 0; i < ChildCount; ++i)
                     if (m_children[i] != NULL)
                         m_children[i]->findObjects(point, result);
                 result.insert(std::end(result), std::begin(m_objects), std::end(m_objects));
             }
+
+            void findObjects(const BBox<F,S>& bounds, List& result) const {
+                if (!m_bounds.intersects(bounds))
+                    return;
+                
+                for (size_t i = 0; i < ChildCount; ++i)
+                    if (m_children[i] != NULL)
+                        m_children[i]->findObjects(bounds, result);
+                result.insert(std::end(result), std::begin(m_objects), std::end(m_objects));
+            }
         private:
-            BBox<F,3> octant(const size_t index) const {
-                const Vec3f& min = m_bounds.min;
-                const Vec3f& max = m_bounds.max;
-                const Vec3f mid = (min + max) / 2.0f;
-                switch (index) {
-                    case 0: // xyz +++
-                        return BBox<F,3>(mid, max);
-                    case 1: // xyz -++
-                        return BBox<F,3>(Vec3f(min.x(), mid.y(), mid.z()),
-                                      Vec3f(mid.x(), max.y(), max.z()));
-                    case 2: // xyz +-+
-                        return BBox<F,3>(Vec3f(mid.x(), min.y(), mid.z()),
-                                      Vec3f(max.x(), mid.y(), max.z()));
-                    case 3: // xyz --+
-                        return BBox<F,3>(Vec3f(min.x(), min.y(), mid.z()),
-                                      Vec3f(mid.x(), mid.y(), max.z()));
-                    case 4: // xyz ++-
-                        return BBox<F,3>(Vec3f(mid.x(), mid.y(), min.z()),
-                                      Vec3f(max.x(), max.y(), mid.z()));
-                    case 5: // xyz -+-
-                        return BBox<F,3>(Vec3f(min.x(), mid.y(), min.z()),
-                                      Vec3f(mid.x(), max.y(), mid.z()));
-                    case 6: // xyz +--
-                        return BBox<F,3>(Vec3f(mid.x(), min.y(), min.z()),
-                                      Vec3f(max.x(), mid.y(), mid.z()));
-                    case 7: // xyz ---
-                        return BBox<F,3>(Vec3f(min.x(), min.y(), min.z()),
-                                      Vec3f(mid.x(), mid.y(), mid.z()));
-                    default:
-                        assert(false);
-                        return BBox<F,3>();
+            bool canSplit() const {
+                const Vec<F,S> size = m_bounds.size();
+                for (size_t i = 0; i < S; ++i) {
+                    if (size[i] > m_minSize)
+                        return true;
+                }
+                return false;
+            }
+            
+            /**
+             Returns the bounds of the child cell with the given index. Bit i of the index selects the lower half of
+             this node's bounds along axis i, so child 0 is the cell at the maximum corner.
+             */
+            BBox<F,S> childCell(const size_t index) const {
+                assert(index < ChildCount);
+                
+                const Vec<F,S>& min = m_bounds.min;
+                const Vec<F,S>& max = m_bounds.max;
+                const Vec<F,S> mid = (min + max) / static_cast<F>(2.0);
+                
+                BBox<F,S> result;
+                for (size_t i = 0; i < S; ++i) {
+                    if ((index & (static_cast<size_t>(1) << i)) == 0) {
+                        result.min[i] = mid[i];
+                        result.max[i] = max[i];
+                    } else {
+                        result.min[i] = min[i];
+                        result.max[i] = mid[i];
+                    }
                 }
+                return result;
             }
         };
         
-        template <typename F, typename T>
-        class Octree {
+        /**
+         A spatial tree with S dimensions that stores objects by their bounds. Octree and Quadtree are its three and
+         two dimensional instances.
+         */
+        template <typename F, size_t S, typename T>
+        class SpatialTree {
         public:
             typedef std::vector<T> List;
         private:
-            typedef std::map<T, OctreeNode<F,T>*> ObjectMap;
-            BBox<F,3> m_bounds;
-            OctreeNode<F,T>* m_root;
+            typedef SpatialTreeNode<F,S,T> Node;
+            typedef std::map<T, Node*> ObjectMap;
+            BBox<F,S> m_bounds;
+            Node* m_root;
             ObjectMap m_objectMap;
         public:
-            Octree(const BBox<F,3>& bounds, const F minSize) :
+            SpatialTree(const BBox<F,S>& bounds, const F minSize) :
             m_bounds(bounds),
-            m_root(new OctreeNode<F,T>(bounds, minSize, NULL)) {}
+            m_root(new Node(bounds, minSize, NULL)) {}
             
-            ~Octree() {
+            ~SpatialTree() {
                 delete m_root;
             }
             
-            const BBox<F,3>& bounds() const {
+            const BBox<F,S>& bounds() const {
                 return m_bounds;
             }
             
-            void addObject(const BBox<F,3>& bounds, T object) {
+            void addObject(const BBox<F,S>& bounds, T object) {
                 if (!m_root->contains(bounds))
-                    throw OctreeException("Object is too large for this octree");
+                    throw OctreeException("Object is too large for this tree");
                 
-                OctreeNode<F,T>* node = m_root->addObject(bounds, object);
+                Node* node = m_root->addObject(bounds, object);
                 if (node == NULL)
-                    throw OctreeException("Unknown error when inserting into octree");
+                    throw OctreeException("Unknown error when inserting into tree");
                 assertResult(MapUtils::insertOrFail(m_objectMap, object, node));
             }
             
             void removeObject(T object) {
                 typename ObjectMap::iterator it = m_objectMap.find(object);
                 if (it == std::end(m_objectMap))
-                    throw OctreeException("Cannot find object in octree");
+                    throw OctreeException("Cannot find object in tree");
                 
-                OctreeNode<F,T>* node = it->second;
+                Node* node = it->second;
                 if (!node->removeObject(object))
-                    throw OctreeException("Cannot find object in octree");
+                    throw OctreeException("Cannot find object in tree");
                 m_objectMap.erase(it);
             }
             
-            void updateObject(const BBox<F,3>& bounds, T object) {
+            void updateObject(const BBox<F,S>& bounds, T object) {
                 typename ObjectMap::iterator it = m_objectMap.find(object);
                 if (it == std::end(m_objectMap))
-                    throw OctreeException("Cannot find object in octree");
+                    throw OctreeException("Cannot find object in tree");
 
-                OctreeNode<F,T>* oldNode = it->second;
+                Node* oldNode = it->second;
                 if (!oldNode->removeObject(object))
-                    throw OctreeException("Cannot find object in octree");
+                    throw OctreeException("Cannot find object in tree");
                 
-                OctreeNode<F,T>* newAncestor = oldNode->findContaining(bounds);
+                Node* newAncestor = oldNode->findContaining(bounds);
                 if (newAncestor == NULL)
-                    throw OctreeException("Cannot find new ancestor node in octree");
-                OctreeNode<F,T>* newParent = newAncestor->addObject(bounds, object);
+                    throw OctreeException("Cannot find new ancestor node in tree");
+                Node* newParent = newAncestor->addObject(bounds, object);
                 if (newParent == NULL)
-                    throw OctreeException("Unknown error when inserting into octree");
+                    throw OctreeException("Unknown error when inserting into tree");
                 MapUtils::insertOrReplace(m_objectMap, object, newParent);
             }
             
-            bool containsObject(const BBox<F,3>& bounds, T object) const {
+            bool containsObject(const BBox<F,S>& bounds, T object) const {
                 if (!m_root->contains(bounds))
                     return false;
                 return m_root->containsObject(bounds, object);
             }
             
-            List findObjects(const Ray<F,3>& ray) const {
+            List findObjects(const Ray<F,S>& ray) const {
                 List result;
                 m_root->findObjects(ray, result);
                 return result;
             }
             
-            List findObjects(const Vec<F,3>& point) const {
+            List findObjects(const Vec<F,S>& point) const {
                 List result;
                 m_root->findObjects(point, result);
                 return result;
             }
+
+            /**
+             Returns every object stored in a cell that intersects the given bounds. The result is a
+             superset of the objects whose bounds intersect the given bounds, so callers must still
+             test the returned objects.
+             */
+            List findObjects(const BBox<F,S>& bounds) const {
+                List result;
+                m_root->findObjects(bounds, result);
+                return result;
+            }
         };
+        
+        template <typename F, typename T>
+        using Octree = SpatialTree<F,3,T>;
     }
 }
 
@@ -78,6 +78,10 @@ namespace TrenchBroom {
             addQuickFix(new PointEntityWithBrushesIssueQuickFix());
         }
         
+        bool PointEntityWithBrushesIssueGenerator::doIsThreadSafe() const {
+            return true;
+        }
+        
         void PointEntityWithBrushesIssueGenerator::doGenerate(Entity* entity, IssueList& issues) const {
             ensure(entity != NULL, "entity is null");
             const Assets::EntityDefinition* definition = entity->definition();
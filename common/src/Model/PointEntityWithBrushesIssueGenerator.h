@@ -32,6 +32,7 @@ namespace TrenchBroom {
         public:
             PointEntityWithBrushesIssueGenerator();
         private:
+            bool doIsThreadSafe() const;
             void doGenerate(Entity* entity, IssueList& issues) const;
         };
     }
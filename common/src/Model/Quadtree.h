@@ -0,0 +1,36 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_Quadtree
+#define TrenchBroom_Quadtree
+
+#include "Model/Octree.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         A two dimensional counterpart to the octree. It indexes objects by their bounds projected onto a plane, so
+         it answers queries along a coordinate axis without walking the cells of a three dimensional tree.
+         */
+        template <typename F, typename T>
+        using Quadtree = SpatialTree<F,2,T>;
+    }
+}
+
+#endif /* defined(TrenchBroom_Quadtree) */
@@ -41,6 +41,15 @@ namespace TrenchBroom {
                 snapshot->restore();
         }
 
+        size_t Snapshot::memoryUsage() const {
+            size_t result = sizeof(Snapshot);
+            for (const NodeSnapshot* snapshot : m_nodeSnapshots)
+                result += sizeof(NodeSnapshot*) + snapshot->memoryUsage();
+            for (const BrushFaceSnapshot* snapshot : m_brushFaceSnapshots)
+                result += sizeof(BrushFaceSnapshot*) + snapshot->memoryUsage();
+            return result;
+        }
+        
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
             if (snapshot != NULL)
@@ -47,6 +47,8 @@ namespace TrenchBroom {
             
             void restoreNodes(const BBox3& worldBounds);
             void restoreBrushFaces();
+            
+            size_t memoryUsage() const;
         private:
             void takeSnapshot(Node* node);
             void takeSnapshot(BrushFace* face);
@@ -70,6 +70,10 @@ namespace TrenchBroom {
             return doGetTexCoords(point, attribs);
         }
         
+        void TexCoordSystem::getTexCoords(const Vec3* points, const size_t count, const BrushFaceAttributes& attribs, Vec2f* result) const {
+            computeTexCoords(points, count, attribs.scale(), attribs.offset(), attribs.textureSize(), result);
+        }
+        
         void TexCoordSystem::setRotation(const Vec3& normal, const float oldAngle, const float newAngle) {
             doSetRotation(normal, oldAngle, newAngle);
         }
@@ -238,5 +242,24 @@ namespace TrenchBroom {
                          point.dot(safeScaleAxis(getYAxis(), scale.y())));
         }
         
+        void TexCoordSystem::computeTexCoords(const Vec3* points, const size_t count, const Vec2f& scale, const Vec2f& offset, const Vec2f& textureSize, Vec2f* result) const {
+            // hoist the axes out of the loop so that it contains no calls and can be vectorized; the arithmetic is
+            // the same as in the single point version so that both yield identical results
+            const Vec3 xAxis = safeScaleAxis(getXAxis(), scale.x());
+            const Vec3 yAxis = safeScaleAxis(getYAxis(), scale.y());
+            
+            const FloatType xx = xAxis.x(), xy = xAxis.y(), xz = xAxis.z();
+            const FloatType yx = yAxis.x(), yy = yAxis.y(), yz = yAxis.z();
+            const float ox = offset.x(), oy = offset.y();
+            const float sx = textureSize.x(), sy = textureSize.y();
+            
+            for (size_t i = 0; i < count; ++i) {
+                const Vec3& p = points[i];
+                const float u = static_cast<float>(p.x() * xx + p.y() * xy + p.z() * xz);
+                const float v = static_cast<float>(p.x() * yx + p.y() * yy + p.z() * yz);
+                result[i] = Vec2f((u + ox) / sx, (v + oy) / sy);
+            }
+        }
+        
     }
 }
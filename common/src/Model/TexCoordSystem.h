@@ -64,6 +64,7 @@ namespace TrenchBroom {
             void resetTextureAxesToParallel(const Vec3& normal, float angle);
             
             Vec2f getTexCoords(const Vec3& point, const BrushFaceAttributes& attribs) const;
+            void getTexCoords(const Vec3* points, size_t count, const BrushFaceAttributes& attribs, Vec2f* result) const;
             
             void setRotation(const Vec3& normal, float oldAngle, float newAngle);
             void transform(const Plane3& oldBoundary, const Mat4x4& transformation, BrushFaceAttributes& attribs, bool lockTexture, const Vec3& invariant);
@@ -102,6 +103,7 @@ namespace TrenchBroom {
             virtual float doMeasureAngle(float currentAngle, const Vec2f& center, const Vec2f& point) const = 0;
         protected:
             Vec2f computeTexCoords(const Vec3& point, const Vec2f& scale) const;
+            void computeTexCoords(const Vec3* points, size_t count, const Vec2f& scale, const Vec2f& offset, const Vec2f& textureSize, Vec2f* result) const;
 
             template <typename T>
             T safeScale(const T value) const {
@@ -58,6 +58,45 @@ namespace TrenchBroom {
             return visitor.layers();
         }
 
+        NodeList World::findNodesIntersecting(const BBox3& bounds) const {
+            NodeList result;
+            for (const Layer* layer : allLayers())
+                VectorUtils::append(result, layer->findNodesIntersecting(bounds));
+            return result;
+        }
+
+        NodeList World::findNodesIntersecting(const BrushList& brushes) const {
+            const LayerList layers = allLayers();
+            
+            NodeList result;
+            NodeSet visited;
+            for (const Brush* brush : brushes) {
+                for (const Layer* layer : layers) {
+                    for (Node* node : layer->findNodesIntersecting(brush->bounds())) {
+                        if (visited.insert(node).second)
+                            result.push_back(node);
+                    }
+                }
+            }
+            return result;
+        }
+
+        NodeList World::findNodesIntersecting(const BrushList& brushes, const Math::Axis::Type axis) const {
+            const LayerList layers = allLayers();
+            
+            NodeList result;
+            NodeSet visited;
+            for (const Brush* brush : brushes) {
+                for (const Layer* layer : layers) {
+                    for (Node* node : layer->findNodesIntersecting(brush->bounds(), axis)) {
+                        if (visited.insert(node).second)
+                            result.push_back(node);
+                    }
+                }
+            }
+            return result;
+        }
+
         void World::createDefaultLayer(const BBox3& worldBounds) {
             m_defaultLayer = createLayer("Default Layer", worldBounds);
             addChild(m_defaultLayer);
@@ -272,6 +311,10 @@ namespace TrenchBroom {
         Brush* World::doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces) const {
             return m_factory.createBrush(worldBounds, faces);
         }
+
+        Brush* World::doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const {
+            return m_factory.createBrush(worldBounds, faces, positions, faceSizes, faceIndices);
+        }
         
         BrushFace* World::doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const {
             return m_factory.createFace(point1, point2, point3, attribs);
@@ -48,6 +48,19 @@ namespace TrenchBroom {
             Layer* defaultLayer() const;
             LayerList allLayers() const;
             LayerList customLayers() const;
+            
+            /**
+             Returns the top level nodes of all layers whose bounds intersect the given bounds or the
+             bounds of any of the given brushes. Only the layers' direct children are returned, and
+             callers must recurse into groups and entities themselves.
+             */
+            NodeList findNodesIntersecting(const BBox3& bounds) const;
+            NodeList findNodesIntersecting(const BrushList& brushes) const;
+            
+            /**
+             Like the above, but the bounds are compared after projecting them along the given axis.
+             */
+            NodeList findNodesIntersecting(const BrushList& brushes, Math::Axis::Type axis) const;
         private:
             void createDefaultLayer(const BBox3& worldBounds);
         public: // selection
@@ -90,6 +103,7 @@ namespace TrenchBroom {
             Group* doCreateGroup(const String& name) const;
             Entity* doCreateEntity() const;
             Brush* doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces) const;
+            Brush* doCreateBrush(const BBox3& worldBounds, const BrushFaceList& faces, const Vec3::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices) const;
             BrushFace* doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs) const;
             BrushFace* doCreateFace(const Vec3& point1, const Vec3& point2, const Vec3& point3, const BrushFaceAttributes& attribs, const Vec3& texAxisX, const Vec3& texAxisY) const;
         private:
@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <cassert>
 #include <list>
+#include <unordered_set>
+#include <vector>
 
 namespace TrenchBroom {
     template <typename O>
@@ -965,6 +967,129 @@ namespace TrenchBroom {
             }
         }
     };
+    
+    /**
+     Forwards lists of items to a notifier. While a batch is open, the items are collected instead, and the
+     notifier is called once with the distinct items in the order in which they were first passed when the
+     outermost batch is closed.
+     
+     Before notifications are coalesced accordingly: an item whose after notification is still pending is not
+     announced again, so that every observer sees exactly one before and one after notification per item.
+     */
+    template <typename T>
+    class CoalescingNotifier {
+    public:
+        typedef std::vector<T> List;
+        typedef Notifier1<const List&> Target;
+    private:
+        Target& m_target;
+        size_t m_batchLevel;
+        List m_pending;
+        std::unordered_set<T> m_pendingSet;
+    public:
+        class NotifyBeforeAndAfter {
+        private:
+            CoalescingNotifier& m_after;
+            const List& m_items;
+        public:
+            NotifyBeforeAndAfter(Target& before, CoalescingNotifier& after, const List& items) :
+            m_after(after),
+            m_items(items) {
+                m_after.notifyBefore(before, items);
+            }
+            
+            ~NotifyBeforeAndAfter() {
+                m_after(m_items);
+            }
+        };
+        
+        class Batch {
+        private:
+            CoalescingNotifier& m_notifier;
+        public:
+            Batch(CoalescingNotifier& notifier) :
+            m_notifier(notifier) {
+                m_notifier.beginBatch();
+            }
+            
+            ~Batch() {
+                m_notifier.endBatch();
+            }
+        };
+    public:
+        CoalescingNotifier(Target& target) :
+        m_target(target),
+        m_batchLevel(0) {}
+        
+        bool batching() const {
+            return m_batchLevel > 0;
+        }
+        
+        void beginBatch() {
+            ++m_batchLevel;
+        }
+        
+        void endBatch() {
+            assert(m_batchLevel > 0);
+            if (--m_batchLevel == 0)
+                flush();
+        }
+        
+        void notify(const List& items) {
+            if (!batching()) {
+                m_target(items);
+            } else {
+                for (const T& item : items) {
+                    if (m_pendingSet.insert(item).second)
+                        m_pending.push_back(item);
+                }
+            }
+        }
+        
+        void operator()(const List& items) {
+            notify(items);
+        }
+        
+        void notifyBefore(Target& before, const List& items) {
+            if (m_pending.empty()) {
+                before(items);
+            } else {
+                List announced;
+                for (const T& item : items) {
+                    if (m_pendingSet.count(item) == 0)
+                        announced.push_back(item);
+                }
+                if (!announced.empty())
+                    before(announced);
+            }
+        }
+        
+        // Removes the given items from the pending notification, e.g. because they are about to be deleted.
+        void discard(const List& items) {
+            if (m_pending.empty())
+                return;
+            
+            size_t count = 0;
+            for (const T& item : items)
+                count += m_pendingSet.erase(item);
+            
+            if (count > 0) {
+                const std::unordered_set<T> discarded(std::begin(items), std::end(items));
+                m_pending.erase(std::remove_if(std::begin(m_pending), std::end(m_pending), [&discarded](const T& item) { return discarded.count(item) > 0; }), std::end(m_pending));
+            }
+        }
+        
+        // Delivers the pending notification immediately, even if a batch is open.
+        void flush() {
+            if (m_pending.empty())
+                return;
+            
+            List items;
+            items.swap(m_pending);
+            m_pendingSet.clear();
+            m_target(items);
+        }
+    };
 }
 
 #endif
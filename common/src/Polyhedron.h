@@ -302,11 +302,19 @@ public: // Constructors
     Polyhedron(const typename V::Set& positions);
     Polyhedron(const typename V::Set& positions, Callback& callback);
 
+    /**
+     Restores a polyhedron from a previously recorded topology without recomputing the convex hull. Each face is
+     given by the indices of its boundary vertices in the given list of positions, and the face sizes determine how
+     many indices belong to each face. Throws a GeometryException if the topology is not a closed manifold.
+     */
+    Polyhedron(const typename V::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices, Callback& callback);
+
     Polyhedron(const Polyhedron<T,FP,VP>& other);
     Polyhedron(Polyhedron<T,FP,VP>&& other);
 private: // Constructor helpers
     void addPoints(const V& p1, const V& p2, const V& p3, const V& p4, Callback& callback);
     void setBounds(const BBox<T,3>& bounds, Callback& callback);
+    void setTopology(const typename V::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices, Callback& callback);
 private: // Copy helper
     class Copy;
 public: // Destructor
@@ -20,6 +20,9 @@
 #ifndef TrenchBroom_Polyhedron_Misc_h
 #define TrenchBroom_Polyhedron_Misc_h
 
+#include "Exceptions.h"
+
+#include <algorithm>
 #include <map>
 
 template <typename T, typename FP, typename VP>
@@ -174,6 +177,11 @@ Polyhedron<T,FP,VP>::Polyhedron(const typename V::Set& positions, Callback& call
     addPoints(std::begin(positions), std::end(positions), callback);
 }
 
+template <typename T, typename FP, typename VP>
+Polyhedron<T,FP,VP>::Polyhedron(const typename V::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices, Callback& callback) {
+    setTopology(positions, faceSizes, faceIndices, callback);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other) {
     Copy copy(other.faces(), other.edges(), other.vertices(), *this);
@@ -318,6 +326,82 @@ void Polyhedron<T,FP,VP>::setBounds(const BBox<T,3>& bounds, Callback& callback)
     m_bounds = bounds;
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::setTopology(const typename V::List& positions, const std::vector<size_t>& faceSizes, const std::vector<size_t>& faceIndices, Callback& callback) {
+    typedef std::pair<size_t, size_t> DirectedEdge;
+    typedef std::map<DirectedEdge, size_t> DirectedEdgeMap;
+    
+    // Validate the entire topology first so that we never have to tear down a partially built polyhedron.
+    if (positions.size() < 4 || faceSizes.size() < 4)
+        throw GeometryException("Polyhedron topology has too few vertices or faces");
+    
+    DirectedEdgeMap directedEdges;
+    std::vector<bool> referenced(positions.size(), false);
+    
+    size_t first = 0;
+    for (const size_t faceSize : faceSizes) {
+        if (faceSize < 3 || first + faceSize > faceIndices.size())
+            throw GeometryException("Polyhedron topology contains an invalid face");
+        
+        for (size_t i = 0; i < faceSize; ++i) {
+            const size_t origin = faceIndices[first + i];
+            const size_t destination = faceIndices[first + (i + 1) % faceSize];
+            if (origin >= positions.size() || destination >= positions.size() || origin == destination)
+                throw GeometryException("Polyhedron topology contains an invalid vertex index");
+            if (!directedEdges.insert(std::make_pair(DirectedEdge(origin, destination), first + i)).second)
+                throw GeometryException("Polyhedron topology is not a manifold");
+            referenced[origin] = true;
+        }
+        first += faceSize;
+    }
+    
+    if (first != faceIndices.size())
+        throw GeometryException("Polyhedron topology has unused face indices");
+    if (std::find(std::begin(referenced), std::end(referenced), false) != std::end(referenced))
+        throw GeometryException("Polyhedron topology has unreferenced vertices");
+    
+    std::vector<size_t> twins(faceIndices.size());
+    for (const auto& entry : directedEdges) {
+        const DirectedEdge& edge = entry.first;
+        const typename DirectedEdgeMap::const_iterator twin = directedEdges.find(DirectedEdge(edge.second, edge.first));
+        if (twin == std::end(directedEdges))
+            throw GeometryException("Polyhedron topology is not closed");
+        twins[entry.second] = twin->second;
+    }
+    
+    std::vector<Vertex*> vertices;
+    vertices.reserve(positions.size());
+    for (const V& position : positions) {
+        Vertex* vertex = new Vertex(position);
+        m_vertices.append(vertex, 1);
+        vertices.push_back(vertex);
+        callback.vertexWasCreated(vertex);
+    }
+    
+    std::vector<HalfEdge*> halfEdges;
+    halfEdges.reserve(faceIndices.size());
+    for (const size_t faceSize : faceSizes) {
+        HalfEdgeList boundary;
+        for (size_t i = 0; i < faceSize; ++i) {
+            HalfEdge* halfEdge = new HalfEdge(vertices[faceIndices[halfEdges.size()]]);
+            boundary.append(halfEdge, 1);
+            halfEdges.push_back(halfEdge);
+        }
+        
+        Face* face = new Face(boundary);
+        m_faces.append(face, 1);
+        callback.faceWasCreated(face);
+    }
+    
+    for (size_t i = 0; i < halfEdges.size(); ++i) {
+        if (i < twins[i])
+            m_edges.append(new Edge(halfEdges[i], halfEdges[twins[i]]), 1);
+    }
+    
+    updateBounds();
+    assert(checkInvariant());
+}
+
 template <typename T, typename FP, typename VP>
 class Polyhedron<T,FP,VP>::Copy {
 private:
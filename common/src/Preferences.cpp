@@ -110,6 +110,12 @@ namespace TrenchBroom {
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
+        
+        Preference<bool> UseMapCache(IO::Path("Editor/Use map cache"), false);
+        
+        Preference<float> EntityModelDrawDistance(IO::Path("Renderer/Entity model draw distance"), 8192.0f);
+        Preference<float> EntityModelImpostorDistance(IO::Path("Renderer/Entity model impostor distance"), 2048.0f);
+        Preference<float> EntityLabelDrawDistance(IO::Path("Renderer/Entity label draw distance"), 768.0f);
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
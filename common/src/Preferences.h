@@ -108,6 +108,12 @@ namespace TrenchBroom {
         
         extern Preference<bool> TextureLock;
         
+        extern Preference<bool> UseMapCache;
+        
+        extern Preference<float> EntityModelDrawDistance;
+        extern Preference<float> EntityModelImpostorDistance;
+        extern Preference<float> EntityLabelDrawDistance;
+        
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
         
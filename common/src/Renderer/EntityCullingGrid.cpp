@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityCullingGrid.h"
+
+#include "Model/Entity.h"
+#include "Renderer/Camera.h"
+
+#include <cmath>
+#include <map>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        const float EntityCullingGrid::CellSize = 1024.0f;
+        
+        EntityCullingGrid::EntityCullingGrid() :
+        m_entityCount(0) {}
+        
+        void EntityCullingGrid::build(const Model::EntityList& entities) {
+            typedef std::map<Vec3i, size_t> CellIndex;
+
+            clear();
+            
+            CellIndex cellIndex;
+            for (Model::Entity* entity : entities) {
+                const BBox3f bounds(entity->bounds());
+                const Vec3f center = bounds.center();
+                const Vec3i key(static_cast<int>(std::floor(center.x() / CellSize)),
+                                static_cast<int>(std::floor(center.y() / CellSize)),
+                                static_cast<int>(std::floor(center.z() / CellSize)));
+                
+                CellIndex::iterator it = cellIndex.find(key);
+                if (it == std::end(cellIndex)) {
+                    it = cellIndex.insert(std::make_pair(key, m_cells.size())).first;
+                    m_cells.push_back(Cell());
+                    m_cells.back().bounds = bounds;
+                }
+                
+                Cell& cell = m_cells[it->second];
+                cell.bounds.mergeWith(bounds);
+                cell.entities.push_back(entity);
+            }
+            
+            m_entityCount = entities.size();
+        }
+        
+        void EntityCullingGrid::clear() {
+            m_cells.clear();
+            m_entityCount = 0;
+        }
+        
+        size_t EntityCullingGrid::entityCount() const {
+            return m_entityCount;
+        }
+        
+        void EntityCullingGrid::findEntities(const Camera& camera, const float maxDistance, Model::EntityList& result) const {
+            Plane3f frustumPlanes[4];
+            camera.frustumPlanes(frustumPlanes[0], frustumPlanes[1], frustumPlanes[2], frustumPlanes[3]);
+            findEntities(frustumPlanes, camera.position(), camera.direction(), maxDistance, result);
+        }
+        
+        void EntityCullingGrid::findEntities(const Plane3f frustumPlanes[4], const Vec3f& position, const Vec3f& direction, const float maxDistance, Model::EntityList& result) const {
+            for (const Cell& cell : m_cells) {
+                if (visible(cell.bounds, frustumPlanes, position, direction, maxDistance)) {
+                    for (Model::Entity* entity : cell.entities) {
+                        if (visible(BBox3f(entity->bounds()), frustumPlanes, position, direction, maxDistance))
+                            result.push_back(entity);
+                    }
+                }
+            }
+        }
+        
+        bool EntityCullingGrid::visible(const BBox3f& bounds, const Plane3f frustumPlanes[4], const Vec3f& position, const Vec3f& direction, const float maxDistance) {
+            // the frustum planes face outward, so the box is invisible if its corner farthest inside is outside
+            for (size_t i = 0; i < 4; ++i) {
+                const Plane3f& plane = frustumPlanes[i];
+                Vec3f corner;
+                for (size_t j = 0; j < 3; ++j)
+                    corner[j] = plane.normal[j] >= 0.0f ? bounds.min[j] : bounds.max[j];
+                if (plane.pointDistance(corner) > 0.0f)
+                    return false;
+            }
+            
+            return withinDistance(bounds, position, direction, maxDistance);
+        }
+        
+        bool EntityCullingGrid::withinDistance(const BBox3f& bounds, const Vec3f& position, const Vec3f& direction, const float maxDistance) {
+            if (maxDistance <= 0.0f)
+                return true;
+            
+            Vec3f nearest;
+            for (size_t i = 0; i < 3; ++i)
+                nearest[i] = direction[i] >= 0.0f ? bounds.min[i] : bounds.max[i];
+            return (nearest - position).dot(direction) <= maxDistance;
+        }
+    }
+}
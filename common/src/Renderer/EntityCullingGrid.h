@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_EntityCullingGrid
+#define TrenchBroom_EntityCullingGrid
+
+#include "VecMath.h"
+#include "Model/ModelTypes.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class Camera;
+        
+        /**
+         Sorts entities into the cells of a uniform grid so that the entities outside of the view frustum or
+         beyond a maximum distance from the camera can be culled cell by cell before they are tested
+         individually. The grid must be rebuilt when the entities or their bounds change.
+         */
+        class EntityCullingGrid {
+        public:
+            static const float CellSize;
+        private:
+            struct Cell {
+                BBox3f bounds;
+                Model::EntityList entities;
+            };
+            typedef std::vector<Cell> CellList;
+            
+            CellList m_cells;
+            size_t m_entityCount;
+        public:
+            EntityCullingGrid();
+            
+            void build(const Model::EntityList& entities);
+            void clear();
+            
+            size_t entityCount() const;
+            
+            /**
+             Adds every entity whose bounds intersect the given camera's view frustum and whose distance from
+             the camera plane is at most the given maximum distance to the given list. A maximum distance of
+             zero disables the distance test.
+             */
+            void findEntities(const Camera& camera, float maxDistance, Model::EntityList& result) const;
+            void findEntities(const Plane3f frustumPlanes[4], const Vec3f& position, const Vec3f& direction, float maxDistance, Model::EntityList& result) const;
+            
+            static bool withinDistance(const BBox3f& bounds, const Vec3f& position, const Vec3f& direction, float maxDistance);
+        private:
+            static bool visible(const BBox3f& bounds, const Plane3f frustumPlanes[4], const Vec3f& position, const Vec3f& direction, float maxDistance);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityCullingGrid) */
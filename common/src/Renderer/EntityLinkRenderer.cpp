@@ -34,27 +34,33 @@
 #include "View/MapDocument.h"
 
 #include <cassert>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace Renderer {
+        EntityLinkRenderer::Link::Link(const Model::AttributableNode* i_source, const Model::AttributableNode* i_target) :
+        source(i_source),
+        target(i_target) {}
+        
         EntityLinkRenderer::EntityLinkRenderer(View::MapDocumentWPtr document) :
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
+        m_linksValid(false),
         m_valid(false) {}
         
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
             if (color == m_defaultColor)
                 return;
             m_defaultColor = color;
-            invalidate();
+            m_valid = false;
         }
 
         void EntityLinkRenderer::setSelectedColor(const Color& color) {
             if (color == m_selectedColor)
                 return;
             m_selectedColor = color;
-            invalidate();
+            m_valid = false;
         }
         
         void EntityLinkRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -62,6 +68,14 @@ namespace TrenchBroom {
         }
 
         void EntityLinkRenderer::invalidate() {
+            m_linksValid = false;
+            m_valid = false;
+        }
+        
+        void EntityLinkRenderer::invalidateSelection() {
+            View::MapDocumentSPtr document = lock(m_document);
+            if (document->editorContext().entityLinkMode() != Model::EditorContext::EntityLinkMode_All)
+                m_linksValid = false;
             m_valid = false;
         }
 
@@ -89,9 +103,15 @@ namespace TrenchBroom {
         }
 
         void EntityLinkRenderer::validate() {
-            Vertex::List links;
-            getLinks(links);
-            m_entityLinks = VertexArray::swap(links);
+            if (!m_linksValid) {
+                m_links.clear();
+                getLinks(m_links);
+                m_linksValid = true;
+            }
+            
+            Vertex::List vertices;
+            getVertices(m_links, vertices);
+            m_entityLinks = VertexArray::swap(vertices);
             m_valid = true;
         }
         
@@ -107,14 +127,10 @@ namespace TrenchBroom {
         protected:
             const Model::EditorContext& m_editorContext;
         private:
-            const Color& m_defaultColor;
-            const Color& m_selectedColor;
-            Vertex::List& m_links;
+            LinkList& m_links;
         protected:
-            CollectLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
+            CollectLinksVisitor(const Model::EditorContext& editorContext, LinkList& links) :
             m_editorContext(editorContext),
-            m_defaultColor(defaultColor),
-            m_selectedColor(selectedColor),
             m_links(links) {}
         private:
             void doVisit(Model::World* world)   {}
@@ -130,19 +146,14 @@ namespace TrenchBroom {
             virtual void visitEntity(Model::Entity* entity) = 0;
         protected:
             void addLink(const Model::AttributableNode* source, const Model::AttributableNode* target) {
-                const bool anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
-                const Color& sourceColor = anySelected ? m_selectedColor : m_defaultColor;
-                Color targetColor = anySelected ? m_selectedColor : m_defaultColor;
-                
-                m_links.push_back(Vertex(source->linkSourceAnchor(), sourceColor));
-                m_links.push_back(Vertex(target->linkTargetAnchor(), targetColor));
+                m_links.push_back(Link(source, target));
             }
         };
         
         class EntityLinkRenderer::CollectAllLinksVisitor : public CollectLinksVisitor {
         public:
-            CollectAllLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
-            CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+            CollectAllLinksVisitor(const Model::EditorContext& editorContext, LinkList& links) :
+            CollectLinksVisitor(editorContext, links) {}
         private:
             void visitEntity(Model::Entity* entity) {
                 if (m_editorContext.visible(entity)) {
@@ -161,10 +172,10 @@ namespace TrenchBroom {
         
         class EntityLinkRenderer::CollectTransitiveSelectedLinksVisitor : public CollectLinksVisitor {
         private:
-            Model::NodeSet m_visited;
+            std::unordered_set<Model::Node*> m_visited;
         public:
-            CollectTransitiveSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
-            CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+            CollectTransitiveSelectedLinksVisitor(const Model::EditorContext& editorContext, LinkList& links) :
+            CollectLinksVisitor(editorContext, links) {}
         private:
             void visitEntity(Model::Entity* entity) {
                 if (m_editorContext.visible(entity)) {
@@ -199,8 +210,8 @@ namespace TrenchBroom {
         
         class EntityLinkRenderer::CollectDirectSelectedLinksVisitor : public CollectLinksVisitor {
         public:
-            CollectDirectSelectedLinksVisitor(const Model::EditorContext& editorContext, const Color& defaultColor, const Color& selectedColor, Vertex::List& links) :
-            CollectLinksVisitor(editorContext, defaultColor, selectedColor, links) {}
+            CollectDirectSelectedLinksVisitor(const Model::EditorContext& editorContext, LinkList& links) :
+            CollectLinksVisitor(editorContext, links) {}
         private:
             void visitEntity(Model::Entity* entity) {
                 if (entity->selected() || entity->descendantSelected()) {
@@ -226,7 +237,7 @@ namespace TrenchBroom {
             }
         };
         
-        void EntityLinkRenderer::getLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getLinks(LinkList& links) const {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             switch (editorContext.entityLinkMode()) {
@@ -245,30 +256,30 @@ namespace TrenchBroom {
             }
         }
         
-        void EntityLinkRenderer::getAllLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getAllLinks(LinkList& links) const {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             
-            CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectAllLinksVisitor collectLinks(editorContext, links);
             
             Model::World* world = document->world();
             if (world != NULL)
                 world->acceptAndRecurse(collectLinks);
         }
         
-        void EntityLinkRenderer::getTransitiveSelectedLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getTransitiveSelectedLinks(LinkList& links) const {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             
-            CollectTransitiveSelectedLinksVisitor visitor(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectTransitiveSelectedLinksVisitor visitor(editorContext, links);
             collectSelectedLinks(visitor);
         }
         
-        void EntityLinkRenderer::getDirectSelectedLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getDirectSelectedLinks(LinkList& links) const {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             
-            CollectDirectSelectedLinksVisitor visitor(editorContext, m_defaultColor, m_selectedColor, links);
+            CollectDirectSelectedLinksVisitor visitor(editorContext, links);
             collectSelectedLinks(visitor);
         }
 
@@ -282,5 +293,19 @@ namespace TrenchBroom {
             const Model::NodeList& selectedEntities = collectEntities.nodes();
             Model::Node::accept(std::begin(selectedEntities), std::end(selectedEntities), collectLinks);
         }
+        
+        void EntityLinkRenderer::getVertices(const LinkList& links, Vertex::List& vertices) const {
+            vertices.reserve(2 * links.size());
+            for (const Link& link : links) {
+                const Model::AttributableNode* source = link.source;
+                const Model::AttributableNode* target = link.target;
+                
+                const bool anySelected = source->selected() || source->descendantSelected() || target->selected() || target->descendantSelected();
+                const Color& color = anySelected ? m_selectedColor : m_defaultColor;
+                
+                vertices.push_back(Vertex(source->linkSourceAnchor(), color));
+                vertices.push_back(Vertex(target->linkTargetAnchor(), color));
+            }
+        }
     }
 }
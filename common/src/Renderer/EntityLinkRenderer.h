@@ -27,6 +27,8 @@
 #include "Renderer/VertexArray.h"
 #include "View/ViewTypes.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
@@ -36,15 +38,30 @@ namespace TrenchBroom {
         class RenderBatch;
         class RenderContext;
         
+        /**
+         Renders the links between entities. The links to render are cached separately from their vertices
+         because in the mode that shows all links, a selection change only changes the colors of the links.
+         */
         class EntityLinkRenderer : public DirectRenderable {
         private:
             typedef VertexSpecs::P3C4::Vertex Vertex;
             
+            struct Link {
+                const Model::AttributableNode* source;
+                const Model::AttributableNode* target;
+                
+                Link(const Model::AttributableNode* i_source, const Model::AttributableNode* i_target);
+            };
+            typedef std::vector<Link> LinkList;
+            
             View::MapDocumentWPtr m_document;
             
             Color m_defaultColor;
             Color m_selectedColor;
             
+            LinkList m_links;
+            bool m_linksValid;
+            
             VertexArray m_entityLinks;
             bool m_valid;
         public:
@@ -55,6 +72,7 @@ namespace TrenchBroom {
             
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+            void invalidateSelection();
         private:
             void doPrepareVertices(Vbo& vertexVbo);
             void doRender(RenderContext& renderContext);
@@ -69,12 +87,14 @@ namespace TrenchBroom {
             class CollectTransitiveSelectedLinksVisitor;
             class CollectDirectSelectedLinksVisitor;
 
-            void getLinks(Vertex::List& links) const;
-            void getAllLinks(Vertex::List& links) const;
-            void getTransitiveSelectedLinks(Vertex::List& links) const;
-            void getDirectSelectedLinks(Vertex::List& links) const;
+            void getLinks(LinkList& links) const;
+            void getAllLinks(LinkList& links) const;
+            void getTransitiveSelectedLinks(LinkList& links) const;
+            void getDirectSelectedLinks(LinkList& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
             
+            void getVertices(const LinkList& links, Vertex::List& vertices) const;
+            
             EntityLinkRenderer(const EntityLinkRenderer& other);
             EntityLinkRenderer& operator=(const EntityLinkRenderer& other);
         };
@@ -29,6 +29,7 @@
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
 #include "Renderer/RenderContext.h"
+#include "Renderer/RenderUtils.h"
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
@@ -36,6 +37,31 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        class EntityModelRenderer::EntityInstanceRenderFunc : public InstanceRenderFunc {
+        private:
+            Transformation& m_transformation;
+            const Model::EntityList& m_entities;
+        public:
+            EntityInstanceRenderFunc(Transformation& transformation, const Model::EntityList& entities) :
+            m_transformation(transformation),
+            m_entities(entities) {}
+            
+            size_t instanceCount() const {
+                return m_entities.size();
+            }
+            
+            void before(const size_t index) {
+                const Model::Entity* entity = m_entities[index];
+                const Mat4x4f translation(translationMatrix(entity->origin()));
+                const Mat4x4f rotation(entity->rotation());
+                m_transformation.pushModelMatrix(translation * rotation);
+            }
+            
+            void after(const size_t index) {
+                m_transformation.popModelMatrix();
+            }
+        };
+        
         EntityModelRenderer::EntityModelRenderer(Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
         m_entityModelManager(entityModelManager),
         m_editorContext(editorContext),
@@ -73,6 +99,7 @@ namespace TrenchBroom {
 
         void EntityModelRenderer::clear() {
             m_entities.clear();
+            m_renderEntities.clear();
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -99,7 +126,8 @@ namespace TrenchBroom {
             m_showHiddenEntities = showHiddenEntities;
         }
 
-        void EntityModelRenderer::render(RenderBatch& renderBatch) {
+        void EntityModelRenderer::render(RenderBatch& renderBatch, const Model::EntityList& entities) {
+            m_renderEntities = entities;
             renderBatch.add(this);
         }
 
@@ -120,20 +148,27 @@ namespace TrenchBroom {
             glAssert(glEnable(GL_TEXTURE_2D));
             glAssert(glActiveTexture(GL_TEXTURE0));
             
-            for (const auto& entry : m_entities) {
-                Model::Entity* entity = entry.first;
-                if (!m_showHiddenEntities && !m_editorContext.visible(entity))
-                    continue;
-                
-                TexturedIndexRangeRenderer* renderer = entry.second;
-                
-                const Mat4x4f translation(translationMatrix(entity->origin()));
-                const Mat4x4f rotation(entity->rotation());
-                const Mat4x4f matrix = translation * rotation;
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), matrix);
+            // entities sharing a model, skin and frame share a renderer, so its vertex array and skin are
+            // only bound once for all of them
+            for (const auto& entry : visibleEntitiesByRenderer()) {
+                TexturedIndexRangeRenderer* renderer = entry.first;
+                const Model::EntityList& entities = entry.second;
                 
-                renderer->render();
+                EntityInstanceRenderFunc func(renderContext.transformation(), entities);
+                renderer->render(func);
+            }
+        }
+
+        EntityModelRenderer::RendererMap EntityModelRenderer::visibleEntitiesByRenderer() const {
+            RendererMap result;
+            for (Model::Entity* entity : m_renderEntities) {
+                if (m_showHiddenEntities || m_editorContext.visible(entity)) {
+                    const EntityMap::const_iterator it = m_entities.find(entity);
+                    if (it != std::end(m_entities))
+                        result[it->second].push_back(entity);
+                }
             }
+            return result;
         }
     }
 }
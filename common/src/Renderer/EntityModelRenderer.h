@@ -46,12 +46,16 @@ namespace TrenchBroom {
         
         class EntityModelRenderer : public DirectRenderable {
         private:
+            class EntityInstanceRenderFunc;
+            
             typedef std::map<Model::Entity*, TexturedIndexRangeRenderer*> EntityMap;
+            typedef std::map<TexturedIndexRangeRenderer*, Model::EntityList> RendererMap;
             
             Assets::EntityModelManager& m_entityModelManager;
             const Model::EditorContext& m_editorContext;
             
             EntityMap m_entities;
+            Model::EntityList m_renderEntities;
             
             bool m_applyTinting;
             Color m_tintColor;
@@ -95,10 +99,15 @@ namespace TrenchBroom {
             bool showHiddenEntities() const;
             void setShowHiddenEntities(bool showHiddenEntities);
             
-            void render(RenderBatch& renderBatch);
+            /**
+             Renders the models of the given entities. Entities which have no model or which were not added to
+             this renderer are ignored.
+             */
+            void render(RenderBatch& renderBatch, const Model::EntityList& entities);
         private:
             void doPrepareVertices(Vbo& vertexVbo);
             void doRender(RenderContext& renderContext);
+            RendererMap visibleEntitiesByRenderer() const;
         };
     }
 }
@@ -67,6 +67,8 @@ namespace TrenchBroom {
         m_editorContext(editorContext),
         m_modelRenderer(m_entityModelManager, m_editorContext),
         m_boundsValid(false),
+        m_modelGeneration(entityModelManager.modelGeneration()),
+        m_cullingGridValid(false),
         m_showOverlays(true),
         m_showOccludedOverlays(false),
         m_tint(false),
@@ -84,12 +86,17 @@ namespace TrenchBroom {
         void EntityRenderer::invalidate() {
             invalidateBounds();
             reloadModels();
+            m_cullingGridValid = false;
         }
 
         void EntityRenderer::clear() {
             m_entities.clear();
+            m_visibleEntities.clear();
+            m_cullingGrid.clear();
+            m_cullingGridValid = false;
             m_wireframeBoundsRenderer = DirectEdgeRenderer();
             m_solidBoundsRenderer = TriangleRenderer();
+            m_impostorRenderer = TriangleRenderer();
             m_modelRenderer.clear();
         }
 
@@ -151,6 +158,8 @@ namespace TrenchBroom {
 
         void EntityRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_entities.empty()) {
+                validateModels();
+                cullEntities(renderContext);
                 renderBounds(renderContext, renderBatch);
                 renderModels(renderContext, renderBatch);
                 renderClassnames(renderContext, renderBatch);
@@ -158,6 +167,45 @@ namespace TrenchBroom {
             }
         }
         
+        size_t EntityRenderer::drawnEntityCount() const {
+            return m_visibleEntities.size();
+        }
+        
+        size_t EntityRenderer::culledEntityCount() const {
+            return m_cullingGrid.entityCount() - m_visibleEntities.size();
+        }
+
+        void EntityRenderer::validateModels() {
+            // entities whose models were still loading are drawn as solid boxes until their models arrive
+            m_entityModelManager.collectLoadedModels();
+            if (m_modelGeneration != m_entityModelManager.modelGeneration()) {
+                m_modelGeneration = m_entityModelManager.modelGeneration();
+                invalidate();
+            }
+        }
+        
+        void EntityRenderer::validateCullingGrid() {
+            if (!m_cullingGridValid) {
+                m_cullingGrid.build(m_entities);
+                m_cullingGridValid = true;
+            }
+        }
+        
+        void EntityRenderer::cullEntities(RenderContext& renderContext) {
+            validateCullingGrid();
+            
+            // the bounds are kept in one vertex array, so only models, labels and angles are culled
+            m_visibleEntities.clear();
+            m_cullingGrid.findEntities(renderContext.camera(), 0.0f, m_visibleEntities);
+        }
+        
+        bool EntityRenderer::withinDistance(RenderContext& renderContext, const Model::Entity* entity, const float maxDistance) const {
+            if (!renderContext.render3D())
+                return true;
+            const Camera& camera = renderContext.camera();
+            return EntityCullingGrid::withinDistance(BBox3f(entity->bounds()), camera.position(), camera.direction(), maxDistance);
+        }
+
         void EntityRenderer::renderBounds(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_boundsValid)
                 validateBounds();
@@ -186,7 +234,24 @@ namespace TrenchBroom {
                 m_modelRenderer.setApplyTinting(m_tint);
                 m_modelRenderer.setTintColor(m_tintColor);
                 m_modelRenderer.setShowHiddenEntities(m_showHiddenEntities);
-                m_modelRenderer.render(renderBatch);
+                
+                // distant models are replaced by boxes because their meshes would only cover a few pixels
+                const float impostorDistance = pref(Preferences::EntityModelImpostorDistance);
+                const float maxDistance = pref(Preferences::EntityModelDrawDistance);
+                
+                Model::EntityList meshEntities;
+                Model::EntityList impostorEntities;
+                meshEntities.reserve(m_visibleEntities.size());
+                
+                for (Model::Entity* entity : m_visibleEntities) {
+                    if (withinDistance(renderContext, entity, impostorDistance))
+                        meshEntities.push_back(entity);
+                    else if (withinDistance(renderContext, entity, maxDistance))
+                        impostorEntities.push_back(entity);
+                }
+                
+                m_modelRenderer.render(renderBatch, meshEntities);
+                renderImpostors(renderBatch, impostorEntities);
             }
         }
         
@@ -196,8 +261,10 @@ namespace TrenchBroom {
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
                 
-                for (const Model::Entity* entity : m_entities) {
-                    if (m_showHiddenEntities || m_editorContext.visible(entity)) {
+                // labels drawn on top of other objects are not faded out with the distance
+                const float maxDistance = m_showOccludedOverlays ? 0.0f : pref(Preferences::EntityLabelDrawDistance);
+                for (const Model::Entity* entity : m_visibleEntities) {
+                    if ((m_showHiddenEntities || m_editorContext.visible(entity)) && withinDistance(renderContext, entity, maxDistance)) {
                         if (m_showOccludedOverlays)
                             renderService.setShowOccludedObjects();
                         else
@@ -220,7 +287,7 @@ namespace TrenchBroom {
             renderService.setForegroundColor(m_angleColor);
             
             Vec3f::List vertices(3);
-            for (const Model::Entity* entity : m_entities) {
+            for (const Model::Entity* entity : m_visibleEntities) {
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity))
                     continue;
                 
@@ -346,6 +413,23 @@ namespace TrenchBroom {
             m_boundsValid = true;
         }
 
+        void EntityRenderer::renderImpostors(RenderBatch& renderBatch, const Model::EntityList& entities) {
+            VertexSpecs::P3NC4::Vertex::List vertices;
+            for (const Model::Entity* entity : entities) {
+                if ((m_showHiddenEntities || m_editorContext.visible(entity)) && m_entityModelManager.hasModel(entity)) {
+                    BuildColoredSolidBoundsVertices builder(vertices, boundsColor(entity));
+                    eachBBoxFace(entity->bounds(), builder);
+                }
+            }
+            
+            if (!vertices.empty()) {
+                m_impostorRenderer = TriangleRenderer(VertexArray::swap(vertices), GL_QUADS);
+                m_impostorRenderer.setApplyTinting(m_tint);
+                m_impostorRenderer.setTintColor(m_tintColor);
+                renderBatch.add(&m_impostorRenderer);
+            }
+        }
+
         AttrString EntityRenderer::entityString(const Model::Entity* entity) const {
             const Model::AttributeValue& classname = entity->classname();
             // const Model::AttributeValue& targetname = entity->attribute(Model::AttributeNames::Targetname);
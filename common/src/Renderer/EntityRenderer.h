@@ -24,6 +24,7 @@
 #include "Color.h"
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
+#include "Renderer/EntityCullingGrid.h"
 #include "Renderer/EntityModelRenderer.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
@@ -56,7 +57,13 @@ namespace TrenchBroom {
             DirectEdgeRenderer m_wireframeBoundsRenderer;
             TriangleRenderer m_solidBoundsRenderer;
             EntityModelRenderer m_modelRenderer;
+            TriangleRenderer m_impostorRenderer;
             bool m_boundsValid;
+            size_t m_modelGeneration;
+            
+            EntityCullingGrid m_cullingGrid;
+            bool m_cullingGridValid;
+            Model::EntityList m_visibleEntities;
             
             bool m_showOverlays;
             Color m_overlayTextColor;
@@ -99,11 +106,20 @@ namespace TrenchBroom {
             void setShowHiddenEntities(bool showHiddenEntities);
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
+            
+            // the number of entities inside and outside of the view frustum in the last call to render
+            size_t drawnEntityCount() const;
+            size_t culledEntityCount() const;
         private:
+            void validateModels();
+            void validateCullingGrid();
+            void cullEntities(RenderContext& renderContext);
+            bool withinDistance(RenderContext& renderContext, const Model::Entity* entity, float maxDistance) const;
             void renderBounds(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderWireframeBounds(RenderBatch& renderBatch);
             void renderSolidBounds(RenderBatch& renderBatch);
             void renderModels(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderImpostors(RenderBatch& renderBatch, const Model::EntityList& entities);
             void renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
             Vec3f::List arrowHead(float length, float width) const;
@@ -174,6 +174,12 @@ namespace TrenchBroom {
     
     Func2<GLint, GLuint, const GLchar*> glGetUniformLocation;
     
+    Func0<GLboolean> glTimerQueriesAvailable;
+    Func2<void, GLsizei, GLuint*> glGenQueries;
+    Func2<void, GLuint, GLenum> glQueryCounter;
+    Func3<void, GLuint, GLenum, GLint*> glGetQueryObjectiv;
+    Func3<void, GLuint, GLenum, GLuint64*> glGetQueryObjectui64v;
+    
 #ifdef __APPLE__
     Func2<void, GLenum, GLint> glFinishObjectAPPLE;
 #endif
@@ -25,6 +25,7 @@
 #include "StringUtils.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace TrenchBroom {
@@ -172,6 +173,10 @@ namespace TrenchBroom {
 #define GL_INFO_LOG_LENGTH 0x8B84
 #define GL_CURRENT_PROGRAM 0x8B8D
 
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GL_TIMESTAMP 0x8E28
+
     typedef unsigned int GLenum;
     typedef unsigned int GLbitfield;
     typedef int GLsizei;
@@ -196,6 +201,8 @@ namespace TrenchBroom {
     typedef ptrdiff_t GLintptr;
     typedef ptrdiff_t GLsizeiptr;
     
+    typedef uint64_t GLuint64;
+    
     typedef char GLchar;
     typedef GLenum PrimType;
     
@@ -361,6 +368,12 @@ namespace TrenchBroom {
     extern Func4<void, GLint, GLsizei, GLboolean, const GLfloat*> glUniformMatrix4x3fv;
     
     extern Func2<GLint, GLuint, const GLchar*> glGetUniformLocation;
+    
+    extern Func0<GLboolean> glTimerQueriesAvailable;
+    extern Func2<void, GLsizei, GLuint*> glGenQueries;
+    extern Func2<void, GLuint, GLenum> glQueryCounter;
+    extern Func3<void, GLuint, GLenum, GLint*> glGetQueryObjectiv;
+    extern Func3<void, GLuint, GLenum, GLuint64*> glGetQueryObjectui64v;
 
 #ifdef __APPLE__
     extern Func2<void, GLenum, GLint> glFinishObjectAPPLE;
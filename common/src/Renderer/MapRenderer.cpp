@@ -207,15 +207,35 @@ namespace TrenchBroom {
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             commitPendingChanges();
             setupGL(renderBatch);
+            
+            renderBatch.beginProfilerSection("Default opaque");
             renderDefaultOpaque(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Locked opaque");
             renderLockedOpaque(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Selection opaque");
             renderSelectionOpaque(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
             
+            renderBatch.beginProfilerSection("Default transparent");
             renderDefaultTransparent(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Locked transparent");
             renderLockedTransparent(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Selection transparent");
             renderSelectionTransparent(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
             
+            renderBatch.beginProfilerSection("Entity links");
             renderEntityLinks(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
             renderTutorialMessages(renderContext, renderBatch);
         }
         
@@ -464,7 +484,6 @@ namespace TrenchBroom {
                                              collect.lockedNodes().entities(),
                                              collect.lockedNodes().brushes());
             }
-            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::invalidateRenderers(Renderer renderers) {
@@ -544,14 +563,17 @@ namespace TrenchBroom {
         void MapRenderer::documentWasNewedOrLoaded(View::MapDocument* document) {
             clear();
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesWereAdded(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesWereRemoved(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodesDidChange(const Model::NodeList& nodes) {
@@ -561,18 +583,22 @@ namespace TrenchBroom {
         
         void MapRenderer::nodeVisibilityDidChange(const Model::NodeList& nodes) {
             updateRenderers(Renderer_All);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::nodeLockingDidChange(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default_Locked);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::groupWasOpened(Model::Group* group) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
         
         void MapRenderer::groupWasClosed(Model::Group* group) {
             updateRenderers(Renderer_Default_Selection);
+            invalidateEntityLinkRenderer();
         }
 
         void MapRenderer::brushFacesDidChange(const Model::BrushFaceList& faces) {
@@ -581,6 +607,7 @@ namespace TrenchBroom {
         
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
             updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
+            m_entityLinkRenderer->invalidateSelection();
         }
         
         Model::BrushSet MapRenderer::collectBrushes(const Model::BrushFaceList& faces) {
@@ -22,6 +22,7 @@
 #include "Model/Group.h"
 #include "Model/Node.h"
 #include "Model/NodeVisitor.h"
+#include "Renderer/RenderBatch.h"
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -132,9 +133,17 @@ namespace TrenchBroom {
         }
 
         void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
+            renderBatch.beginProfilerSection("Brushes");
             m_brushRenderer.renderOpaque(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Entities");
             m_entityRenderer.render(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
+            
+            renderBatch.beginProfilerSection("Groups");
             m_groupRenderer.render(renderContext, renderBatch);
+            renderBatch.endProfilerSection();
         }
         
         void ObjectRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Vbo.h"
 
 namespace TrenchBroom {
@@ -50,9 +51,36 @@ namespace TrenchBroom {
             }
         };
         
-        RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo) :
+        class RenderBatch::BeginProfilerSection : public Renderable {
+        private:
+            RenderProfiler& m_profiler;
+            String m_name;
+        public:
+            BeginProfilerSection(RenderProfiler& profiler, const String& name) :
+            m_profiler(profiler),
+            m_name(name) {}
+        private:
+            void doRender(RenderContext& renderContext) {
+                m_profiler.beginSection(m_name);
+            }
+        };
+        
+        class RenderBatch::EndProfilerSection : public Renderable {
+        private:
+            RenderProfiler& m_profiler;
+        public:
+            EndProfilerSection(RenderProfiler& profiler) :
+            m_profiler(profiler) {}
+        private:
+            void doRender(RenderContext& renderContext) {
+                m_profiler.endSection();
+            }
+        };
+        
+        RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, RenderProfiler* profiler) :
         m_vertexVbo(vertexVbo),
-        m_indexVbo(indexVbo) {}
+        m_indexVbo(indexVbo),
+        m_profiler(profiler) {}
         
         RenderBatch::~RenderBatch() {
             ListUtils::clearAndDelete(m_oneshots);
@@ -93,6 +121,16 @@ namespace TrenchBroom {
             m_oneshots.push_back(renderable);
         }
         
+        void RenderBatch::beginProfilerSection(const String& name) {
+            if (m_profiler != NULL)
+                addOneShot(new BeginProfilerSection(*m_profiler, name));
+        }
+        
+        void RenderBatch::endProfilerSection() {
+            if (m_profiler != NULL)
+                addOneShot(new EndProfilerSection(*m_profiler));
+        }
+        
         void RenderBatch::render(RenderContext& renderContext) {
             ActivateVbo activate(m_vertexVbo);
 
@@ -111,6 +149,7 @@ namespace TrenchBroom {
         }
         
         void RenderBatch::prepareVertices() {
+            RenderProfiler::Scope scope(m_profiler, "Prepare vertices");
             ActivateVbo activate(m_vertexVbo);
             
             for (DirectRenderable* renderable : m_directRenderables)
@@ -121,6 +160,7 @@ namespace TrenchBroom {
         }
         
         void RenderBatch::prepareIndices() {
+            RenderProfiler::Scope scope(m_profiler, "Prepare indices");
             ActivateVbo activate(m_indexVbo);
             
             for (IndexedRenderable* renderable : m_indexedRenderables)
@@ -128,6 +168,7 @@ namespace TrenchBroom {
         }
 
         void RenderBatch::renderRenderables(RenderContext& renderContext) {
+            RenderProfiler::Scope scope(m_profiler, "Render");
             for (Renderable* renderable : m_batch)
                 renderable->render(renderContext);
         }
@@ -21,6 +21,7 @@
 #define TrenchBroom_RenderBatch
 
 #include "TrenchBroom.h"
+#include "StringUtils.h"
 #include "VecMath.h"
 #include "Color.h"
 
@@ -32,14 +33,18 @@ namespace TrenchBroom {
         class DirectRenderable;
         class IndexedRenderable;
         class RenderContext;
+        class RenderProfiler;
         class Vbo;
         
         class RenderBatch {
         private:
             Vbo& m_vertexVbo;
             Vbo& m_indexVbo;
+            RenderProfiler* m_profiler;
 
             class IndexedRenderableWrapper;
+            class BeginProfilerSection;
+            class EndProfilerSection;
             
             typedef std::list<Renderable*> RenderableList;
             typedef std::list<DirectRenderable*> DirectRenderableList;
@@ -51,7 +56,7 @@ namespace TrenchBroom {
             RenderableList m_batch;
             RenderableList m_oneshots;
         public:
-            RenderBatch(Vbo& vertexVbo, Vbo& indexVbo);
+            RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, RenderProfiler* profiler = NULL);
             ~RenderBatch();
             
             void add(Renderable* renderable);
@@ -62,6 +67,13 @@ namespace TrenchBroom {
             void addOneShot(DirectRenderable* renderable);
             void addOneShot(IndexedRenderable* renderable);
             
+            /**
+             Opens or closes a profiler section at the current position of the batch so that the renderables
+             added in between are measured when the batch is rendered. Does nothing without a profiler.
+             */
+            void beginProfilerSection(const String& name);
+            void endProfilerSection();
+            
             void render(RenderContext& renderContext);
         private:
             void doAdd(Renderable* renderable);
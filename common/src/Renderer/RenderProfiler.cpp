@@ -0,0 +1,263 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RenderProfiler.h"
+
+#include <cassert>
+#include <iomanip>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        RenderProfiler::Counters::Counters() :
+        drawCalls(0),
+        vertices(0),
+        uploadedBytes(0),
+        textureBinds(0) {}
+        
+        RenderProfiler::Counters RenderProfiler::Counters::operator-(const Counters& other) const {
+            Counters result;
+            result.drawCalls = drawCalls - other.drawCalls;
+            result.vertices = vertices - other.vertices;
+            result.uploadedBytes = uploadedBytes - other.uploadedBytes;
+            result.textureBinds = textureBinds - other.textureBinds;
+            return result;
+        }
+
+        RenderProfiler::Section::Section(const String& i_name, const size_t i_depth) :
+        name(i_name),
+        depth(i_depth),
+        cpuTime(0.0),
+        gpuTime(-1.0) {}
+        
+        bool RenderProfiler::Section::hasGpuTime() const {
+            return gpuTime >= 0.0;
+        }
+
+        String RenderProfiler::Section::asString() const {
+            StringStream str;
+            str << String(2 * depth, ' ') << name << ": " << std::fixed << std::setprecision(2) << cpuTime << " ms CPU, ";
+            if (hasGpuTime())
+                str << gpuTime << " ms GPU, ";
+            else
+                str << "n/a GPU, ";
+            str << counters.drawCalls << " draw calls, " << counters.vertices << " vertices, " << counters.uploadedBytes << " bytes uploaded, " << counters.textureBinds << " texture binds";
+            return str.str();
+        }
+
+        RenderProfiler::Scope::Scope(RenderProfiler* profiler, const String& name) :
+        m_profiler(profiler) {
+            if (m_profiler != NULL)
+                m_profiler->beginSection(name);
+        }
+        
+        RenderProfiler::Scope::~Scope() {
+            if (m_profiler != NULL)
+                m_profiler->endSection();
+        }
+
+        RenderProfiler::Counters RenderProfiler::s_counters;
+        
+        void RenderProfiler::countDrawCall(const size_t vertexCount) {
+            ++s_counters.drawCalls;
+            s_counters.vertices += vertexCount;
+        }
+        
+        void RenderProfiler::countUpload(const size_t bytes) {
+            s_counters.uploadedBytes += bytes;
+        }
+        
+        void RenderProfiler::countTextureBind() {
+            ++s_counters.textureBinds;
+        }
+
+        const RenderProfiler::Counters& RenderProfiler::counters() {
+            return s_counters;
+        }
+
+        RenderProfiler::RenderProfiler() :
+        m_enabled(false),
+        m_gpuTiming(false) {}
+        
+        bool RenderProfiler::enabled() const {
+            return m_enabled;
+        }
+        
+        void RenderProfiler::setEnabled(const bool enabled) {
+            assert(!inFrame());
+            m_enabled = enabled;
+            
+            // the query objects stay with their contexts, so only the frames are dropped
+            for (auto& entry : m_views) {
+                ViewState& state = entry.second;
+                state.lastFrame.clear();
+                for (const Frame& frame : state.pendingFrames)
+                    state.freeQueries.insert(std::end(state.freeQueries), std::begin(frame.queries), std::end(frame.queries));
+                state.pendingFrames.clear();
+            }
+        }
+
+        bool RenderProfiler::gpuTiming() const {
+            return m_gpuTiming;
+        }
+        
+        void RenderProfiler::setGpuTiming(const bool gpuTiming) {
+            assert(!inFrame());
+            m_gpuTiming = gpuTiming;
+        }
+
+        void RenderProfiler::beginFrame(const String& view) {
+            if (!m_enabled)
+                return;
+            
+            assert(!inFrame());
+            collectPendingFrames(m_views[view]);
+            
+            m_currentFrame = Frame();
+            m_currentFrame.view = view;
+            beginSection("Frame");
+        }
+        
+        void RenderProfiler::endFrame() {
+            if (!inFrame())
+                return;
+            
+            while (!m_currentFrame.openSections.empty())
+                endSection();
+            
+            ViewState& state = m_views[m_currentFrame.view];
+            if (m_gpuTiming) {
+                state.pendingFrames.push_back(m_currentFrame);
+            } else {
+                state.lastFrame = m_currentFrame.sections;
+            }
+            m_currentFrame = Frame();
+        }
+        
+        void RenderProfiler::beginSection(const String& name) {
+            if (!m_enabled || m_currentFrame.view.empty())
+                return;
+            
+            const size_t index = m_currentFrame.sections.size();
+            m_currentFrame.sections.push_back(Section(name, m_currentFrame.openSections.size()));
+            m_currentFrame.openSections.push_back(index);
+            m_currentFrame.startCounters.push_back(s_counters);
+            
+            if (m_gpuTiming) {
+                ViewState& state = m_views[m_currentFrame.view];
+                const GLuint startQuery = acquireQuery(state);
+                const GLuint endQuery = acquireQuery(state);
+                glAssert(glQueryCounter(startQuery, GL_TIMESTAMP));
+                m_currentFrame.queries.push_back(startQuery);
+                m_currentFrame.queries.push_back(endQuery);
+            }
+            
+            // take the start time last so that the profiler's own work is not counted
+            m_currentFrame.startTimes.push_back(Clock::now());
+        }
+        
+        void RenderProfiler::endSection() {
+            if (!inFrame())
+                return;
+            
+            const Clock::time_point endTime = Clock::now();
+            const size_t index = m_currentFrame.openSections.back();
+            m_currentFrame.openSections.pop_back();
+            
+            Section& section = m_currentFrame.sections[index];
+            section.cpuTime = std::chrono::duration<double, std::milli>(endTime - m_currentFrame.startTimes[index]).count();
+            section.counters = s_counters - m_currentFrame.startCounters[index];
+            
+            if (m_gpuTiming)
+                glAssert(glQueryCounter(m_currentFrame.queries[2 * index + 1], GL_TIMESTAMP));
+        }
+
+        StringList RenderProfiler::views() const {
+            StringList result;
+            for (const auto& entry : m_views) {
+                if (!entry.second.lastFrame.empty())
+                    result.push_back(entry.first);
+            }
+            return result;
+        }
+
+        const RenderProfiler::SectionList& RenderProfiler::lastFrame(const String& view) const {
+            static const SectionList EmptyFrame;
+            
+            ViewStateMap::const_iterator it = m_views.find(view);
+            if (it == std::end(m_views))
+                return EmptyFrame;
+            return it->second.lastFrame;
+        }
+
+        String RenderProfiler::asString() const {
+            StringStream str;
+            for (const auto& entry : m_views) {
+                const SectionList& sections = entry.second.lastFrame;
+                if (!sections.empty()) {
+                    str << entry.first << std::endl;
+                    for (const Section& section : sections)
+                        str << section.asString() << std::endl;
+                    str << std::endl;
+                }
+            }
+            return str.str();
+        }
+
+        bool RenderProfiler::inFrame() const {
+            return !m_currentFrame.openSections.empty();
+        }
+
+        void RenderProfiler::collectPendingFrames(ViewState& state) {
+            while (!state.pendingFrames.empty()) {
+                Frame& frame = state.pendingFrames.front();
+                assert(frame.queries.size() == 2 * frame.sections.size());
+                
+                // the end query of the frame section was issued last, so all others are available once it is
+                GLint available = 0;
+                glAssert(glGetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &available));
+                if (available == 0)
+                    return;
+                
+                for (size_t i = 0; i < frame.sections.size(); ++i) {
+                    GLuint64 start = 0;
+                    GLuint64 end = 0;
+                    glAssert(glGetQueryObjectui64v(frame.queries[2 * i], GL_QUERY_RESULT, &start));
+                    glAssert(glGetQueryObjectui64v(frame.queries[2 * i + 1], GL_QUERY_RESULT, &end));
+                    frame.sections[i].gpuTime = end >= start ? static_cast<double>(end - start) / 1000000.0 : 0.0;
+                }
+                
+                state.lastFrame = frame.sections;
+                state.freeQueries.insert(std::end(state.freeQueries), std::begin(frame.queries), std::end(frame.queries));
+                state.pendingFrames.pop_front();
+            }
+        }
+
+        GLuint RenderProfiler::acquireQuery(ViewState& state) {
+            if (state.freeQueries.empty()) {
+                GLuint query = 0;
+                glAssert(glGenQueries(1, &query));
+                return query;
+            }
+            
+            const GLuint query = state.freeQueries.back();
+            state.freeQueries.pop_back();
+            return query;
+        }
+    }
+}
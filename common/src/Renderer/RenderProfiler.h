@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_RenderProfiler
+#define TrenchBroom_RenderProfiler
+
+#include "StringUtils.h"
+#include "Renderer/GL.h"
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        /**
+         Measures where the time of a frame goes. A frame is divided into nested, named sections, and for
+         each section, the profiler records the CPU time, the GPU time (if timer queries are available),
+         and the number of draw calls, vertices, uploaded bytes and texture binds issued while it was open.
+         
+         The GPU times are only known once the GPU has finished the frame, so they are collected when the
+         next frame of the same view begins. Timer queries are not shared between GL contexts, which is
+         why the profiler keeps separate state for each view.
+         */
+        class RenderProfiler {
+        public:
+            struct Counters {
+                size_t drawCalls;
+                size_t vertices;
+                size_t uploadedBytes;
+                size_t textureBinds;
+                
+                Counters();
+                Counters operator-(const Counters& other) const;
+            };
+            
+            struct Section {
+                String name;
+                size_t depth;
+                double cpuTime;
+                double gpuTime;
+                Counters counters;
+                
+                Section(const String& i_name, size_t i_depth);
+                bool hasGpuTime() const;
+                String asString() const;
+            };
+            typedef std::vector<Section> SectionList;
+            
+            /**
+             Opens a section on construction and closes it on destruction. Does nothing if the given
+             profiler is null.
+             */
+            class Scope {
+            private:
+                RenderProfiler* m_profiler;
+            public:
+                Scope(RenderProfiler* profiler, const String& name);
+                ~Scope();
+            };
+        private:
+            typedef std::chrono::steady_clock Clock;
+            typedef std::vector<GLuint> QueryList;
+            
+            struct Frame {
+                String view;
+                SectionList sections;
+                std::vector<Clock::time_point> startTimes;
+                std::vector<Counters> startCounters;
+                std::vector<size_t> openSections;
+                QueryList queries;
+            };
+            typedef std::list<Frame> FrameList;
+            
+            struct ViewState {
+                SectionList lastFrame;
+                FrameList pendingFrames;
+                QueryList freeQueries;
+            };
+            typedef std::map<String, ViewState> ViewStateMap;
+            
+            static Counters s_counters;
+            
+            bool m_enabled;
+            bool m_gpuTiming;
+            Frame m_currentFrame;
+            ViewStateMap m_views;
+        public:
+            static void countDrawCall(size_t vertexCount);
+            static void countUpload(size_t bytes);
+            static void countTextureBind();
+            static const Counters& counters();
+            
+            RenderProfiler();
+            
+            bool enabled() const;
+            void setEnabled(bool enabled);
+            
+            bool gpuTiming() const;
+            void setGpuTiming(bool gpuTiming);
+            
+            void beginFrame(const String& view);
+            void endFrame();
+            
+            void beginSection(const String& name);
+            void endSection();
+            
+            StringList views() const;
+            const SectionList& lastFrame(const String& view) const;
+            String asString() const;
+        private:
+            bool inFrame() const;
+            void collectPendingFrames(ViewState& state);
+            GLuint acquireQuery(ViewState& state);
+            
+            RenderProfiler(const RenderProfiler& other);
+            RenderProfiler& operator=(const RenderProfiler& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_RenderProfiler) */
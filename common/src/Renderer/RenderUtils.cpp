@@ -66,6 +66,10 @@ namespace TrenchBroom {
                 texture->deactivate();
         }
 
+        InstanceRenderFunc::~InstanceRenderFunc() {}
+        void InstanceRenderFunc::before(const size_t index) {}
+        void InstanceRenderFunc::after(const size_t index) {}
+
         Vec2f::List circle2D(const float radius, const size_t segments) {
             Vec2f::List vertices = circle2D(radius, 0.0f, Math::Cf::twoPi(), segments);
             vertices.push_back(Vec2f::Null);
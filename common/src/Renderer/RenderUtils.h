@@ -54,6 +54,15 @@ namespace TrenchBroom {
             void before(const Assets::Texture* texture);
             void after(const Assets::Texture* texture);
         };
+        
+        // Renders the same geometry several times, e.g. once per entity that uses a model.
+        class InstanceRenderFunc {
+        public:
+            virtual ~InstanceRenderFunc();
+            virtual size_t instanceCount() const = 0;
+            virtual void before(size_t index);
+            virtual void after(size_t index);
+        };
 
         Vec2f::List circle2D(float radius, size_t segments);
         Vec2f::List circle2D(float radius, float startAngle, float angleLength, size_t segments);
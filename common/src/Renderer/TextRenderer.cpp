@@ -72,15 +72,19 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
             
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            if (!isInRange(renderContext, distance, onTop))
                 return;
             
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
+            const TextureFont::Layout& layout = font.layout(string, true);
+            
+            const Vec2f& size = layout.size;
+            if (!isVisible(renderContext, size, position))
+                return;
 
-            Vec2f::List vertices = font.quads(string, true);
+            Vec2f::List vertices = layout.vertices;
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const Vec2f size = font.measure(string);
             const Vec3f offset = position.offset(camera, size);
             
             if (onTop)
@@ -93,18 +97,21 @@ namespace TrenchBroom {
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isInRange(RenderContext& renderContext, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
                 if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
                     return false;
             }
-            
+            return true;
+        }
+        
+        bool TextRenderer::isVisible(RenderContext& renderContext, const Vec2f& stringSize, const TextAnchor& position) const {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.unzoomedViewport();
             
-            const Vec2f size = stringSize(renderContext, string);
+            const Vec2f size = stringSize.rounded();
             const Vec2f offset = Vec2f(position.offset(camera, size)) - m_inset;
             const Vec2f actualSize = size + 2.0f * m_inset;
             
@@ -135,12 +142,6 @@ namespace TrenchBroom {
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
         }
         
-        Vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return font.measure(string).rounded();
-        }
-
         void TextRenderer::doPrepareVertices(Vbo& vertexVbo) {
             prepare(m_entries, false, vertexVbo);
             prepare(m_entriesOnTop, true, vertexVbo);
@@ -23,6 +23,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedLayouts = 4096;
+        
         TextureFont::TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, const size_t lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(texture),
         m_glyphs(glyphs),
@@ -166,6 +168,21 @@ namespace TrenchBroom {
             return measureString.size();
         }
 
+        const TextureFont::Layout& TextureFont::layout(const AttrString& string, const bool clockwise) {
+            const LayoutKey key(string, clockwise);
+            LayoutCache::iterator it = m_layoutCache.find(key);
+            if (it != std::end(m_layoutCache))
+                return it->second;
+            
+            if (m_layoutCache.size() >= MaxCachedLayouts)
+                m_layoutCache.clear();
+            
+            Layout& layout = m_layoutCache[key];
+            layout.vertices = quads(string, clockwise);
+            layout.size = measure(string);
+            return layout;
+        }
+
         Vec2f::List TextureFont::quads(const String& string, const bool clockwise, const Vec2f& offset) {
             Vec2f::List result;
             result.reserve(string.length() * 4 * 2);
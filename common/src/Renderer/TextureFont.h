@@ -26,6 +26,7 @@
 #include "Renderer/FontGlyph.h"
 #include "Renderer/FontGlyphBuilder.h"
 
+#include <map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -34,19 +35,37 @@ namespace TrenchBroom {
         
         class TextureFont {
         public:
+            struct Layout {
+                Vec2f::List vertices;
+                Vec2f size;
+            };
         private:
+            static const size_t MaxCachedLayouts;
+            
+            typedef std::pair<AttrString, bool> LayoutKey;
+            typedef std::map<LayoutKey, Layout> LayoutCache;
+            
             FontTexture* m_texture;
             FontGlyph::List m_glyphs;
             size_t m_lineHeight;
             
             unsigned char m_firstChar;
             unsigned char m_charCount;
+            
+            LayoutCache m_layoutCache;
         public:
             TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, size_t lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
             
             Vec2f::List quads(const AttrString& string, bool clockwise, const Vec2f& offset = Vec2f::Null);
             Vec2f measure(const AttrString& string);
+            
+            /**
+             Returns the quads and the size of the given string. The result is cached because labels such as
+             entity classnames are laid out again every frame while their text rarely changes. The returned
+             reference is only valid until the next call to this function.
+             */
+            const Layout& layout(const AttrString& string, bool clockwise);
 
             Vec2f::List quads(const String& string, bool clockwise, const Vec2f& offset = Vec2f::Null);
             Vec2f measure(const String& string);
@@ -102,6 +102,22 @@ namespace TrenchBroom {
             }
         }
 
+        void TexturedIndexRangeMap::render(VertexArray& vertexArray, TextureRenderFunc& func, InstanceRenderFunc& instanceFunc) {
+            const size_t instanceCount = instanceFunc.instanceCount();
+            for (const auto& entry : *m_data) {
+                const Texture* texture = entry.first;
+                const IndexRangeMap& indexArray = entry.second;
+                
+                func.before(texture);
+                for (size_t i = 0; i < instanceCount; ++i) {
+                    instanceFunc.before(i);
+                    indexArray.render(vertexArray);
+                    instanceFunc.after(i);
+                }
+                func.after(texture);
+            }
+        }
+
         IndexRangeMap& TexturedIndexRangeMap::findCurrent(const Texture* texture) {
             if (!isCurrent(texture))
                 m_current = m_data->find(texture);
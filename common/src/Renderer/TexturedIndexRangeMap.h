@@ -31,6 +31,7 @@ namespace TrenchBroom {
     }
     
     namespace Renderer {
+        class InstanceRenderFunc;
         class TextureRenderFunc;
         class VertexArray;
         
@@ -70,6 +71,7 @@ namespace TrenchBroom {
             
             void render(VertexArray& vertexArray);
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
+            void render(VertexArray& vertexArray, TextureRenderFunc& func, InstanceRenderFunc& instanceFunc);
         private:
             IndexRangeMap& findCurrent(const Texture* texture);
             bool isCurrent(const Texture* texture) const;
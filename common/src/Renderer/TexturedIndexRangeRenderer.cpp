@@ -19,6 +19,8 @@
 
 #include "TexturedIndexRangeRenderer.h"
 
+#include "Renderer/RenderUtils.h"
+
 namespace TrenchBroom {
     namespace Renderer {
         TexturedIndexRangeRenderer::TexturedIndexRangeRenderer() {}
@@ -52,5 +54,13 @@ namespace TrenchBroom {
                 m_vertexArray.cleanup();
             }
         }
+
+        void TexturedIndexRangeRenderer::render(InstanceRenderFunc& instanceFunc) {
+            if (instanceFunc.instanceCount() > 0 && m_vertexArray.setup()) {
+                DefaultTextureRenderFunc func;
+                m_indexRange.render(m_vertexArray, func, instanceFunc);
+                m_vertexArray.cleanup();
+            }
+        }
     }
 }
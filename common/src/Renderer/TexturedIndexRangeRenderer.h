@@ -30,6 +30,7 @@ namespace TrenchBroom {
     
     namespace Renderer {
         class Vbo;
+        class InstanceRenderFunc;
         class TextureRenderFunc;
         
         class TexturedIndexRangeRenderer {
@@ -46,6 +47,7 @@ namespace TrenchBroom {
             void prepare(Vbo& vbo);
             void render();
             void render(TextureRenderFunc& func);
+            void render(InstanceRenderFunc& instanceFunc);
         };
     }
 }
@@ -20,6 +20,7 @@
 #include "Vbo.h"
 
 #include "Exceptions.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/VboBlock.h"
 
 #include <algorithm>
@@ -107,6 +108,23 @@ namespace TrenchBroom {
             return block;
         }
 
+        size_t Vbo::totalCapacity() const {
+            return m_totalCapacity;
+        }
+        
+        size_t Vbo::freeCapacity() const {
+            return m_freeCapacity;
+        }
+        
+        size_t Vbo::usedBlockCount() const {
+            size_t result = 0;
+            for (const VboBlock* block = m_firstBlock; block != NULL; block = block->m_next) {
+                if (!block->isFree())
+                    ++result;
+            }
+            return result;
+        }
+        
         bool Vbo::active() const {
             return m_state > State_Inactive;
         }
@@ -231,6 +249,7 @@ namespace TrenchBroom {
                 buffer = map();
                 
                 memcpy(buffer + begin, temp, end - begin);
+                RenderProfiler::countUpload(end - begin);
                 delete [] temp;
                 
                 unmap();
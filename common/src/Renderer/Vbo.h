@@ -76,6 +76,10 @@ namespace TrenchBroom {
             ~Vbo();
             
             VboBlock* allocateBlock(const size_t capacity);
+            
+            size_t totalCapacity() const;
+            size_t freeCapacity() const;
+            size_t usedBlockCount() const;
 
             bool active() const;
             void activate();
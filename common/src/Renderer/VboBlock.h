@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_VboBlock
 #define TrenchBroom_VboBlock
 
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/Vbo.h"
 
 #include <cstring>
@@ -75,6 +76,7 @@ namespace TrenchBroom {
                 const GLintptr offset = static_cast<GLintptr>(m_offset + address);
                 const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
                 glAssert(glBufferSubData(m_vbo.type(), offset, sizei, ptr));
+                RenderProfiler::countUpload(size);
                 
                 return size;
             }
@@ -19,6 +19,8 @@
 
 #include "VertexArray.h"
 
+#include "Renderer/RenderProfiler.h"
+
 #include <cassert>
 #include <limits>
 
@@ -97,10 +99,12 @@ namespace TrenchBroom {
             if (!m_setup) {
                 if (setup()) {
                     glAssert(glDrawArrays(primType, index, count));
+                    RenderProfiler::countDrawCall(static_cast<size_t>(count));
                     cleanup();
                 }
             } else {
                 glAssert(glDrawArrays(primType, index, count));
+                RenderProfiler::countDrawCall(static_cast<size_t>(count));
             }
         }
 
@@ -111,14 +115,15 @@ namespace TrenchBroom {
                     const GLint* indexArray   = indices.data();
                     const GLsizei* countArray = counts.data();
                     glAssert(glMultiDrawArrays(primType, indexArray, countArray, primCount));
+                    countMultiDrawCall(counts, primCount);
                     cleanup();
                 }
             } else {
                 const GLint* indexArray   = indices.data();
                 const GLsizei* countArray = counts.data();
                 glAssert(glMultiDrawArrays(primType, indexArray, countArray, primCount));
+                countMultiDrawCall(counts, primCount);
             }
-            
         }
 
         void VertexArray::render(const PrimType primType, const GLIndices& indices, const GLsizei count) {
@@ -127,14 +132,23 @@ namespace TrenchBroom {
                 if (setup()) {
                     const GLint* indexArray = indices.data();
                     glAssert(glDrawElements(primType, count, GL_UNSIGNED_INT, indexArray));
+                    RenderProfiler::countDrawCall(static_cast<size_t>(count));
                     cleanup();
                 }
             } else {
                 const GLint* indexArray = indices.data();
                 glAssert(glDrawElements(primType, count, GL_UNSIGNED_INT, indexArray));
+                RenderProfiler::countDrawCall(static_cast<size_t>(count));
             }
         }
 
+        void VertexArray::countMultiDrawCall(const GLCounts& counts, const GLint primCount) {
+            size_t vertexCount = 0;
+            for (GLint i = 0; i < primCount; ++i)
+                vertexCount += static_cast<size_t>(counts[static_cast<size_t>(i)]);
+            RenderProfiler::countDrawCall(vertexCount);
+        }
+
         VertexArray::VertexArray(BaseHolder::Ptr holder) :
         m_holder(holder),
         m_prepared(false),
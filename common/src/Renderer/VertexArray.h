@@ -270,6 +270,8 @@ namespace TrenchBroom {
             void cleanup();
         private:
             VertexArray(BaseHolder::Ptr holder);
+            
+            static void countMultiDrawCall(const GLCounts& counts, GLint primCount);
         };
     }
 }
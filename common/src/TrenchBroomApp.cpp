@@ -236,6 +236,10 @@ namespace TrenchBroom {
 
                 frame->openDocument(game, mapFormat, path);
                 return true;
+            } catch (const OperationCancelledException&) {
+                if (frame != NULL)
+                    frame->Close();
+                return false;
             } catch (const FileNotFoundException& e) {
                 m_recentDocuments->removePath(IO::Path(path));
                 if (frame != NULL)
@@ -267,6 +267,9 @@ namespace TrenchBroom {
             viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleInspector, "Toggle Inspector", KeyboardShortcut('5', WXK_CONTROL));
             viewMenu->addSeparator();
             viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleMaximizeCurrentView, "Maximize Current View", KeyboardShortcut(WXK_SPACE, WXK_CONTROL));
+            viewMenu->addSeparator();
+            viewMenu->addModifiableCheckItem(CommandIds::Menu::ViewToggleShowRenderStatistics, "Show Render Statistics");
+            viewMenu->addModifiableActionItem(CommandIds::Menu::ViewSaveRenderStatistics, "Save Render Statistics...");
             
             Menu* runMenu = m_menuBar->addMenu("Run");
             runMenu->addModifiableActionItem(CommandIds::Menu::RunCompile, "Compile...");
@@ -280,6 +283,7 @@ namespace TrenchBroom {
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugClipWithFace, "Clip Brush...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCopyJSShortcuts, "Copy Javascript Shortcut Map");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCrash, "Crash...");
+            debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugShowMemoryUsage, "Show Memory Usage...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCrashReportDialog, "Show Crash Report Dialog");
 #endif
             
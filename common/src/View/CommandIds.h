@@ -102,6 +102,9 @@ namespace TrenchBroom {
                 
                 const int RunCompile                         = Lowest + 133;
                 const int RunLaunch                          = Lowest + 134;
+                const int DebugShowMemoryUsage               = Lowest + 135;
+                const int ViewToggleShowRenderStatistics     = Lowest + 136;
+                const int ViewSaveRenderStatistics           = Lowest + 137;
                 
                 const int FileRecentDocuments                = Lowest + 190;
 
@@ -20,6 +20,7 @@
 #include "CommandProcessor.h"
 
 #include "Exceptions.h"
+#include "MemoryUsage.h"
 #include "SetAny.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -98,6 +99,13 @@ namespace TrenchBroom {
             return false;
         }
         
+        size_t CommandGroup::doGetMemoryUsage() const {
+            size_t result = sizeof(CommandGroup);
+            for (UndoableCommand::Ptr command : m_commands)
+                result += command->memoryUsage();
+            return result;
+        }
+        
         const wxLongLong CommandProcessor::CollationInterval(1000);
         
         struct CommandProcessor::SubmitAndStoreResult {
@@ -234,6 +242,18 @@ namespace TrenchBroom {
             m_lastCommandTimestamp = 0;
         }
         
+        void CommandProcessor::measureMemoryUsage(MemoryUsage& usage) const {
+            size_t undoBytes = 0;
+            for (UndoableCommand::Ptr command : m_lastCommandStack)
+                undoBytes += command->memoryUsage();
+            usage.add("Undo stack", m_lastCommandStack.size(), undoBytes);
+            
+            size_t redoBytes = 0;
+            for (UndoableCommand::Ptr command : m_nextCommandStack)
+                redoBytes += command->memoryUsage();
+            usage.add("Redo stack", m_nextCommandStack.size(), redoBytes);
+        }
+        
         CommandProcessor::SubmitAndStoreResult CommandProcessor::submitAndStoreCommand(UndoableCommand::Ptr command, const bool collate) {
             SubmitAndStoreResult result;
             result.submitted = doCommand(command);
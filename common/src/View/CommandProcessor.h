@@ -32,6 +32,8 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class MemoryUsage;
+    
     namespace View {
         class MapDocumentCommandFacade;
         
@@ -62,6 +64,8 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
 
             bool doCollateWith(UndoableCommand::Ptr command);
+            
+            size_t doGetMemoryUsage() const;
         };
         
         class CommandProcessor {
@@ -111,6 +115,8 @@ namespace TrenchBroom {
             void clearRepeatableCommands();
             
             void clear();
+            
+            void measureMemoryUsage(MemoryUsage& usage) const;
         private:
             SubmitAndStoreResult submitAndStoreCommand(UndoableCommand::Ptr command, bool collate);
             bool doCommand(Command::Ptr command);
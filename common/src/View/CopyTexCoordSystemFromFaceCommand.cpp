@@ -74,5 +74,9 @@ namespace TrenchBroom {
         bool CopyTexCoordSystemFromFaceCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+        
+        size_t CopyTexCoordSystemFromFaceCommand::doGetMemoryUsage() const {
+            return sizeof(CopyTexCoordSystemFromFaceCommand) + (m_snapshot != NULL ? m_snapshot->memoryUsage() : 0);
+        }
     }
 }
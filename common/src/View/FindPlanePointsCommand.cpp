@@ -59,5 +59,9 @@ namespace TrenchBroom {
         bool FindPlanePointsCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+        
+        size_t FindPlanePointsCommand::doGetMemoryUsage() const {
+            return sizeof(FindPlanePointsCommand) + (m_snapshot != NULL ? m_snapshot->memoryUsage() : 0);
+        }
     }
 }
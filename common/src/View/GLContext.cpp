@@ -42,6 +42,10 @@ namespace TrenchBroom {
         Renderer::ShaderManager& GLContext::shaderManager() {
             return m_contextManager->shaderManager();
         }
+        
+        Renderer::RenderProfiler& GLContext::renderProfiler() {
+            return m_contextManager->renderProfiler();
+        }
 
         bool GLContext::initialize() {
             return m_contextManager->initialize();
@@ -27,6 +27,7 @@
 namespace TrenchBroom {
     namespace Renderer {
         class FontManager;
+        class RenderProfiler;
         class ShaderManager;
         class Vbo;
     }
@@ -46,6 +47,7 @@ namespace TrenchBroom {
             Renderer::Vbo& indexVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
+            Renderer::RenderProfiler& renderProfiler();
             
             bool initialize();
             bool SetCurrent(const wxGLCanvas* canvas) const;
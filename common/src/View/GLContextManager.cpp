@@ -18,9 +18,11 @@
  */
 
 #include "GLContextManager.h"
+#include "MemoryUsage.h"
 
 #include "Renderer/FontManager.h"
 #include "Renderer/GL.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Vbo.h"
 
@@ -31,13 +33,15 @@ namespace TrenchBroom {
         m_vertexVbo(new Renderer::Vbo(0xFFFFFF)),
         m_indexVbo(new Renderer::Vbo(0xFFFFF, GL_ELEMENT_ARRAY_BUFFER)),
         m_fontManager(new Renderer::FontManager()),
-        m_shaderManager(new Renderer::ShaderManager()) {}
+        m_shaderManager(new Renderer::ShaderManager()),
+        m_renderProfiler(new Renderer::RenderProfiler()) {}
         
         GLContextManager::~GLContextManager() {
             delete m_vertexVbo;
             delete m_indexVbo;
             delete m_fontManager;
             delete m_shaderManager;
+            delete m_renderProfiler;
         }
 
         GLContext::Ptr GLContextManager::createContext(wxGLCanvas* canvas) {
@@ -58,6 +62,7 @@ namespace TrenchBroom {
         bool GLContextManager::initialize() {
             if (!m_initialized) {
                 glewInitialize();
+                m_renderProfiler->setGpuTiming(glTimerQueriesAvailable());
                 m_initialized = true;
                 return true;
             }
@@ -72,6 +77,14 @@ namespace TrenchBroom {
             return *m_indexVbo;
         }
         
+        void GLContextManager::measureMemoryUsage(MemoryUsage& usage) const {
+            // the free capacity is part of the buffers, but not used by any renderer
+            usage.add("Vertex buffer blocks", m_vertexVbo->usedBlockCount(), m_vertexVbo->totalCapacity() - m_vertexVbo->freeCapacity());
+            usage.add("Vertex buffer free capacity", 0, m_vertexVbo->freeCapacity());
+            usage.add("Index buffer blocks", m_indexVbo->usedBlockCount(), m_indexVbo->totalCapacity() - m_indexVbo->freeCapacity());
+            usage.add("Index buffer free capacity", 0, m_indexVbo->freeCapacity());
+        }
+        
         Renderer::FontManager& GLContextManager::fontManager() {
             return *m_fontManager;
         }
@@ -79,5 +92,9 @@ namespace TrenchBroom {
         Renderer::ShaderManager& GLContextManager::shaderManager() {
             return *m_shaderManager;
         }
+        
+        Renderer::RenderProfiler& GLContextManager::renderProfiler() {
+            return *m_renderProfiler;
+        }
     }
 }
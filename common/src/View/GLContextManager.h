@@ -25,8 +25,11 @@
 class wxGLCanvas;
 
 namespace TrenchBroom {
+    class MemoryUsage;
+    
     namespace Renderer {
         class FontManager;
+        class RenderProfiler;
         class ShaderManager;
         class Vbo;
     }
@@ -41,6 +44,7 @@ namespace TrenchBroom {
             Renderer::Vbo* m_indexVbo;
             Renderer::FontManager* m_fontManager;
             Renderer::ShaderManager* m_shaderManager;
+            Renderer::RenderProfiler* m_renderProfiler;
         public:
             GLContextManager();
             ~GLContextManager();
@@ -55,6 +59,9 @@ namespace TrenchBroom {
             Renderer::Vbo& indexVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
+            Renderer::RenderProfiler& renderProfiler();
+            
+            void measureMemoryUsage(MemoryUsage& usage) const;
         private:
             GLContextManager(const GLContextManager& other);
             GLContextManager& operator=(const GLContextManager& other);
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HandlePositionIndex.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace View {
+        HandlePositionIndex::Node::Node(const BBox3& i_bounds, const size_t i_begin, const size_t i_end) :
+        bounds(i_bounds),
+        begin(i_begin),
+        end(i_end),
+        firstChild(0) {}
+
+        void HandlePositionIndex::build(const Vec3::List& positions) {
+            clear();
+            if (positions.empty())
+                return;
+            
+            m_positions = positions;
+            m_nodes.reserve(2 * (m_positions.size() / MaxLeafSize + 1));
+            m_nodes.push_back(Node(bounds(0, m_positions.size()), 0, m_positions.size()));
+            buildNode(0);
+        }
+        
+        void HandlePositionIndex::clear() {
+            m_positions.clear();
+            m_nodes.clear();
+        }
+
+        bool HandlePositionIndex::empty() const {
+            return m_positions.empty();
+        }
+        
+        size_t HandlePositionIndex::size() const {
+            return m_positions.size();
+        }
+
+        void HandlePositionIndex::buildNode(const size_t nodeIndex) {
+            const size_t begin = m_nodes[nodeIndex].begin;
+            const size_t end = m_nodes[nodeIndex].end;
+            if (end - begin <= MaxLeafSize)
+                return;
+            
+            // split the positions at the median of the longest axis of the node's bounds
+            const Vec3 size = m_nodes[nodeIndex].bounds.size();
+            const size_t axis = size.x() >= size.y() && size.x() >= size.z() ? 0 : (size.y() >= size.z() ? 1 : 2);
+            const size_t mid = begin + (end - begin) / 2;
+            
+            Vec3::List::iterator first = std::begin(m_positions);
+            std::nth_element(first + begin, first + mid, first + end, [axis](const Vec3& lhs, const Vec3& rhs) { return lhs[axis] < rhs[axis]; });
+            
+            const size_t firstChild = m_nodes.size();
+            m_nodes[nodeIndex].firstChild = firstChild;
+            m_nodes.push_back(Node(bounds(begin, mid), begin, mid));
+            m_nodes.push_back(Node(bounds(mid, end), mid, end));
+            
+            buildNode(firstChild);
+            buildNode(firstChild + 1);
+        }
+
+        BBox3 HandlePositionIndex::bounds(const size_t begin, const size_t end) const {
+            assert(begin < end);
+            BBox3 result(m_positions[begin], m_positions[begin]);
+            for (size_t i = begin + 1; i < end; ++i)
+                result.mergeWith(m_positions[i]);
+            return result;
+        }
+    }
+}
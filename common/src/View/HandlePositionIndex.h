@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_HandlePositionIndex
+#define TrenchBroom_HandlePositionIndex
+
+#include "TrenchBroom.h"
+#include "VecMath.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         A bounding volume hierarchy over a set of handle positions. The hierarchy is built once for all
+         positions and must be rebuilt when the positions change.
+         
+         Queries take two predicates: one that decides whether a subtree with the given bounds may contain
+         matching positions, and one that decides whether a single position matches.
+         */
+        class HandlePositionIndex {
+        private:
+            static const size_t MaxLeafSize = 16;
+            
+            struct Node {
+                BBox3 bounds;
+                size_t begin;
+                size_t end;
+                size_t firstChild; // 0 for leafs, the second child follows the first child
+                
+                Node(const BBox3& i_bounds, size_t i_begin, size_t i_end);
+            };
+            
+            Vec3::List m_positions;
+            std::vector<Node> m_nodes;
+        public:
+            void build(const Vec3::List& positions);
+            void clear();
+            
+            bool empty() const;
+            size_t size() const;
+            
+            template <typename BoundsTest, typename PositionTest>
+            Vec3::List find(const BoundsTest& boundsTest, const PositionTest& positionTest) const {
+                Vec3::List result;
+                if (m_nodes.empty())
+                    return result;
+                
+                std::vector<size_t> stack(1, 0);
+                while (!stack.empty()) {
+                    const Node& node = m_nodes[stack.back()];
+                    stack.pop_back();
+                    
+                    if (!boundsTest(node.bounds))
+                        continue;
+                    
+                    if (node.firstChild == 0) {
+                        for (size_t i = node.begin; i < node.end; ++i) {
+                            if (positionTest(m_positions[i]))
+                                result.push_back(m_positions[i]);
+                        }
+                    } else {
+                        stack.push_back(node.firstChild);
+                        stack.push_back(node.firstChild + 1);
+                    }
+                }
+                return result;
+            }
+        private:
+            void buildNode(size_t nodeIndex);
+            BBox3 bounds(size_t begin, size_t end) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_HandlePositionIndex) */
@@ -19,7 +19,10 @@
 
 #include "IssueBrowser.h"
 
+#include "CollectionUtils.h"
 #include "Macros.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
 #include "Model/Issue.h"
 #include "Model/IssueGenerator.h"
 #include "Model/World.h"
@@ -86,28 +89,40 @@ namespace TrenchBroom {
 
         void IssueBrowser::bindObservers() {
             MapDocumentSPtr document = lock(m_document);
+            document->documentWasClearedNotifier.addObserver(this, &IssueBrowser::documentWasCleared);
             document->documentWasSavedNotifier.addObserver(this, &IssueBrowser::documentWasSaved);
             document->documentWasNewedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
             document->documentWasLoadedNotifier.addObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
             document->nodesWereAddedNotifier.addObserver(this, &IssueBrowser::nodesWereAdded);
+            document->nodesWillBeRemovedNotifier.addObserver(this, &IssueBrowser::nodesWillBeRemoved);
             document->nodesWereRemovedNotifier.addObserver(this, &IssueBrowser::nodesWereRemoved);
+            document->nodesWillChangeNotifier.addObserver(this, &IssueBrowser::nodesWillChange);
             document->nodesDidChangeNotifier.addObserver(this, &IssueBrowser::nodesDidChange);
             document->brushFacesDidChangeNotifier.addObserver(this, &IssueBrowser::brushFacesDidChange);
+            document->entityDefinitionsDidChangeNotifier.addObserver(this, &IssueBrowser::entityDefinitionsDidChange);
         }
         
         void IssueBrowser::unbindObservers() {
             if (!expired(m_document)) {
                 MapDocumentSPtr document = lock(m_document);
+                document->documentWasClearedNotifier.removeObserver(this, &IssueBrowser::documentWasCleared);
                 document->documentWasSavedNotifier.removeObserver(this, &IssueBrowser::documentWasSaved);
                 document->documentWasNewedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
                 document->documentWasLoadedNotifier.removeObserver(this, &IssueBrowser::documentWasNewedOrLoaded);
                 document->nodesWereAddedNotifier.removeObserver(this, &IssueBrowser::nodesWereAdded);
+                document->nodesWillBeRemovedNotifier.removeObserver(this, &IssueBrowser::nodesWillBeRemoved);
                 document->nodesWereRemovedNotifier.removeObserver(this, &IssueBrowser::nodesWereRemoved);
+                document->nodesWillChangeNotifier.removeObserver(this, &IssueBrowser::nodesWillChange);
                 document->nodesDidChangeNotifier.removeObserver(this, &IssueBrowser::nodesDidChange);
                 document->brushFacesDidChangeNotifier.removeObserver(this, &IssueBrowser::brushFacesDidChange);
+                document->entityDefinitionsDidChangeNotifier.removeObserver(this, &IssueBrowser::entityDefinitionsDidChange);
             }
         }
         
+        void IssueBrowser::documentWasCleared(MapDocument* document) {
+            m_view->reload();
+        }
+        
         void IssueBrowser::documentWasNewedOrLoaded(MapDocument* document) {
             updateFilterFlags();
             m_view->reload();
@@ -118,18 +133,36 @@ namespace TrenchBroom {
         }
         
         void IssueBrowser::nodesWereAdded(const Model::NodeList& nodes) {
-            m_view->reload();
+            m_view->invalidateNodes(nodes);
+        }
+        
+        void IssueBrowser::nodesWillBeRemoved(const Model::NodeList& nodes) {
+            // the links and parents of the nodes are gone once they are removed
+            m_view->invalidateNodes(nodes);
         }
         
         void IssueBrowser::nodesWereRemoved(const Model::NodeList& nodes) {
-            m_view->reload();
+            m_view->removeNodes(nodes);
+        }
+        
+        void IssueBrowser::nodesWillChange(const Model::NodeList& nodes) {
+            m_view->invalidateNodes(nodes);
         }
         
         void IssueBrowser::nodesDidChange(const Model::NodeList& nodes) {
-            m_view->reload();
+            m_view->invalidateNodes(nodes);
         }
         
         void IssueBrowser::brushFacesDidChange(const Model::BrushFaceList& faces) {
+            Model::NodeList brushes;
+            brushes.reserve(faces.size());
+            for (Model::BrushFace* face : faces)
+                brushes.push_back(face->brush());
+            VectorUtils::sortAndRemoveDuplicates(brushes);
+            m_view->invalidateNodes(brushes);
+        }
+        
+        void IssueBrowser::entityDefinitionsDidChange() {
             m_view->reload();
         }
 
@@ -63,12 +63,16 @@ namespace TrenchBroom {
         private:
             void bindObservers();
             void unbindObservers();
+            void documentWasCleared(MapDocument* document);
             void documentWasNewedOrLoaded(MapDocument* document);
             void documentWasSaved(MapDocument* document);
             void nodesWereAdded(const Model::NodeList& nodes);
+            void nodesWillBeRemoved(const Model::NodeList& nodes);
             void nodesWereRemoved(const Model::NodeList& nodes);
+            void nodesWillChange(const Model::NodeList& nodes);
             void nodesDidChange(const Model::NodeList& nodes);
             void brushFacesDidChange(const Model::BrushFaceList& faces);
+            void entityDefinitionsDidChange();
             void issueIgnoreChanged(Model::Issue* issue);
 
             void updateFilterFlags();
@@ -19,7 +19,6 @@
 
 #include "IssueBrowserView.h"
 
-#include "Model/CollectMatchingIssuesVisitor.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/World.h"
@@ -60,6 +59,18 @@ namespace TrenchBroom {
         }
 
         void IssueBrowserView::reload() {
+            MapDocumentSPtr document = lock(m_document);
+            m_issueTracker.reset(document->world());
+            invalidate();
+        }
+
+        void IssueBrowserView::invalidateNodes(const Model::NodeList& nodes) {
+            m_issueTracker.invalidateNodes(nodes);
+            invalidate();
+        }
+        
+        void IssueBrowserView::removeNodes(const Model::NodeList& nodes) {
+            m_issueTracker.removeNodes(nodes);
             invalidate();
         }
 
@@ -161,15 +172,12 @@ namespace TrenchBroom {
         void IssueBrowserView::updateIssues() {
             m_issues.clear();
             
-            MapDocumentSPtr document = lock(m_document);
-            Model::World* world = document->world();
-            if (world != NULL) {
-                const Model::IssueGeneratorList& issueGenerators = world->registeredIssueGenerators();
-                Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
-                world->acceptAndRecurse(visitor);
-                m_issues = visitor.issues();
-                VectorUtils::sort(m_issues, IssueCmp());
+            const IssueVisible visible(m_hiddenGenerators, m_showHiddenIssues);
+            for (Model::Issue* issue : m_issueTracker.issues()) {
+                if (visible(issue))
+                    m_issues.push_back(issue);
             }
+            VectorUtils::sort(m_issues, IssueCmp());
         }
 
         void IssueBrowserView::OnApplyQuickFix(wxCommandEvent& event) {
@@ -271,7 +279,8 @@ namespace TrenchBroom {
         }
 
         void IssueBrowserView::OnIdle(wxIdleEvent& event) {
-            validate();
+            if (!validate())
+                event.RequestMore();
         }
         
         void IssueBrowserView::invalidate() {
@@ -279,13 +288,23 @@ namespace TrenchBroom {
             SetItemCount(0);
         }
         
-        void IssueBrowserView::validate() {
+        bool IssueBrowserView::validate() {
+            if (m_issueTracker.hasDirtyNodes()) {
+                // only the nodes affected by the changes since the last update are revalidated, and
+                // large batches are spread over several idle events to keep the UI responsive
+                MapDocumentSPtr document = lock(m_document);
+                const Model::World* world = document->world();
+                if (world != NULL && !m_issueTracker.update(world->registeredIssueGenerators(), MaxValidatedNodesPerIdleEvent))
+                    return false;
+            }
+            
             if (!m_valid) {
                 m_valid = true;
                 
                 updateIssues();
                 SetItemCount(static_cast<long>(m_issues.size()));
             }
+            return true;
         }
     }
 }
@@ -23,6 +23,7 @@
 #include "View/ViewTypes.h"
 
 #include "Model/Issue.h"
+#include "Model/IssueTracker.h"
 #include "Model/ModelTypes.h"
 
 #include <wx/listctrl.h>
@@ -38,10 +39,12 @@ namespace TrenchBroom {
             static const int ShowIssuesCommandId = 1;
             static const int HideIssuesCommandId = 2;
             static const int FixObjectsBaseId = 3;
+            static const size_t MaxValidatedNodesPerIdleEvent = 4096;
             
             typedef std::vector<size_t> IndexList;
             
             MapDocumentWPtr m_document;
+            Model::IssueTracker m_issueTracker;
             Model::IssueList m_issues;
             
             Model::IssueType m_hiddenGenerators;
@@ -55,6 +58,8 @@ namespace TrenchBroom {
             void setHiddenGenerators(int hiddenGenerators);
             void setShowHiddenIssues(bool show);
             void reload();
+            void invalidateNodes(const Model::NodeList& nodes);
+            void removeNodes(const Model::NodeList& nodes);
             
             void OnSize(wxSizeEvent& event);
             
@@ -85,7 +90,7 @@ namespace TrenchBroom {
         private:
             void OnIdle(wxIdleEvent& event);
             void invalidate();
-            void validate();
+            bool validate();
         };
     }
 }
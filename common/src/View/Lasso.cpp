@@ -21,6 +21,7 @@
 
 #include "Renderer/Camera.h"
 #include "Renderer/RenderService.h"
+#include "View/HandlePositionIndex.h"
 
 namespace TrenchBroom {
     namespace View {
@@ -50,6 +51,15 @@ namespace TrenchBroom {
             return result;
         }
 
+        Vec3::List Lasso::containedPoints(const HandlePositionIndex& index) const {
+            const Plane3 plane(m_camera.defaultPoint(static_cast<float>(m_distance)), m_camera.direction());
+            const BBox2 box = computeBox();
+            
+            const auto boundsTest = [&](const BBox3& bounds) { return mayContainPoints(bounds, plane, box); };
+            const auto positionTest = [&](const Vec3& point) { return containsPoint(point, plane, box); };
+            return index.find(boundsTest, positionTest);
+        }
+        
         bool Lasso::containsPoint(const Vec3& point) const {
             const Plane3 plane(m_camera.defaultPoint(static_cast<float>(m_distance)), m_camera.direction());
             const BBox2 box = computeBox();
@@ -67,6 +77,33 @@ namespace TrenchBroom {
             return box.contains(projected);
         }
 
+        bool Lasso::mayContainPoints(const BBox3& bounds, const Plane3& plane, const BBox2& box) const {
+            // The projection of the bounds is contained in the bounds of its projected corners. If a corner
+            // cannot be projected, it lies behind the camera and we cannot rule out any of the points.
+            bool projectable = true;
+            bool first = true;
+            BBox2 projectedBounds;
+            
+            auto op = [&](const Vec3& corner) {
+                const Ray3 ray(m_camera.pickRay(corner));
+                const FloatType hitDistance = plane.intersectWithRay(ray);
+                if (Math::isnan(hitDistance)) {
+                    projectable = false;
+                } else {
+                    const Vec3 projected = m_transform * ray.pointAtDistance(hitDistance);
+                    if (first) {
+                        projectedBounds = BBox2(Vec2(projected), Vec2(projected));
+                        first = false;
+                    } else {
+                        projectedBounds.mergeWith(Vec2(projected));
+                    }
+                }
+            };
+            eachBBoxVertex(bounds, op);
+            
+            return !projectable || box.intersects(projectedBounds);
+        }
+
         void Lasso::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
             const BBox2 box = computeBox();
             const Mat4x4 inverted = invertedMatrix(m_transform);
@@ -31,6 +31,8 @@ namespace TrenchBroom {
     }
     
     namespace View {
+        class HandlePositionIndex;
+        
         class Lasso {
         private:
             const Renderer::Camera& m_camera;
@@ -43,9 +45,11 @@ namespace TrenchBroom {
             void setPoint(const Vec3& point);
             
             Vec3::List containedPoints(const Vec3::List& points) const;
+            Vec3::List containedPoints(const HandlePositionIndex& index) const;
             bool containsPoint(const Vec3& point) const;
         private:
             bool containsPoint(const Vec3& point, const Plane3& plane, const BBox2& box) const;
+            bool mayContainPoints(const BBox3& bounds, const Plane3& plane, const BBox2& box) const;
         public:
             void render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const;
         private:
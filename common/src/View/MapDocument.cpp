@@ -19,13 +19,16 @@
 
 #include "View/MapDocument.h"
 
+#include "MemoryUsage.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Polyhedron.h"
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "Assets/TextureName.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
@@ -61,6 +64,7 @@
 #include "Model/Group.h"
 #include "Model/LongAttributeNameIssueGenerator.h"
 #include "Model/LongAttributeValueIssueGenerator.h"
+#include "Model/MeasureMemoryUsageVisitor.h"
 #include "Model/MergeNodesIntoWorldVisitor.h"
 #include "Model/MissingClassnameIssueGenerator.h"
 #include "Model/MissingDefinitionIssueGenerator.h"
@@ -135,7 +139,10 @@ namespace TrenchBroom {
         m_currentTextureName(Model::BrushFace::NoTextureName),
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
-        m_viewEffectsService(NULL) {
+        m_viewEffectsService(NULL),
+        m_progressMonitor(NULL),
+        m_nodesDidChange(nodesDidChangeNotifier),
+        m_brushFacesDidChange(brushFacesDidChangeNotifier) {
             bindObservers();
         }
         
@@ -145,6 +152,7 @@ namespace TrenchBroom {
             if (isPointFileLoaded())
                 unloadPointFile();
             clearWorld();
+            clearClipboardNodes();
             
             delete m_grid;
             delete m_mapViewConfig;
@@ -226,6 +234,10 @@ namespace TrenchBroom {
             m_viewEffectsService = viewEffectsService;
         }
         
+        void MapDocument::setProgressMonitor(ProgressMonitor* progressMonitor) {
+            m_progressMonitor = progressMonitor;
+        }
+        
         void MapDocument::newDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game) {
             info("Creating new document");
             
@@ -241,11 +253,15 @@ namespace TrenchBroom {
             documentWasNewedNotifier(this);
         }
         
-        void MapDocument::loadDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path) {
+        void MapDocument::loadDocument(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status) {
             info("Loading document from " + path.asString());
             
+            // Reporting the progress may process events, so the current world is kept until the new one is
+            // complete. The views must never see a document without a world.
+            Model::World* world = game->loadMap(mapFormat, worldBounds, path, status, this);
+            
             clearDocument();
-            loadWorld(mapFormat, worldBounds, game, path);
+            setWorld(worldBounds, world, game, path);
             
             loadAssets();
             registerIssueGenerators();
@@ -283,6 +299,7 @@ namespace TrenchBroom {
                 documentWillBeClearedNotifier(this);
                 
                 clearSelection();
+                clearClipboardNodes();
                 unloadAssets();
                 clearWorld();
                 clearModificationCount();
@@ -294,7 +311,10 @@ namespace TrenchBroom {
         String MapDocument::serializeSelectedNodes() {
             StringStream stream;
             m_game->writeNodesToStream(m_world, m_selectedNodes.nodes(), stream);
-            return stream.str();
+            
+            const String str = stream.str();
+            setClipboardNodes(str, m_selectedNodes.nodes());
+            return str;
         }
         
         String MapDocument::serializeSelectedBrushFaces() {
@@ -304,6 +324,16 @@ namespace TrenchBroom {
         }
         
         PasteType MapDocument::paste(const String& str) {
+            // if the clipboard still holds what was copied from this document, paste clones of the copied
+            // nodes instead of parsing the text again
+            if (!m_clipboardNodes.empty() && str == m_clipboardText) {
+                Model::NodeList nodes;
+                nodes.reserve(m_clipboardNodes.size());
+                for (const Model::Node* node : m_clipboardNodes)
+                    nodes.push_back(node->cloneRecursively(m_worldBounds));
+                return pasteNodes(nodes) ? PT_Node : PT_Failed;
+            }
+            
             try {
                 const Model::NodeList nodes = m_game->parseNodes(str, m_world, m_worldBounds, this);
                 if (!nodes.empty() && pasteNodes(nodes))
@@ -320,6 +350,73 @@ namespace TrenchBroom {
             return PT_Failed;
         }
         
+        /**
+         Clones the given nodes in the same way that serializing and parsing them would restructure them: Brushes
+         that belong to an entity are moved into a clone of that entity which has no other brushes, and brushes that
+         belong to the world are cloned on their own.
+         */
+        class MapDocument::CloneClipboardNodes : public Model::NodeVisitor {
+        private:
+            typedef std::map<Model::AttributableNode*, Model::Node*> EntityCloneMap;
+            
+            const Model::World* m_world;
+            const BBox3& m_worldBounds;
+            
+            Model::NodeList m_worldBrushes;
+            EntityCloneMap m_entityClones;
+            Model::NodeList m_groupsAndEntities;
+        public:
+            CloneClipboardNodes(const Model::World* world, const BBox3& worldBounds) :
+            m_world(world),
+            m_worldBounds(worldBounds) {}
+            
+            Model::NodeList result() const {
+                Model::NodeList result;
+                result.reserve(m_worldBrushes.size() + m_entityClones.size() + m_groupsAndEntities.size());
+                VectorUtils::append(result, m_worldBrushes);
+                for (const EntityCloneMap::value_type& entry : m_entityClones)
+                    result.push_back(entry.second);
+                VectorUtils::append(result, m_groupsAndEntities);
+                return result;
+            }
+        private:
+            void doVisit(Model::World* world)   {}
+            void doVisit(Model::Layer* layer)   {}
+            void doVisit(Model::Group* group)   { m_groupsAndEntities.push_back(group->cloneRecursively(m_worldBounds)); }
+            void doVisit(Model::Entity* entity) { m_groupsAndEntities.push_back(entity->cloneRecursively(m_worldBounds)); }
+            
+            void doVisit(Model::Brush* brush) {
+                Model::AttributableNode* entity = brush->entity();
+                if (entity == NULL || entity == m_world) {
+                    m_worldBrushes.push_back(brush->clone(m_worldBounds));
+                } else {
+                    EntityCloneMap::iterator it = m_entityClones.find(entity);
+                    if (it == std::end(m_entityClones))
+                        it = m_entityClones.insert(std::make_pair(entity, entity->clone(m_worldBounds))).first;
+                    it->second->addChild(brush->clone(m_worldBounds));
+                }
+            }
+        };
+        
+        void MapDocument::setClipboardNodes(const String& str, const Model::NodeList& nodes) {
+            clearClipboardNodes();
+            
+            CloneClipboardNodes cloneNodes(m_world, m_worldBounds);
+            Model::Node::accept(std::begin(nodes), std::end(nodes), cloneNodes);
+            
+            m_clipboardText = str;
+            m_clipboardNodes = cloneNodes.result();
+            
+            // the clones must not hold on to assets which may be unloaded or reloaded before they are pasted
+            unsetEntityDefinitions(m_clipboardNodes);
+            unsetTextures(m_clipboardNodes);
+        }
+        
+        void MapDocument::clearClipboardNodes() {
+            VectorUtils::clearAndDelete(m_clipboardNodes);
+            m_clipboardText.clear();
+        }
+        
         bool MapDocument::pasteNodes(const Model::NodeList& nodes) {
             Model::MergeNodesIntoWorldVisitor mergeNodes(m_world, currentParent());
             Model::Node::accept(std::begin(nodes), std::end(nodes), mergeNodes);
@@ -455,8 +552,10 @@ namespace TrenchBroom {
         void MapDocument::selectTouching(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
             
+            const Model::NodeList candidates = m_world->findNodesIntersecting(brushes);
+            
             Model::CollectTouchingNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), visitor);
             
             const Model::NodeList nodes = visitor.nodes();
             
@@ -471,8 +570,10 @@ namespace TrenchBroom {
         void MapDocument::selectInside(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
 
+            const Model::NodeList candidates = m_world->findNodesIntersecting(brushes);
+            
             Model::CollectContainedNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
+            Model::Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), visitor);
             
             const Model::NodeList nodes = visitor.nodes();
 
@@ -1178,6 +1279,24 @@ namespace TrenchBroom {
                 }
             }
         }
+        
+        void MapDocument::measureMemoryUsage(MemoryUsage& usage) const {
+            if (m_world != NULL)
+                Model::measureMemoryUsage(m_world, usage);
+            
+            size_t textureCount = 0;
+            size_t textureBytes = 0;
+            for (const Assets::TextureCollection* collection : m_textureManager->collections()) {
+                for (const Assets::Texture* texture : collection->textures()) {
+                    ++textureCount;
+                    textureBytes += texture->memoryUsage();
+                }
+            }
+            usage.add("Textures", textureCount, textureBytes);
+            usage.add("Texture names", Assets::TextureName::symbolCount(), Assets::TextureName::memoryUsage());
+            
+            doMeasureCommandMemoryUsage(usage);
+        }
 
         bool MapDocument::canUndoLastCommand() const {
             return doCanUndoLastCommand();
@@ -1196,14 +1315,20 @@ namespace TrenchBroom {
         }
         
         void MapDocument::undoLastCommand() {
+            const CoalescingNotifier<Model::Node*>::Batch nodesBatch(m_nodesDidChange);
+            const CoalescingNotifier<Model::BrushFace*>::Batch facesBatch(m_brushFacesDidChange);
             doUndoLastCommand();
         }
         
         void MapDocument::redoNextCommand() {
+            const CoalescingNotifier<Model::Node*>::Batch nodesBatch(m_nodesDidChange);
+            const CoalescingNotifier<Model::BrushFace*>::Batch facesBatch(m_brushFacesDidChange);
             doRedoNextCommand();
         }
         
         bool MapDocument::repeatLastCommands() {
+            const CoalescingNotifier<Model::Node*>::Batch nodesBatch(m_nodesDidChange);
+            const CoalescingNotifier<Model::BrushFace*>::Batch facesBatch(m_brushFacesDidChange);
             return doRepeatLastCommands();
         }
         
@@ -1228,6 +1353,22 @@ namespace TrenchBroom {
             doEndTransaction();
         }
         
+        void MapDocument::beginNotificationBatch() {
+            m_nodesDidChange.beginBatch();
+            m_brushFacesDidChange.beginBatch();
+        }
+        
+        void MapDocument::endNotificationBatch() {
+            // brush faces first because observers of node changes may rebuild the faces
+            m_brushFacesDidChange.endBatch();
+            m_nodesDidChange.endBatch();
+        }
+        
+        void MapDocument::flushNotificationBatch() {
+            m_brushFacesDidChange.flush();
+            m_nodesDidChange.flush();
+        }
+        
         bool MapDocument::submit(Command::Ptr command) {
             return doSubmit(command);
         }
@@ -1262,10 +1403,10 @@ namespace TrenchBroom {
             setPath(IO::Path(DefaultDocumentName));
         }
         
-        void MapDocument::loadWorld(const Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path) {
+        void MapDocument::setWorld(const BBox3& worldBounds, Model::World* world, Model::GameSPtr game, const IO::Path& path) {
             m_worldBounds = worldBounds;
             m_game = game;
-            m_world = m_game->loadMap(mapFormat, m_worldBounds, path, this);
+            m_world = world;
             setCurrentLayer(m_world->defaultLayer());
             
             updateGameSearchPaths();
@@ -1584,6 +1725,9 @@ namespace TrenchBroom {
             m_mapViewConfig->mapViewConfigDidChangeNotifier.addObserver(mapViewConfigDidChangeNotifier);
             commandDoneNotifier.addObserver(this, &MapDocument::commandDone);
             commandUndoneNotifier.addObserver(this, &MapDocument::commandUndone);
+            nodesWillChangeNotifier.addObserver(this, &MapDocument::nodesWillChangeOrBeRemoved);
+            nodesWillBeRemovedNotifier.addObserver(this, &MapDocument::nodesWillChangeOrBeRemoved);
+            nodesWereRemovedNotifier.addObserver(this, &MapDocument::nodesWereRemoved);
         }
         
         void MapDocument::unbindObservers() {
@@ -1593,17 +1737,22 @@ namespace TrenchBroom {
             m_mapViewConfig->mapViewConfigDidChangeNotifier.removeObserver(mapViewConfigDidChangeNotifier);
             commandDoneNotifier.removeObserver(this, &MapDocument::commandDone);
             commandUndoneNotifier.removeObserver(this, &MapDocument::commandUndone);
+            nodesWillChangeNotifier.removeObserver(this, &MapDocument::nodesWillChangeOrBeRemoved);
+            nodesWillBeRemovedNotifier.removeObserver(this, &MapDocument::nodesWillChangeOrBeRemoved);
+            nodesWereRemovedNotifier.removeObserver(this, &MapDocument::nodesWereRemoved);
         }
         
         void MapDocument::preferenceDidChange(const IO::Path& path) {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, this);
                 
+                // cancels the pending model loads, which read from the game file system that is about to be replaced
                 clearEntityModels();
-                
                 unsetTextures();
+                
+                m_game->setGamePath(newGamePath, this);
+                
                 loadTextures();
                 setTextures();
                 
@@ -1622,6 +1771,16 @@ namespace TrenchBroom {
         void MapDocument::commandUndone(UndoableCommand::Ptr command) {
             debug("Command '%s' undone", command->name().c_str());
         }
+        
+        void MapDocument::nodesWillChangeOrBeRemoved(const Model::NodeList& nodes) {
+            // changing or removing brushes may delete their faces, so pending face notifications must go out now
+            m_brushFacesDidChange.flush();
+        }
+        
+        void MapDocument::nodesWereRemoved(const Model::NodeList& nodes) {
+            // removed nodes may be deleted before the batch ends, e.g. when a transaction is rolled back
+            m_nodesDidChange.discard(nodes);
+        }
 
         Transaction::Transaction(MapDocumentWPtr document, const String& name) :
         m_document(lock(document).get()),
@@ -1644,6 +1803,7 @@ namespace TrenchBroom {
         Transaction::~Transaction() {
             if (!m_cancelled)
                 commit();
+            m_document->endNotificationBatch();
         }
         
         void Transaction::rollback() {
@@ -1656,6 +1816,7 @@ namespace TrenchBroom {
         }
         
         void Transaction::begin(const String& name) {
+            m_document->beginNotificationBatch();
             m_document->beginTransaction(name);
         }
         
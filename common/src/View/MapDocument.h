@@ -38,12 +38,18 @@
 
 class Color;
 namespace TrenchBroom {
+    class MemoryUsage;
+    
     namespace Assets {
         class EntityDefinitionManager;
         class EntityModelManager;
         class TextureManager;
     }
     
+    namespace IO {
+        class ParserStatus;
+    }
+    
     namespace Model {
         class BrushFaceAttributes;
         class ChangeBrushFaceAttributesRequest;
@@ -57,6 +63,7 @@ namespace TrenchBroom {
         class Command;
         class Grid;
         class MapViewConfig;
+        class ProgressMonitor;
         class Selection;
         class UndoableCommand;
         class VertexHandleManager;
@@ -95,6 +102,10 @@ namespace TrenchBroom {
             mutable bool m_selectionBoundsValid;
             
             ViewEffectsService* m_viewEffectsService;
+            ProgressMonitor* m_progressMonitor;
+            
+            String m_clipboardText;
+            Model::NodeList m_clipboardNodes;
         public: // notification
             Notifier1<Command::Ptr> commandDoNotifier;
             Notifier1<Command::Ptr> commandDoneNotifier;
@@ -138,6 +149,9 @@ namespace TrenchBroom {
             
             Notifier0 pointFileWasLoadedNotifier;
             Notifier0 pointFileWasUnloadedNotifier;
+        protected: // coalesce change notifications during transactions and undo / redo
+            CoalescingNotifier<Model::Node*> m_nodesDidChange;
+            CoalescingNotifier<Model::BrushFace*> m_brushFacesDidChange;
         protected:
             MapDocument();
         public:
@@ -167,9 +181,10 @@ namespace TrenchBroom {
             Model::PointFile* pointFile() const;
             
             void setViewEffectsService(ViewEffectsService* viewEffectsService);
+            void setProgressMonitor(ProgressMonitor* progressMonitor);
         public: // new, load, save document
             void newDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game);
-            void loadDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
+            void loadDocument(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path, IO::ParserStatus& status);
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
@@ -183,6 +198,10 @@ namespace TrenchBroom {
             
             PasteType paste(const String& str);
         private:
+            class CloneClipboardNodes;
+            void setClipboardNodes(const String& str, const Model::NodeList& nodes);
+            void clearClipboardNodes();
+            
             bool pasteNodes(const Model::NodeList& nodes);
             bool pasteBrushFaces(const Model::BrushFaceList& faces);
         public: // point file management
@@ -322,6 +341,7 @@ namespace TrenchBroom {
             virtual void performRebuildBrushGeometry(const Model::BrushList& brushes) = 0;
         public: // debug commands
             void printVertices();
+            void measureMemoryUsage(MemoryUsage& usage) const;
         public: // command processing
             bool canUndoLastCommand() const;
             bool canRedoNextCommand() const;
@@ -336,6 +356,10 @@ namespace TrenchBroom {
             void rollbackTransaction();
             void commitTransaction();
             void cancelTransaction();
+            
+            void beginNotificationBatch();
+            void endNotificationBatch();
+            void flushNotificationBatch();
         private:
             bool submit(Command::Ptr command);
             bool submitAndStore(UndoableCommand::Ptr command);
@@ -348,6 +372,7 @@ namespace TrenchBroom {
             virtual void doRedoNextCommand() = 0;
             virtual bool doRepeatLastCommands() = 0;
             virtual void doClearRepeatableCommands() = 0;
+            virtual void doMeasureCommandMemoryUsage(MemoryUsage& usage) const = 0;
             
             virtual void doBeginTransaction(const String& name) = 0;
             virtual void doEndTransaction() = 0;
@@ -362,7 +387,7 @@ namespace TrenchBroom {
             Model::NodeList findNodesContaining(const Vec3& point) const;
         private: // world management
             void createWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game);
-            void loadWorld(Model::MapFormat::Type mapFormat, const BBox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
+            void setWorld(const BBox3& worldBounds, Model::World* world, Model::GameSPtr game, const IO::Path& path);
             void clearWorld();
             void initializeWorld(const BBox3& worldBounds);
         public: // asset management
@@ -432,8 +457,15 @@ namespace TrenchBroom {
             void preferenceDidChange(const IO::Path& path);
             void commandDone(Command::Ptr command);
             void commandUndone(UndoableCommand::Ptr command);
+            
+            void nodesWillChangeOrBeRemoved(const Model::NodeList& nodes);
+            void nodesWereRemoved(const Model::NodeList& nodes);
         };
 
+        /**
+         Groups the commands submitted during its lifetime into one undoable command. Notifications about
+         changed nodes and brush faces are coalesced and delivered once when the transaction ends.
+         */
         class Transaction {
         private:
             MapDocument* m_document;
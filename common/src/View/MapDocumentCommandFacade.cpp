@@ -20,6 +20,7 @@
 #include "MapDocumentCommandFacade.h"
 
 #include "CollectionUtils.h"
+#include "Exceptions.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "Assets/EntityDefinitionFileSpec.h"
@@ -40,8 +41,18 @@
 #include "Model/Snapshot.h"
 #include "Model/TransformObjectVisitor.h"
 #include "Model/World.h"
+#include "View/ProgressMonitor.h"
 #include "View/Selection.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace TrenchBroom {
     namespace View {
         MapDocumentSPtr MapDocumentCommandFacade::newMapDocument() {
@@ -249,7 +260,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performAddNodes(const Model::ParentChildrenMap& nodes) {
             const Model::NodeList parents = collectParents(nodes);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
             
             Model::NodeList addedNodes;
             for (const auto& entry : nodes) {
@@ -268,7 +279,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performRemoveNodes(const Model::ParentChildrenMap& nodes) {
             const Model::NodeList parents = collectParents(nodes);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
             
             const Model::NodeList allChildren = collectChildren(nodes);
             Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyChildren(nodesWillBeRemovedNotifier, nodesWereRemovedNotifier, allChildren);
@@ -405,8 +416,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             RenameGroupsVisitor visitor(newName);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -417,8 +428,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
 
             UndoRenameGroupsVisitor visitor(newNames);
             Model::Node::accept(std::begin(nodes), std::end(nodes), visitor);
@@ -441,11 +452,11 @@ namespace TrenchBroom {
           const Model::NodeList &nodes = m_selectedNodes.nodes();
           const Model::NodeList parents = collectParents(nodes);
 
-          Notifier1<const Model::NodeList &>::NotifyBeforeAndAfter
-              notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier,
+          CoalescingNotifier<Model::Node *>::NotifyBeforeAndAfter
+              notifyParents(nodesWillChangeNotifier, m_nodesDidChange,
                             parents);
-          Notifier1<const Model::NodeList &>::NotifyBeforeAndAfter notifyNodes(
-              nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+          CoalescingNotifier<Model::Node *>::NotifyBeforeAndAfter notifyNodes(
+              nodesWillChangeNotifier, m_nodesDidChange, nodes);
 
           Model::TransformObjectVisitor visitor(transform, lockTextures,
                                                 m_worldBounds);
@@ -459,8 +470,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
 
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Model::EntityAttributeSnapshot::Map snapshot;
             
@@ -479,8 +490,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             static const Model::AttributeValue DefaultValue = "";
             Model::EntityAttributeSnapshot::Map snapshot;
@@ -500,8 +511,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(attributableNodes.begin(), attributableNodes.end());
             const Model::NodeList parents = collectParents(nodes.begin(), nodes.end());
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Model::EntityAttributeSnapshot::Map snapshot;
             
@@ -533,8 +544,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             static const Model::AttributeValue DefaultValue = "";
             Model::EntityAttributeSnapshot::Map snapshot;
@@ -555,8 +566,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             for (Model::AttributableNode* node : attributableNodes)
                 node->renameAttribute(oldName, newName);
@@ -569,8 +580,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes(std::begin(attributableNodes), std::end(attributableNodes));
             
             const Model::NodeList parents = collectParents(std::begin(nodes), std::end(nodes));
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
 
             for (const auto& entry : attributes) {
                 Model::AttributableNode* node = entry.first;
@@ -602,8 +613,8 @@ namespace TrenchBroom {
             }
             
             const Model::NodeList parents = collectParents(std::begin(changedNodes), std::end(changedNodes));
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, changedNodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, changedNodes);
 
             for (Model::BrushFace* face : faces) {
                 Model::Brush* brush = face->brush();
@@ -620,66 +631,171 @@ namespace TrenchBroom {
         void MapDocumentCommandFacade::performMoveTextures(const Vec3f& cameraUp, const Vec3f& cameraRight, const Vec2f& delta) {
             for (Model::BrushFace* face : m_selectedBrushFaces)
                 face->moveTexture(cameraUp, cameraRight, delta);
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            m_brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performRotateTextures(const float angle) {
             for (Model::BrushFace* face : m_selectedBrushFaces)
                 face->rotateTexture(angle);
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            m_brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performShearTextures(const Vec2f& factors) {
             for (Model::BrushFace* face : m_selectedBrushFaces)
                 face->shearTexture(factors);
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            m_brushFacesDidChange(m_selectedBrushFaces);
         }
 
         void MapDocumentCommandFacade::performCopyTexCoordSystemFromFace(const Model::TexCoordSystemSnapshot* coordSystemSnapshot, const Vec3f& sourceFaceNormal) {
             for (Model::BrushFace* face : m_selectedBrushFaces)
                 face->copyTexCoordSystemFromFace(coordSystemSnapshot, sourceFaceNormal);
-            brushFacesDidChangeNotifier(m_selectedBrushFaces);
+            m_brushFacesDidChange(m_selectedBrushFaces);
         }
         
         void MapDocumentCommandFacade::performChangeBrushFaceAttributes(const Model::ChangeBrushFaceAttributesRequest& request) {
             const Model::BrushFaceList& faces = allSelectedBrushFaces();
             request.evaluate(faces);
             setTextures(faces);
-            brushFacesDidChangeNotifier(faces);
+            m_brushFacesDidChange(faces);
+        }
+
+        /**
+         Calls the given function for the index of every brush on worker threads while the main thread reports the
+         progress. The function must not modify the document. Returns false if the user cancelled the task. Small
+         selections are processed on the calling thread without reporting progress.
+         */
+        template <typename F>
+        bool MapDocumentCommandFacade::processBrushesConcurrently(const String& taskName, const Model::BrushList& brushes, F processBrush) {
+            const size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+            const size_t workerCount = std::min(maxWorkers, brushes.size() / MinBrushesPerWorker);
+            if (workerCount <= 1) {
+                for (size_t i = 0; i < brushes.size(); ++i)
+                    processBrush(i);
+                return true;
+            }
+            
+            // the workers take the next unprocessed brush until none are left, because brushes vary in cost
+            std::atomic<size_t> nextBrush(0);
+            std::atomic<size_t> processedBrushes(0);
+            std::atomic<bool> cancelled(false);
+            
+            // the main thread waits for the workers to finish and wakes up regularly to report progress
+            std::mutex workerMutex;
+            std::condition_variable workerFinished;
+            size_t finishedWorkers = 0;
+            
+            std::vector<std::exception_ptr> errors(workerCount);
+            std::vector<std::thread> workers;
+            workers.reserve(workerCount);
+            
+            for (size_t i = 0; i < workerCount; ++i) {
+                workers.push_back(std::thread([&brushes, &processBrush, &nextBrush, &processedBrushes, &cancelled, &workerMutex, &workerFinished, &finishedWorkers, &errors, i]() {
+                    try {
+                        for (size_t j = nextBrush++; j < brushes.size() && !cancelled; j = nextBrush++) {
+                            processBrush(j);
+                            ++processedBrushes;
+                        }
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                        cancelled = true;
+                    }
+                    
+                    {
+                        std::lock_guard<std::mutex> lock(workerMutex);
+                        ++finishedWorkers;
+                    }
+                    workerFinished.notify_one();
+                }));
+            }
+            
+            std::exception_ptr progressError;
+            try {
+                ProgressMonitor::Task task(m_progressMonitor, taskName);
+                std::unique_lock<std::mutex> lock(workerMutex);
+                while (finishedWorkers < workerCount) {
+                    // reporting progress may process events, so the workers must not be blocked meanwhile
+                    lock.unlock();
+                    task.progress(static_cast<double>(processedBrushes) / static_cast<double>(brushes.size()));
+                    lock.lock();
+                    
+                    workerFinished.wait_for(lock, std::chrono::milliseconds(50), [&finishedWorkers, workerCount]() {
+                        return finishedWorkers == workerCount;
+                    });
+                }
+            } catch (...) {
+                // the workers must be joined before the exception can be propagated
+                cancelled = true;
+                progressError = std::current_exception();
+            }
+            
+            for (std::thread& worker : workers)
+                worker.join();
+            
+            for (const std::exception_ptr& error : errors) {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+            
+            if (progressError) {
+                try {
+                    std::rethrow_exception(progressError);
+                } catch (const OperationCancelledException&) {
+                    info(taskName + " was cancelled");
+                    return false;
+                }
+            }
+            
+            return true;
         }
 
         Model::Snapshot* MapDocumentCommandFacade::performFindPlanePoints() {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
+            
+            std::vector<Vec3::List> planePoints(brushes.size());
+            const bool completed = processBrushesConcurrently("Finding Plane Points", brushes, [&brushes, &planePoints](const size_t i) {
+                planePoints[i] = brushes[i]->integerPlanePoints();
+            });
+            if (!completed)
+                return NULL;
+            
             Model::Snapshot* snapshot = new Model::Snapshot(std::begin(brushes), std::end(brushes));
             
             const Model::NodeList nodes(std::begin(brushes), std::end(brushes));
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
-            for (Model::Brush* brush : brushes)
-                brush->findIntegerPlanePoints(m_worldBounds);
+            for (size_t i = 0; i < brushes.size(); ++i)
+                brushes[i]->setPlanePoints(m_worldBounds, planePoints[i]);
             
             return snapshot;
         }
 
         Model::Snapshot* MapDocumentCommandFacade::performSnapVertices(const size_t snapTo) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
+            
+            std::vector<Model::BrushGeometry> snappedGeometries(brushes.size());
+            const bool completed = processBrushesConcurrently("Snapping Vertices", brushes, [&brushes, &snappedGeometries, snapTo](const size_t i) {
+                snappedGeometries[i] = brushes[i]->snappedGeometry(snapTo);
+            });
+            if (!completed)
+                return NULL;
+            
             Model::Snapshot* snapshot = new Model::Snapshot(std::begin(brushes), std::end(brushes));
 
             const Model::NodeList nodes(std::begin(brushes), std::end(brushes));
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
 
             size_t succeededBrushCount = 0;
             size_t failedBrushCount = 0;
 
-            for (Model::Brush* brush : brushes) {
-                if (brush->canSnapVertices(m_worldBounds, snapTo)) {
-                    brush->snapVertices(m_worldBounds, snapTo);
+            for (size_t i = 0; i < brushes.size(); ++i) {
+                if (snappedGeometries[i].polyhedron()) {
+                    brushes[i]->snapVertices(m_worldBounds, snapTo, snappedGeometries[i]);
                     succeededBrushCount += 1;
                 } else {
                     failedBrushCount += 1;
@@ -706,8 +822,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : vertices) {
@@ -726,8 +842,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Edge3::List newEdgePositions;
             for (const auto& entry : edges) {
@@ -744,8 +860,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Polygon3::List newFacePositions;
             for (const auto& entry : faces) {
@@ -764,8 +880,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : edges) {
@@ -786,8 +902,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : faces) {
@@ -808,8 +924,8 @@ namespace TrenchBroom {
             const Model::NodeList& nodes = m_selectedNodes.nodes();
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             Vec3::List newVertexPositions;
             for (const auto& entry : vertices) {
@@ -825,8 +941,8 @@ namespace TrenchBroom {
             const Model::NodeList nodes = VectorUtils::cast<Model::Node*>(brushes);
             const Model::NodeList parents = collectParents(nodes);
             
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             
             for (Model::Brush* brush : brushes)
                 brush->rebuildGeometry(m_worldBounds);
@@ -839,8 +955,8 @@ namespace TrenchBroom {
                 const Model::NodeList& nodes = m_selectedNodes.nodes();
                 const Model::NodeList parents = collectParents(nodes);
                 
-                Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
-                Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+                CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, m_nodesDidChange, parents);
+                CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
                 
                 snapshot->restoreNodes(m_worldBounds);
                 
@@ -851,13 +967,13 @@ namespace TrenchBroom {
             if (!brushFaces.empty()) {
                 snapshot->restoreBrushFaces();
                 setTextures(brushFaces);
-                brushFacesDidChangeNotifier(brushFaces);
+                m_brushFacesDidChange(brushFaces);
             }
         }
 
         void MapDocumentCommandFacade::performSetEntityDefinitionFile(const Assets::EntityDefinitionFileSpec& spec) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             Notifier0::NotifyAfter notifyEntityDefinitions(entityDefinitionsDidChangeNotifier);
             
             // to avoid backslashes being misinterpreted as escape sequences
@@ -868,7 +984,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performSetTextureCollections(const IO::Path::List& paths) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             Notifier0::NotifyAfter notifyTextureCollections(textureCollectionsDidChangeNotifier);
             
             unsetTextures();
@@ -879,7 +995,7 @@ namespace TrenchBroom {
 
         void MapDocumentCommandFacade::performSetMods(const StringList& mods) {
             const Model::NodeList nodes(1, m_world);
-            Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+            CoalescingNotifier<Model::Node*>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, m_nodesDidChange, nodes);
             Notifier0::NotifyAfter notifyMods(modsDidChangeNotifier);
 
             const String newValue = StringUtils::join(mods, ";");
@@ -964,6 +1080,10 @@ namespace TrenchBroom {
         void MapDocumentCommandFacade::doClearRepeatableCommands() {
             m_commandProcessor.clearRepeatableCommands();
         }
+        
+        void MapDocumentCommandFacade::doMeasureCommandMemoryUsage(MemoryUsage& usage) const {
+            m_commandProcessor.measureMemoryUsage(usage);
+        }
 
         void MapDocumentCommandFacade::doBeginTransaction(const String& name) {
             m_commandProcessor.beginGroup(name);
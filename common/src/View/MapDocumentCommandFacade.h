@@ -41,6 +41,8 @@ namespace TrenchBroom {
         
         class MapDocumentCommandFacade : public MapDocument {
         private:
+            static const size_t MinBrushesPerWorker = 64;
+            
             CommandProcessor m_commandProcessor;
         public:
             static MapDocumentSPtr newMapDocument();
@@ -103,6 +105,9 @@ namespace TrenchBroom {
             Vec3::List performSplitEdges(const Model::BrushEdgesMap& edges, const Vec3& delta);
             Vec3::List performSplitFaces(const Model::BrushFacesMap& faces, const Vec3& delta);
             void performRemoveVertices(const Model::BrushVerticesMap& vertices);
+        private:
+            template <typename F>
+            bool processBrushesConcurrently(const String& taskName, const Model::BrushList& brushes, F processBrush);
         private: // implement MapDocument operations
             void performRebuildBrushGeometry(const Model::BrushList& brushes);
         public: // snapshots and restoration
@@ -131,6 +136,7 @@ namespace TrenchBroom {
             void doRedoNextCommand();
             bool doRepeatLastCommands();
             void doClearRepeatableCommands();
+            void doMeasureCommandMemoryUsage(MemoryUsage& usage) const;
             
             void doBeginTransaction(const String& name);
             void doEndTransaction();
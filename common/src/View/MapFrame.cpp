@@ -20,9 +20,11 @@
 #include "MapFrame.h"
 
 #include "TrenchBroomApp.h"
+#include "MemoryUsage.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/IOUtils.h"
 #include "IO/ResourceUtils.h"
 #include "Model/AttributableNode.h"
 #include "Model/Brush.h"
@@ -34,6 +36,7 @@
 #include "Model/NodeCollection.h"
 #include "Model/PointFile.h"
 #include "Model/World.h"
+#include "Renderer/RenderProfiler.h"
 #include "View/ActionManager.h"
 #include "View/Autosaver.h"
 #include "View/BorderLine.h"
@@ -52,17 +55,22 @@
 #include "View/MapFrameDropTarget.h"
 #include "View/Menu.h"
 #include "View/OpenClipboard.h"
+#include "View/ProgressDialogMonitor.h"
+#include "View/ProgressDialogParserStatus.h"
 #include "View/RenderView.h"
 #include "View/ReplaceTextureDialog.h"
 #include "View/SplitterWindow2.h"
 #include "View/SwitchableMapViewContainer.h"
 #include "View/VertexTool.h"
+#include "View/ViewConstants.h"
 #include "View/ViewUtils.h"
 #include "View/wxUtils.h"
 
 #include <wx/clipbrd.h>
 #include <wx/display.h>
 #include <wx/filedlg.h>
+#include <wx/filename.h>
+#include <wx/textctrl.h>
 #include <wx/textdlg.h>
 #include <wx/msgdlg.h>
 #include <wx/persist.h>
@@ -75,6 +83,7 @@
 #include <wx/statusbr.h>
 
 #include <cassert>
+#include <cstdio>
 
 namespace TrenchBroom {
     namespace View {
@@ -90,6 +99,7 @@ namespace TrenchBroom {
         m_lastFocus(NULL),
         m_gridChoice(NULL),
         m_compilationDialog(NULL),
+        m_progressMonitor(NULL),
         m_updateLocker(NULL) {}
 
         MapFrame::MapFrame(FrameManager* frameManager, MapDocumentSPtr document) :
@@ -104,6 +114,7 @@ namespace TrenchBroom {
         m_lastFocus(NULL),
         m_gridChoice(NULL),
         m_compilationDialog(NULL),
+        m_progressMonitor(NULL),
         m_updateLocker(NULL) {
             Create(frameManager, document);
         }
@@ -125,6 +136,9 @@ namespace TrenchBroom {
 
             m_document->setParentLogger(logger());
             m_document->setViewEffectsService(m_mapView);
+            
+            m_progressMonitor = new ProgressDialogMonitor(this);
+            m_document->setProgressMonitor(m_progressMonitor);
 
             m_autosaveTimer = new wxTimer(this);
             m_autosaveTimer->Start(1000);
@@ -185,7 +199,11 @@ namespace TrenchBroom {
             DestroyChildren(); // Destroy the children first because they might still access document resources.
             
             m_document->setViewEffectsService(NULL);
+            m_document->setProgressMonitor(NULL);
             m_document.reset();
+            
+            delete m_progressMonitor;
+            m_progressMonitor = NULL;
 
             delete m_contextManager;
             m_contextManager = NULL;
@@ -239,7 +257,11 @@ namespace TrenchBroom {
         bool MapFrame::openDocument(Model::GameSPtr game, const Model::MapFormat::Type mapFormat, const IO::Path& path) {
             if (!confirmOrDiscardChanges())
                 return false;
-            m_document->loadDocument(mapFormat, MapDocument::DefaultWorldBounds, game, path);
+            
+            const wxULongLong fileSize = wxFileName(path.asString()).GetSize();
+            const size_t totalBytes = fileSize == wxInvalidSize ? 0 : static_cast<size_t>(fileSize.GetValue());
+            ProgressDialogParserStatus status(logger(), this, "Loading " + path.lastComponent().asString(), totalBytes);
+            m_document->loadDocument(mapFormat, MapDocument::DefaultWorldBounds, game, path, status);
             return true;
         }
 
@@ -707,6 +729,8 @@ namespace TrenchBroom {
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleMaximizeCurrentView, this, CommandIds::Menu::ViewToggleMaximizeCurrentView);
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleInfoPanel, this, CommandIds::Menu::ViewToggleInfoPanel);
             Bind(wxEVT_MENU, &MapFrame::OnViewToggleInspector, this, CommandIds::Menu::ViewToggleInspector);
+            Bind(wxEVT_MENU, &MapFrame::OnViewToggleShowRenderStatistics, this, CommandIds::Menu::ViewToggleShowRenderStatistics);
+            Bind(wxEVT_MENU, &MapFrame::OnViewSaveRenderStatistics, this, CommandIds::Menu::ViewSaveRenderStatistics);
 
             Bind(wxEVT_MENU, &MapFrame::OnRunCompile, this, CommandIds::Menu::RunCompile);
             Bind(wxEVT_MENU, &MapFrame::OnRunLaunch, this, CommandIds::Menu::RunLaunch);
@@ -717,6 +741,7 @@ namespace TrenchBroom {
             Bind(wxEVT_MENU, &MapFrame::OnDebugClipBrush, this, CommandIds::Menu::DebugClipWithFace);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCopyJSShortcutMap, this, CommandIds::Menu::DebugCopyJSShortcuts);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCrash, this, CommandIds::Menu::DebugCrash);
+            Bind(wxEVT_MENU, &MapFrame::OnDebugShowMemoryUsage, this, CommandIds::Menu::DebugShowMemoryUsage);
 
             Bind(wxEVT_MENU, &MapFrame::OnFlipObjectsHorizontally, this, CommandIds::Actions::FlipObjectsHorizontally);
             Bind(wxEVT_MENU, &MapFrame::OnFlipObjectsVertically, this, CommandIds::Actions::FlipObjectsVertically);
@@ -1204,6 +1229,31 @@ namespace TrenchBroom {
                 m_hSplitter->maximize(m_vSplitter);
         }
 
+        void MapFrame::OnViewToggleShowRenderStatistics(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            Renderer::RenderProfiler& profiler = m_contextManager->renderProfiler();
+            profiler.setEnabled(!profiler.enabled());
+            m_mapView->Refresh();
+        }
+
+        void MapFrame::OnViewSaveRenderStatistics(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            wxFileDialog saveDialog(this, "Save Render Statistics", "", "RenderStatistics.txt", "Text files (*.txt)|*.txt", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+            if (saveDialog.ShowModal() == wxID_CANCEL)
+                return;
+
+            const IO::Path path(saveDialog.GetPath().ToStdString());
+            try {
+                IO::OpenFile open(path, true);
+                std::fputs(m_contextManager->renderProfiler().asString().c_str(), open.file);
+                logger()->info("Saved render statistics to " + path.asString());
+            } catch (FileSystemException e) {
+                ::wxMessageBox(e.what(), "", wxOK | wxICON_ERROR, this);
+            }
+        }
+
         void MapFrame::OnRunCompile(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
             
@@ -1312,6 +1362,24 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::OnDebugShowMemoryUsage(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            MemoryUsage usage;
+            m_document->measureMemoryUsage(usage);
+            m_contextManager->measureMemoryUsage(usage);
+            
+            wxDialog dialog(this, wxID_ANY, "Memory Usage", wxDefaultPosition, wxDefaultSize, wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER);
+            wxTextCtrl* text = new wxTextCtrl(&dialog, wxID_ANY, usage.asString(), wxDefaultPosition, wxSize(600, 400), wxTE_MULTILINE | wxTE_READONLY | wxTE_DONTWRAP);
+            text->SetFont(Fonts::fixedWidthFont());
+            
+            wxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+            sizer->Add(text, 1, wxEXPAND | wxALL, LayoutConstants::DialogOuterMargin);
+            sizer->Add(wrapDialogButtonSizer(dialog.CreateStdDialogButtonSizer(wxOK), &dialog), 0, wxEXPAND);
+            dialog.SetSizerAndFit(sizer);
+            dialog.ShowModal();
+        }
+
         void MapFrame::OnFlipObjectsHorizontally(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
             m_mapView->flipObjects(Math::Direction_Left);
@@ -1538,6 +1606,13 @@ namespace TrenchBroom {
                     event.Enable(true);
                     event.Check(!m_hSplitter->isMaximized(m_vSplitter));
                     break;
+                case CommandIds::Menu::ViewToggleShowRenderStatistics:
+                    event.Enable(true);
+                    event.Check(m_contextManager->renderProfiler().enabled());
+                    break;
+                case CommandIds::Menu::ViewSaveRenderStatistics:
+                    event.Enable(!m_contextManager->renderProfiler().views().empty());
+                    break;
                 case CommandIds::Menu::RunCompile:
                     event.Enable(canCompile());
                     break;
@@ -1549,6 +1624,7 @@ namespace TrenchBroom {
                 case CommandIds::Menu::DebugCreateCube:
                 case CommandIds::Menu::DebugCopyJSShortcuts:
                 case CommandIds::Menu::DebugCrash:
+                case CommandIds::Menu::DebugShowMemoryUsage:
                     event.Enable(true);
                     break;
                 case CommandIds::Menu::DebugClipWithFace:
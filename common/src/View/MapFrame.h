@@ -49,6 +49,7 @@ namespace TrenchBroom {
         class FrameManager;
         class GLContextManager;
         class Inspector;
+        class ProgressDialogMonitor;
         class SwitchableMapViewContainer;
 
         class MapFrame : public wxFrame {
@@ -75,6 +76,8 @@ namespace TrenchBroom {
             
             wxDialog* m_compilationDialog;
             
+            ProgressDialogMonitor* m_progressMonitor;
+            
             CommandWindowUpdateLocker* m_updateLocker;
         public:
             MapFrame();
@@ -209,6 +212,8 @@ namespace TrenchBroom {
             void OnViewToggleMaximizeCurrentView(wxCommandEvent& event);
             void OnViewToggleInfoPanel(wxCommandEvent& event);
             void OnViewToggleInspector(wxCommandEvent& event);
+            void OnViewToggleShowRenderStatistics(wxCommandEvent& event);
+            void OnViewSaveRenderStatistics(wxCommandEvent& event);
 
             void OnRunCompile(wxCommandEvent& event);
         public:
@@ -222,6 +227,7 @@ namespace TrenchBroom {
             void OnDebugClipBrush(wxCommandEvent& event);
             void OnDebugCopyJSShortcutMap(wxCommandEvent& event);
             void OnDebugCrash(wxCommandEvent& event);
+            void OnDebugShowMemoryUsage(wxCommandEvent& event);
             
             void OnFlipObjectsHorizontally(wxCommandEvent& event);
             void OnFlipObjectsVertically(wxCommandEvent& event);
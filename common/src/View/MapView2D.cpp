@@ -213,8 +213,11 @@ namespace TrenchBroom {
             Transaction transaction(document, "Select Tall");
             document->deleteObjects();
 
+            const Math::Axis::Type axis = m_camera.direction().firstComponent();
+            const Model::NodeList candidates = document->world()->findNodesIntersecting(tallBrushes, axis);
+            
             Model::CollectContainedNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(tallBrushes), std::end(tallBrushes), document->editorContext());
-            document->world()->acceptAndRecurse(visitor);
+            Model::Node::acceptAndRecurse(std::begin(candidates), std::end(candidates), visitor);
             document->select(visitor.nodes());
 
             VectorUtils::clearAndDelete(tallBrushes);
@@ -313,6 +316,17 @@ namespace TrenchBroom {
             return false;
         }
         
+        String MapView2D::doGetViewName() const {
+            switch (m_camera.direction().firstComponent()) {
+                case Math::Axis::AX:
+                    return "YZ View";
+                case Math::Axis::AY:
+                    return "XZ View";
+                default:
+                    return "XY View";
+            }
+        }
+        
         Renderer::RenderContext::RenderMode MapView2D::doGetRenderMode() {
             return Renderer::RenderContext::RenderMode_2D;
         }
@@ -86,6 +86,7 @@ namespace TrenchBroom {
             wxAcceleratorTable doCreateAccelerationTable(ActionContext context) const;
             bool doCancel();
             
+            String doGetViewName() const;
             Renderer::RenderContext::RenderMode doGetRenderMode();
             Renderer::Camera& doGetCamera();
             void doRenderGrid(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
@@ -561,6 +561,10 @@ namespace TrenchBroom {
             return false;
         }
         
+        String MapView3D::doGetViewName() const {
+            return "3D View";
+        }
+        
         Renderer::RenderContext::RenderMode MapView3D::doGetRenderMode() {
             return Renderer::RenderContext::RenderMode_3D;
         }
@@ -19,10 +19,12 @@
 
 #include "MapViewBase.h"
 
+#include "AttrString.h"
 #include "Logger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Assets/EntityModelManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -45,6 +47,7 @@
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/MapRenderer.h"
 #include "Renderer/RenderBatch.h"
+#include "Renderer/RenderProfiler.h"
 #include "Renderer/RenderService.h"
 #include "View/ActionManager.h"
 #include "View/Animation.h"
@@ -62,6 +65,7 @@
 
 #include <wx/frame.h>
 #include <wx/menu.h>
+#include <wx/timer.h>
 
 #include <algorithm>
 #include <iterator>
@@ -91,6 +95,7 @@ namespace TrenchBroom {
         m_document(document),
         m_toolBox(toolBox),
         m_animationManager(new AnimationManager()),
+        m_entityModelTimer(new wxTimer(this)),
         m_renderer(renderer),
         m_compass(NULL) {
             setToolBox(toolBox);
@@ -108,6 +113,7 @@ namespace TrenchBroom {
             m_toolBox.removeWindow(this);
             unbindObservers();
             m_animationManager->Delete();
+            delete m_entityModelTimer;
             delete m_compass;
         }
 
@@ -232,6 +238,7 @@ namespace TrenchBroom {
 		void MapViewBase::bindEvents() {
             Bind(wxEVT_SET_FOCUS, &MapViewBase::OnSetFocus, this);
             Bind(wxEVT_KILL_FOCUS, &MapViewBase::OnKillFocus, this);
+            Bind(wxEVT_TIMER, &MapViewBase::OnEntityModelTimer, this, m_entityModelTimer->GetId());
 
             Bind(wxEVT_MENU, &MapViewBase::OnToggleClipSide,               this, CommandIds::Actions::ToggleClipSide);
             Bind(wxEVT_MENU, &MapViewBase::OnPerformClip,                  this, CommandIds::Actions::PerformClip);
@@ -742,6 +749,12 @@ namespace TrenchBroom {
             event.Skip();
         }
 
+        void MapViewBase::OnEntityModelTimer(wxTimerEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            Refresh();
+        }
+
         void MapViewBase::OnActivateFrame(wxActivateEvent& event) {
             if (IsBeingDeleted()) return;
 
@@ -839,11 +852,15 @@ namespace TrenchBroom {
         }
 
         void MapViewBase::doRender() {
+            // a new frame is shown before its document has loaded a world, and loading may process paint events
+            MapDocumentSPtr document = lock(m_document);
+            if (document->world() == NULL)
+                return;
+            
             const IO::Path& fontPath = pref(Preferences::RendererFontPath());
             const size_t fontSize = static_cast<size_t>(pref(Preferences::RendererFontSize));
             const Renderer::FontDescriptor fontDescriptor(fontPath, fontSize);
 
-            MapDocumentSPtr document = lock(m_document);
             const MapViewConfig& mapViewConfig = document->mapViewConfig();
             const Grid& grid = document->grid();
 
@@ -860,20 +877,36 @@ namespace TrenchBroom {
             renderContext.setShowGrid(grid.visible());
             renderContext.setGridSize(grid.actualSize());
 
+            Renderer::RenderProfiler& profiler = renderProfiler();
+            profiler.beginFrame(doGetViewName());
+            Renderer::RenderProfiler* batchProfiler = profiler.enabled() ? &profiler : NULL;
+
             setupGL(renderContext);
             setRenderOptions(renderContext);
 
-            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
+            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo(), batchProfiler);
 
-            doRenderGrid(renderContext, renderBatch);
-            doRenderMap(m_renderer, renderContext, renderBatch);
-            doRenderTools(m_toolBox, renderContext, renderBatch);
-            doRenderExtras(renderContext, renderBatch);
-            renderCoordinateSystem(renderContext, renderBatch);
-            renderPointFile(renderContext, renderBatch);
-            renderCompass(renderBatch);
+            {
+                Renderer::RenderProfiler::Scope buildScope(batchProfiler, "Build batch");
+                doRenderGrid(renderContext, renderBatch);
+                {
+                    Renderer::RenderProfiler::Scope mapScope(batchProfiler, "Map renderer");
+                    doRenderMap(m_renderer, renderContext, renderBatch);
+                }
+                doRenderTools(m_toolBox, renderContext, renderBatch);
+                doRenderExtras(renderContext, renderBatch);
+                renderCoordinateSystem(renderContext, renderBatch);
+                renderPointFile(renderContext, renderBatch);
+                renderCompass(renderBatch);
+                renderRenderStatistics(renderContext, renderBatch);
+            }
             
             renderBatch.render(renderContext);
+            profiler.endFrame();
+            
+            // entity models are parsed in the background, keep polling until they are all available
+            if (document->entityModelManager().hasPendingModels() && !m_entityModelTimer->IsRunning())
+                m_entityModelTimer->Start(50, wxTIMER_ONE_SHOT);
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
@@ -911,6 +944,24 @@ namespace TrenchBroom {
                 m_compass->render(renderBatch);
         }
         
+        void MapViewBase::renderRenderStatistics(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            const Renderer::RenderProfiler& profiler = renderProfiler();
+            if (!profiler.enabled())
+                return;
+            
+            // GPU times arrive with a delay, so this shows the last frame which has been completed
+            const Renderer::RenderProfiler::SectionList& sections = profiler.lastFrame(doGetViewName());
+            if (sections.empty())
+                return;
+            
+            AttrString string;
+            for (const Renderer::RenderProfiler::Section& section : sections)
+                string.appendLeftJustified(section.asString());
+            
+            Renderer::RenderService renderService(renderContext, renderBatch);
+            renderService.renderHeadsUp(string);
+        }
+        
         static bool isEntity(const Model::Node* node) {
             class IsEntity : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
             private:
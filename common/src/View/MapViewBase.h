@@ -33,6 +33,9 @@
 #include "View/UndoableCommand.h"
 #include "View/ViewTypes.h"
 
+class wxTimer;
+class wxTimerEvent;
+
 namespace TrenchBroom {
     class Logger;
     
@@ -73,6 +76,7 @@ namespace TrenchBroom {
             
             AnimationManager* m_animationManager;
         private:
+            wxTimer* m_entityModelTimer;
             Renderer::MapRenderer& m_renderer;
             Renderer::Compass* m_compass;
         protected:
@@ -182,6 +186,7 @@ namespace TrenchBroom {
         private: // other events
             void OnSetFocus(wxFocusEvent& event);
             void OnKillFocus(wxFocusEvent& event);
+            void OnEntityModelTimer(wxTimerEvent& event);
             void OnActivateFrame(wxActivateEvent& event);
         protected: // accelerator table management
             void updateAcceleratorTable();
@@ -205,6 +210,7 @@ namespace TrenchBroom {
             void renderCoordinateSystem(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderPointFile(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
             void renderCompass(Renderer::RenderBatch& renderBatch);
+            void renderRenderStatistics(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch);
         private: // implement ToolBoxConnector
             void doShowPopupMenu();
             wxMenu* makeEntityGroupsMenu(Assets::EntityDefinition::Type type, int id);
@@ -223,6 +229,7 @@ namespace TrenchBroom {
             virtual wxAcceleratorTable doCreateAccelerationTable(ActionContext context) const = 0;
             virtual bool doCancel() = 0;
             
+            virtual String doGetViewName() const = 0;
             virtual Renderer::RenderContext::RenderMode doGetRenderMode() = 0;
             virtual Renderer::Camera& doGetCamera() = 0;
             virtual void doRenderGrid(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) = 0;
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProgressDialogMonitor.h"
+
+#include "Exceptions.h"
+
+#include <wx/progdlg.h>
+
+namespace TrenchBroom {
+    namespace View {
+        ProgressDialogMonitor::ProgressDialogMonitor(wxWindow* parent) :
+        m_parent(parent),
+        m_dialog(NULL),
+        m_lastValue(-1) {}
+        
+        ProgressDialogMonitor::~ProgressDialogMonitor() {
+            destroyDialog();
+        }
+
+        void ProgressDialogMonitor::doBeginTask(const String& name) {
+            destroyDialog();
+            m_name = name;
+            m_lastValue = -1;
+            m_stopWatch.Start();
+        }
+        
+        void ProgressDialogMonitor::doProgress(const double progress, const String& message) {
+            const int value = static_cast<int>(progress * Range);
+            if (value == m_lastValue)
+                return;
+            m_lastValue = value;
+            
+            const String& text = message.empty() ? m_name : message;
+            if (m_dialog == NULL) {
+                if (m_stopWatch.Time() < ShowDelay)
+                    return;
+                m_dialog = new wxProgressDialog(m_name, text, Range, m_parent, wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+            }
+            
+            if (!m_dialog->Update(value, text))
+                throw OperationCancelledException(m_name + " was cancelled");
+        }
+        
+        void ProgressDialogMonitor::doEndTask() {
+            destroyDialog();
+        }
+
+        void ProgressDialogMonitor::destroyDialog() {
+            if (m_dialog != NULL) {
+                m_dialog->Destroy();
+                m_dialog = NULL;
+            }
+        }
+    }
+}
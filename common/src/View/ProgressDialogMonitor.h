@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ProgressDialogMonitor
+#define TrenchBroom_ProgressDialogMonitor
+
+#include "StringUtils.h"
+#include "View/ProgressMonitor.h"
+
+#include <wx/stopwatch.h>
+
+class wxProgressDialog;
+class wxWindow;
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         Shows the progress of a task in a modal progress dialog that lets the user cancel the task. The dialog only
+         appears if the task takes noticeably long, so that short tasks do not flash a dialog. The dialog shows the
+         task name unless a message is given with the progress.
+         */
+        class ProgressDialogMonitor : public ProgressMonitor {
+        private:
+            static const long ShowDelay = 500;
+            static const int Range = 1000;
+            
+            wxWindow* m_parent;
+            String m_name;
+            wxStopWatch m_stopWatch;
+            wxProgressDialog* m_dialog;
+            int m_lastValue;
+        public:
+            ProgressDialogMonitor(wxWindow* parent);
+            ~ProgressDialogMonitor();
+        private:
+            void doBeginTask(const String& name);
+            void doProgress(double progress, const String& message);
+            void doEndTask();
+            
+            void destroyDialog();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ProgressDialogMonitor) */
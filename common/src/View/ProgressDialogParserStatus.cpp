@@ -0,0 +1,43 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProgressDialogParserStatus.h"
+
+namespace TrenchBroom {
+    namespace View {
+        ProgressDialogParserStatus::ProgressDialogParserStatus(Logger* logger, wxWindow* parent, const String& title, const size_t totalBytes) :
+        ParserStatus(logger),
+        m_totalBytes(totalBytes),
+        m_monitor(parent),
+        m_task(&m_monitor, title) {}
+        
+        void ProgressDialogParserStatus::doProgress(const double progress) {
+            m_monitor.progress(progress, message(progress));
+        }
+
+        String ProgressDialogParserStatus::message(const double progress) const {
+            static const double MiB = 1024.0 * 1024.0;
+            
+            StringStream msg;
+            msg.precision(1);
+            msg << std::fixed << progress * static_cast<double>(m_totalBytes) / MiB << " of " << static_cast<double>(m_totalBytes) / MiB << " MB read";
+            return msg.str();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ProgressDialogParserStatus
+#define TrenchBroom_ProgressDialogParserStatus
+
+#include "StringUtils.h"
+#include "IO/ParserStatus.h"
+#include "View/ProgressDialogMonitor.h"
+
+class wxWindow;
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         Reports parser progress in a progress dialog monitor that lets the user cancel parsing. The parser
+         status runs a single task for its lifetime and shows how many bytes have been read.
+         */
+        class ProgressDialogParserStatus : public IO::ParserStatus {
+        private:
+            size_t m_totalBytes;
+            ProgressDialogMonitor m_monitor;
+            ProgressMonitor::Task m_task;
+        public:
+            ProgressDialogParserStatus(Logger* logger, wxWindow* parent, const String& title, size_t totalBytes);
+        private:
+            void doProgress(double progress);
+            String message(double progress) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ProgressDialogParserStatus) */
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProgressMonitor.h"
+
+namespace TrenchBroom {
+    namespace View {
+        ProgressMonitor::Task::Task(ProgressMonitor* monitor, const String& name) :
+        m_monitor(monitor) {
+            if (m_monitor != NULL)
+                m_monitor->beginTask(name);
+        }
+        
+        ProgressMonitor::Task::~Task() {
+            if (m_monitor != NULL)
+                m_monitor->endTask();
+        }
+        
+        void ProgressMonitor::Task::progress(const double progress) {
+            if (m_monitor != NULL)
+                m_monitor->progress(progress);
+        }
+
+        ProgressMonitor::~ProgressMonitor() {}
+        
+        void ProgressMonitor::beginTask(const String& name) {
+            doBeginTask(name);
+        }
+        
+        void ProgressMonitor::progress(const double progress) {
+            doProgress(progress, "");
+        }
+        
+        void ProgressMonitor::progress(const double progress, const String& message) {
+            doProgress(progress, message);
+        }
+        
+        void ProgressMonitor::endTask() {
+            doEndTask();
+        }
+    }
+}
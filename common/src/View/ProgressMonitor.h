@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ProgressMonitor
+#define TrenchBroom_ProgressMonitor
+
+#include "StringUtils.h"
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         Shows the progress of long running document operations to the user. Progress may only be reported from the
+         main thread, and reporting it throws OperationCancelledException if the user cancelled the operation.
+         */
+        class ProgressMonitor {
+        public:
+            /**
+             Begins a task when constructed and ends it when destroyed. The monitor may be null, in which case no
+             progress is shown and the task cannot be cancelled.
+             */
+            class Task {
+            private:
+                ProgressMonitor* m_monitor;
+            public:
+                Task(ProgressMonitor* monitor, const String& name);
+                ~Task();
+                
+                void progress(double progress);
+            private:
+                Task(const Task&);
+                Task& operator=(const Task&);
+            };
+        public:
+            virtual ~ProgressMonitor();
+            
+            void beginTask(const String& name);
+            void progress(double progress);
+            void progress(double progress, const String& message);
+            void endTask();
+        private:
+            virtual void doBeginTask(const String& name) = 0;
+            virtual void doProgress(double progress, const String& message) = 0;
+            virtual void doEndTask() = 0;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ProgressMonitor) */
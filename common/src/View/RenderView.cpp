@@ -99,6 +99,10 @@ namespace TrenchBroom {
             return m_glContext->shaderManager();
         }
 
+        Renderer::RenderProfiler& RenderView::renderProfiler() {
+            return m_glContext->renderProfiler();
+        }
+
         int RenderView::depthBits() const {
             return GLAttribs::depth();
         }
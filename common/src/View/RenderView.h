@@ -31,6 +31,7 @@ namespace TrenchBroom {
     namespace Renderer {
         class FontManager;
         class RenderContext;
+        class RenderProfiler;
         class ShaderManager;
     }
 
@@ -57,6 +58,7 @@ namespace TrenchBroom {
             Renderer::Vbo& indexVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
+            Renderer::RenderProfiler& renderProfiler();
             
             int depthBits() const;
             bool multisample() const;
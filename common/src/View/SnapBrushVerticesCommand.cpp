@@ -46,7 +46,7 @@ namespace TrenchBroom {
         bool SnapBrushVerticesCommand::doPerformDo(MapDocumentCommandFacade* document) {
             assert(m_snapshot == NULL);
             m_snapshot = document->performSnapVertices(m_snapTo);
-            return true;
+            return m_snapshot != NULL;
         }
         
         bool SnapBrushVerticesCommand::doPerformUndo(MapDocumentCommandFacade* document) {
@@ -65,5 +65,9 @@ namespace TrenchBroom {
             SnapBrushVerticesCommand* other = static_cast<SnapBrushVerticesCommand*>(command.get());
             return other->m_snapTo == m_snapTo;
         }
+        
+        size_t SnapBrushVerticesCommand::doGetMemoryUsage() const {
+            return sizeof(SnapBrushVerticesCommand) + (m_snapshot != NULL ? m_snapshot->memoryUsage() : 0);
+        }
     }
 }
@@ -51,6 +51,8 @@ namespace TrenchBroom {
             bool doIsRepeatable(MapDocumentCommandFacade* document) const;
 
             bool doCollateWith(UndoableCommand::Ptr command);
+            
+            size_t doGetMemoryUsage() const;
         };
     }
 }
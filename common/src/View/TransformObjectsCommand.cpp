@@ -94,5 +94,9 @@ namespace TrenchBroom {
             m_transform = m_transform * other->m_transform;
             return true;
         }
+        
+        size_t TransformObjectsCommand::doGetMemoryUsage() const {
+            return sizeof(TransformObjectsCommand) + (m_snapshot != NULL ? m_snapshot->memoryUsage() : 0);
+        }
     }
 }
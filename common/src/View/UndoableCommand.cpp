@@ -58,6 +58,10 @@ namespace TrenchBroom {
             return doCollateWith(command);
         }
 
+        size_t UndoableCommand::memoryUsage() const {
+            return doGetMemoryUsage();
+        }
+        
         bool UndoableCommand::doIsRepeatDelimiter() const {
             return false;
         }
@@ -66,6 +70,10 @@ namespace TrenchBroom {
             throw CommandProcessorException("Command is not repeatable");
         }
 
+        size_t UndoableCommand::doGetMemoryUsage() const {
+            return sizeof(UndoableCommand);
+        }
+        
         size_t UndoableCommand::documentModificationCount() const {
             throw CommandProcessorException("Command does not modify the document");
         }
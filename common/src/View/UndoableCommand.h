@@ -41,6 +41,9 @@ namespace TrenchBroom {
             UndoableCommand::Ptr repeat(MapDocumentCommandFacade* document) const;
             
             virtual bool collateWith(UndoableCommand::Ptr command);
+            
+            // the approximate number of bytes this command holds on to in order to be undone or redone
+            size_t memoryUsage() const;
         private:
             virtual bool doPerformUndo(MapDocumentCommandFacade* document) = 0;
             
@@ -49,6 +52,8 @@ namespace TrenchBroom {
             virtual UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             virtual bool doCollateWith(UndoableCommand::Ptr command) = 0;
+            
+            virtual size_t doGetMemoryUsage() const;
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
         private:
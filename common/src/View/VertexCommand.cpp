@@ -166,5 +166,9 @@ namespace TrenchBroom {
         void VertexCommand::selectOldHandlePositions(VertexHandleManager& manager) {
             doSelectOldHandlePositions(manager, m_brushes);
         }
+        
+        size_t VertexCommand::doGetMemoryUsage() const {
+            return sizeof(VertexCommand) + (m_snapshot != NULL ? m_snapshot->memoryUsage() : 0);
+        }
     }
 }
@@ -50,6 +50,7 @@ namespace TrenchBroom {
         m_selectedEdgeCount(0),
         m_totalFaceCount(0),
         m_selectedFaceCount(0),
+        m_handleIndicesValid(false),
         m_guideRenderer(document),
         m_renderStateValid(false) {}
         
@@ -137,6 +138,21 @@ namespace TrenchBroom {
             return result;
         }
 
+        const HandlePositionIndex& VertexHandleManager::vertexHandleIndex() const {
+            validateHandleIndices();
+            return m_vertexHandleIndex;
+        }
+        
+        const HandlePositionIndex& VertexHandleManager::edgeHandleIndex() const {
+            validateHandleIndices();
+            return m_edgeHandleIndex;
+        }
+        
+        const HandlePositionIndex& VertexHandleManager::faceHandleIndex() const {
+            validateHandleIndices();
+            return m_faceHandleIndex;
+        }
+        
         bool VertexHandleManager::isHandleSelected(const Vec3& position) const {
             return (isVertexHandleSelected(position) ||
                     isEdgeHandleSelected(position) ||
@@ -272,6 +288,7 @@ namespace TrenchBroom {
             }
             m_totalFaceCount += brush->faceCount();
             
+            m_handleIndicesValid = false;
             m_renderStateValid = false;
         }
         
@@ -311,6 +328,7 @@ namespace TrenchBroom {
             ensure(m_totalFaceCount >= brush->faceCount(), "brush faces exceed total faces");
             m_totalFaceCount -= brush->faceCount();
             
+            m_handleIndicesValid = false;
             m_renderStateValid = false;
         }
         
@@ -327,6 +345,7 @@ namespace TrenchBroom {
             m_selectedFaceHandles.clear();
             m_totalFaceCount = 0;
             m_selectedFaceCount = 0;
+            m_handleIndicesValid = false;
             m_renderStateValid = false;
         }
         
@@ -515,53 +534,13 @@ namespace TrenchBroom {
         }
 
         void VertexHandleManager::pick(const Ray3& ray, const Renderer::Camera& camera, Model::PickResult& pickResult, bool splitMode) const {
-            if ((m_selectedEdgeHandles.empty() && m_selectedFaceHandles.empty()) || splitMode) {
-                for (const auto& entry : m_unselectedVertexHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, VertexHandleHit);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
-                }
-            }
-
-            for (const auto& entry : m_selectedVertexHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, VertexHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
-            
-            if (m_selectedVertexHandles.empty() && m_selectedFaceHandles.empty() && !splitMode) {
-                for (const auto& entry : m_unselectedEdgeHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, EdgeHandleHit);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
-                }
-            }
+            const bool includeUnselectedVertices = (m_selectedEdgeHandles.empty() && m_selectedFaceHandles.empty()) || splitMode;
+            const bool includeUnselectedEdges = m_selectedVertexHandles.empty() && m_selectedFaceHandles.empty() && !splitMode;
+            const bool includeUnselectedFaces = m_selectedVertexHandles.empty() && m_selectedEdgeHandles.empty() && !splitMode;
             
-            for (const auto& entry : m_selectedEdgeHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, EdgeHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
-            
-            if (m_selectedVertexHandles.empty() && m_selectedEdgeHandles.empty() && !splitMode) {
-                for (const auto& entry : m_unselectedFaceHandles) {
-                    const Vec3& position = entry.first;
-                    const Model::Hit hit = pickHandle(ray, camera, position, FaceHandleHit);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
-                }
-            }
-            
-            for (const auto& entry : m_selectedFaceHandles) {
-                const Vec3& position = entry.first;
-                const Model::Hit hit = pickHandle(ray, camera, position, FaceHandleHit);
-                if (hit.isMatch())
-                    pickResult.addHit(hit);
-            }
+            pickHandles(ray, camera, vertexHandleIndex(), m_selectedVertexHandles, includeUnselectedVertices, VertexHandleHit, pickResult);
+            pickHandles(ray, camera, edgeHandleIndex(), m_selectedEdgeHandles, includeUnselectedEdges, EdgeHandleHit, pickResult);
+            pickHandles(ray, camera, faceHandleIndex(), m_selectedFaceHandles, includeUnselectedFaces, FaceHandleHit, pickResult);
         }
 
         void VertexHandleManager::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch, const bool splitMode) {
@@ -678,6 +657,26 @@ namespace TrenchBroom {
             return result;
         }
 
+        Vec3::List VertexHandleManager::findPickableHandlePositions(const Ray3& ray, const Renderer::Camera& camera, const HandlePositionIndex& index) const {
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            
+            // The pick radius of a handle grows with its distance to the camera, so each node's bounds are
+            // expanded by the largest pick radius of any point within them before testing against the ray.
+            const auto boundsTest = [&](const BBox3& bounds) {
+                FloatType maxScalingFactor = 0.0;
+                auto op = [&](const Vec3& corner) {
+                    maxScalingFactor = std::max(maxScalingFactor, static_cast<FloatType>(std::abs(camera.perspectiveScalingFactor(Vec3f(corner)))));
+                };
+                eachBBoxVertex(bounds, op);
+                
+                const BBox3 pickBounds = bounds.expanded(2.0 * handleRadius * maxScalingFactor);
+                return !Math::isnan(pickBounds.intersectWithRay(ray));
+            };
+            const auto positionTest = [](const Vec3& /* position */) { return true; };
+            
+            return index.find(boundsTest, positionTest);
+        }
+        
         Model::Hit VertexHandleManager::pickHandle(const Ray3& ray, const Renderer::Camera& camera, const Vec3& position, Model::Hit::HitType type) const {
             const FloatType distance = camera.pickPointHandle(ray, position, pref(Preferences::HandleRadius));
             if (!Math::isnan(distance)) {
@@ -688,6 +687,15 @@ namespace TrenchBroom {
             return Model::Hit::NoHit;
         }
         
+        void VertexHandleManager::validateHandleIndices() const {
+            if (!m_handleIndicesValid) {
+                m_vertexHandleIndex.build(vertexHandlePositions());
+                m_edgeHandleIndex.build(edgeHandlePositions());
+                m_faceHandleIndex.build(faceHandlePositions());
+                m_handleIndicesValid = true;
+            }
+        }
+        
         void VertexHandleManager::validateRenderState(const bool splitMode) {
             ensure(!m_renderStateValid, "render state already valid");
 
@@ -27,6 +27,7 @@
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/PointGuideRenderer.h"
+#include "View/HandlePositionIndex.h"
 #include "View/ViewTypes.h"
 
 #include <map>
@@ -63,6 +64,12 @@ namespace TrenchBroom {
             size_t m_totalFaceCount;
             size_t m_selectedFaceCount;
             
+            // spatial indices of all handle positions, rebuilt lazily when brushes are added or removed
+            mutable HandlePositionIndex m_vertexHandleIndex;
+            mutable HandlePositionIndex m_edgeHandleIndex;
+            mutable HandlePositionIndex m_faceHandleIndex;
+            mutable bool m_handleIndicesValid;
+            
             Vec3::List m_unselectedVertexHandlePositions;
             Vec3::List m_unselectedEdgeHandlePositions;
             Vec3::List m_unselectedFaceHandlePositions;
@@ -94,6 +101,10 @@ namespace TrenchBroom {
             Vec3::List selectedEdgeHandlePositions() const;
             Vec3::List selectedFaceHandlePositions() const;
             
+            const HandlePositionIndex& vertexHandleIndex() const;
+            const HandlePositionIndex& edgeHandleIndex() const;
+            const HandlePositionIndex& faceHandleIndex() const;
+            
             bool isHandleSelected(const Vec3& position) const;
             bool isVertexHandleSelected(const Vec3& position) const;
             bool isEdgeHandleSelected(const Vec3& position) const;
@@ -201,6 +212,24 @@ namespace TrenchBroom {
                 return elementCount;
             }
 
+            template <typename T, typename O>
+            void pickHandles(const Ray3& ray, const Renderer::Camera& camera, const HandlePositionIndex& index, const std::map<Vec3, T, O>& selectedHandles, const bool includeUnselected, const Model::Hit::HitType type, Model::PickResult& pickResult) const {
+                if (includeUnselected) {
+                    for (const Vec3& position : findPickableHandlePositions(ray, camera, index)) {
+                        const Model::Hit hit = pickHandle(ray, camera, position, type);
+                        if (hit.isMatch())
+                            pickResult.addHit(hit);
+                    }
+                } else {
+                    for (const auto& entry : selectedHandles) {
+                        const Vec3& position = entry.first;
+                        const Model::Hit hit = pickHandle(ray, camera, position, type);
+                        if (hit.isMatch())
+                            pickResult.addHit(hit);
+                    }
+                }
+            }
+            
             template <typename T, typename O>
             void handlePositions(const std::map<Vec3, T, O>& handles, Vec3::List& result) const {
                 result.reserve(result.size() + handles.size());
@@ -215,7 +244,9 @@ namespace TrenchBroom {
             Vec3::List findEdgeHandlePositions(const Model::BrushSet& brushes, const Vec3& query, FloatType maxDistance);
             Vec3::List findFaceHandlePositions(const Model::BrushSet& brushes, const Vec3& query, FloatType maxDistance);
             
+            Vec3::List findPickableHandlePositions(const Ray3& ray, const Renderer::Camera& camera, const HandlePositionIndex& index) const;
             Model::Hit pickHandle(const Ray3& ray, const Renderer::Camera& camera, const Vec3& position, Model::Hit::HitType type) const;
+            void validateHandleIndices() const;
             void validateRenderState(bool splitMode);
         };
     }
@@ -55,6 +55,10 @@ namespace TrenchBroom {
         m_ignoreChangeNotifications(false),
         m_dragging(false) {}
 
+        const VertexHandleManager& VertexTool::handleManager() const {
+            return m_handleManager;
+        }
+        
         const Grid& VertexTool::grid() const {
             return lock(m_document)->grid();
         }
@@ -116,15 +120,15 @@ namespace TrenchBroom {
         
         void VertexTool::select(const Lasso& lasso, const bool modifySelection) {
             if (m_handleManager.selectedEdgeCount() > 0) {
-                const Vec3::List contained = lasso.containedPoints(m_handleManager.edgeHandlePositions());
+                const Vec3::List contained = lasso.containedPoints(m_handleManager.edgeHandleIndex());
                 if (!modifySelection) m_handleManager.deselectAllEdgeHandles();
                 m_handleManager.toggleEdgeHandles(contained);
             } else if (m_handleManager.selectedFaceCount() > 0) {
-                const Vec3::List contained = lasso.containedPoints(m_handleManager.faceHandlePositions());
+                const Vec3::List contained = lasso.containedPoints(m_handleManager.faceHandleIndex());
                 if (!modifySelection) m_handleManager.deselectAllFaceHandles();
                 m_handleManager.toggleFaceHandles(contained);
             } else {
-                const Vec3::List contained = lasso.containedPoints(m_handleManager.vertexHandlePositions());
+                const Vec3::List contained = lasso.containedPoints(m_handleManager.vertexHandleIndex());
                 if (!modifySelection) m_handleManager.deselectAllVertexHandles();
                 m_handleManager.toggleVertexHandles(contained);
             }
@@ -533,8 +537,14 @@ namespace TrenchBroom {
             commandDoneOrUndoFailed(command);
         }
 
+        /*
+         While a vertex command is performed, its brushes are removed from the handle manager and change
+         notifications are ignored. Pending notifications of an open batch must therefore be delivered before the
+         handle manager changes state, or they would be applied to the wrong set of handles.
+         */
         void VertexTool::commandDoOrUndo(Command::Ptr command) {
             if (isVertexCommand(command)) {
+                lock(m_document)->flushNotificationBatch();
                 VertexCommand* vertexCommand = static_cast<VertexCommand*>(command.get());
                 vertexCommand->removeBrushes(m_handleManager);
                 m_ignoreChangeNotifications = true;
@@ -543,6 +553,7 @@ namespace TrenchBroom {
         
         void VertexTool::commandDoneOrUndoFailed(Command::Ptr command) {
             if (isVertexCommand(command)) {
+                lock(m_document)->flushNotificationBatch();
                 VertexCommand* vertexCommand = static_cast<VertexCommand*>(command.get());
                 vertexCommand->addBrushes(m_handleManager);
                 vertexCommand->selectNewHandlePositions(m_handleManager);
@@ -555,6 +566,7 @@ namespace TrenchBroom {
         
         void VertexTool::commandDoFailedOrUndone(Command::Ptr command) {
             if (isVertexCommand(command)) {
+                lock(m_document)->flushNotificationBatch();
                 VertexCommand* vertexCommand = static_cast<VertexCommand*>(command.get());
                 vertexCommand->addBrushes(m_handleManager);
                 vertexCommand->selectOldHandlePositions(m_handleManager);
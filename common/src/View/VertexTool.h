@@ -71,6 +71,7 @@ namespace TrenchBroom {
             VertexTool(MapDocumentWPtr document);
             
             const Grid& grid() const;
+            const VertexHandleManager& handleManager() const;
             
             void pick(const Ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult);
             
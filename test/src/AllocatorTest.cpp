@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2016 Eric Wasylishen
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Allocator.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    class AllocatorTestObject : public Allocator<AllocatorTestObject, 4> {
+    public:
+        size_t value;
+        
+        explicit AllocatorTestObject(const size_t i_value) :
+        value(i_value) {}
+    };
+    
+    TEST(AllocatorTest, allocateAndFree) {
+        const Allocator<AllocatorTestObject, 4>::Statistics before = AllocatorTestObject::statistics();
+        
+        // chunks are rounded up to a power of two and may hold more blocks than requested
+        const size_t blocksPerChunk = AllocatorTestObject::BlocksPerChunk;
+        ASSERT_LE(4u, blocksPerChunk);
+        
+        const size_t count = 2 * blocksPerChunk + 2;
+        std::vector<AllocatorTestObject*> objects;
+        for (size_t i = 0; i < count; ++i)
+            objects.push_back(new AllocatorTestObject(i));
+        
+        for (size_t i = 0; i < objects.size(); ++i)
+            ASSERT_EQ(i, objects[i]->value);
+        
+        const Allocator<AllocatorTestObject, 4>::Statistics during = AllocatorTestObject::statistics();
+        ASSERT_EQ(before.liveBlocks + count, during.liveBlocks);
+        ASSERT_LE(before.chunks + 3, during.chunks);
+        ASSERT_LE(during.liveBlocks, during.peakLiveBlocks);
+        
+        for (AllocatorTestObject* object : objects)
+            delete object;
+        
+        const Allocator<AllocatorTestObject, 4>::Statistics after = AllocatorTestObject::statistics();
+        ASSERT_EQ(before.liveBlocks, after.liveBlocks);
+        ASSERT_LE(after.chunks, before.chunks + 1);
+        ASSERT_LE(before.liveBlocks + count, after.peakLiveBlocks);
+    }
+    
+    TEST(AllocatorTest, freeOnOtherThread) {
+        const Allocator<AllocatorTestObject, 4>::Statistics before = AllocatorTestObject::statistics();
+        
+        std::vector<AllocatorTestObject*> objects;
+        std::thread producer([&objects]() {
+            for (size_t i = 0; i < 100; ++i)
+                objects.push_back(new AllocatorTestObject(i));
+        });
+        producer.join();
+        
+        // the producer's heap outlives its thread
+        for (size_t i = 0; i < objects.size(); ++i)
+            ASSERT_EQ(i, objects[i]->value);
+        
+        for (AllocatorTestObject* object : objects)
+            delete object;
+        ASSERT_EQ(before.liveBlocks, AllocatorTestObject::statistics().liveBlocks);
+        
+        // the next thread adopts the heap and collects the blocks freed by this thread
+        std::thread consumer([&objects]() {
+            for (size_t i = 0; i < objects.size(); ++i)
+                objects[i] = new AllocatorTestObject(2 * i);
+            for (AllocatorTestObject* object : objects)
+                delete object;
+        });
+        consumer.join();
+        
+        const Allocator<AllocatorTestObject, 4>::Statistics after = AllocatorTestObject::statistics();
+        ASSERT_EQ(before.liveBlocks, after.liveBlocks);
+        ASSERT_LE(after.heaps, before.heaps + 2);
+    }
+    
+    TEST(AllocatorTest, releaseChunksFreedIntoParkedHeap) {
+        const Allocator<AllocatorTestObject, 4>::Statistics before = AllocatorTestObject::statistics();
+        
+        const size_t blocksPerChunk = AllocatorTestObject::BlocksPerChunk;
+        
+        std::vector<AllocatorTestObject*> objects;
+        std::thread producer([&objects, blocksPerChunk]() {
+            for (size_t i = 0; i < 25 * blocksPerChunk + 1; ++i)
+                objects.push_back(new AllocatorTestObject(i));
+        });
+        producer.join();
+        ASSERT_LE(before.chunks + 25, AllocatorTestObject::statistics().chunks);
+        
+        // the producer's heap has no owner now, so nobody would collect these blocks later
+        for (AllocatorTestObject* object : objects)
+            delete object;
+        
+        const Allocator<AllocatorTestObject, 4>::Statistics after = AllocatorTestObject::statistics();
+        ASSERT_EQ(before.liveBlocks, after.liveBlocks);
+        ASSERT_LE(after.chunks, before.chunks + 1);
+    }
+    
+    TEST(AllocatorTest, releaseChunksFreedIntoOwnedHeap) {
+        const Allocator<AllocatorTestObject, 4>::Statistics before = AllocatorTestObject::statistics();
+        
+        const size_t blocksPerChunk = AllocatorTestObject::BlocksPerChunk;
+        
+        std::vector<AllocatorTestObject*> objects;
+        for (size_t i = 0; i < 25 * blocksPerChunk + 1; ++i)
+            objects.push_back(new AllocatorTestObject(i));
+        
+        std::thread consumer([&objects]() {
+            for (AllocatorTestObject* object : objects)
+                delete object;
+        });
+        consumer.join();
+        
+        // this heap never runs out of free blocks, but the pile of remote frees is collected nonetheless
+        delete new AllocatorTestObject(0);
+        
+        const Allocator<AllocatorTestObject, 4>::Statistics after = AllocatorTestObject::statistics();
+        ASSERT_EQ(before.liveBlocks, after.liveBlocks);
+        ASSERT_LE(after.chunks, before.chunks + 1);
+    }
+    
+    TEST(AllocatorTest, allocateConcurrently) {
+        const Allocator<AllocatorTestObject, 4>::Statistics before = AllocatorTestObject::statistics();
+        
+        std::atomic<size_t> mismatches(0);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < 4; ++i) {
+            workers.push_back(std::thread([&mismatches]() {
+                std::vector<AllocatorTestObject*> objects;
+                for (size_t j = 0; j < 1000; ++j)
+                    objects.push_back(new AllocatorTestObject(j));
+                for (size_t j = 0; j < objects.size(); ++j) {
+                    if (objects[j]->value != j)
+                        ++mismatches;
+                    delete objects[j];
+                }
+            }));
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+        
+        ASSERT_EQ(0u, mismatches.load());
+        ASSERT_EQ(before.liveBlocks, AllocatorTestObject::statistics().liveBlocks);
+    }
+}
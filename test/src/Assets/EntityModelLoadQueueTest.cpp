@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelLoadQueue.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TestEntityModel : public EntityModel {
+        private:
+            Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const { return NULL; }
+            BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const { return BBox3f(-8.0f, 8.0f); }
+            BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const { return BBox3f(-8.0f, 8.0f); }
+            void doPrepare(int minFilter, int magFilter) {}
+            void doSetTextureMode(int minFilter, int magFilter) {}
+        };
+        
+        class TestEntityModelLoader : public IO::EntityModelLoader {
+        private:
+            EntityModel* doLoadEntityModel(const IO::Path& path) const {
+                if (path.extension() == "mdl")
+                    return new TestEntityModel();
+                throw GameException("Unsupported model format '" + path.asString() + "'");
+            }
+        };
+        
+        TEST(EntityModelLoadQueueTest, loadModels) {
+            const TestEntityModelLoader loader;
+            EntityModelLoadQueue queue;
+            queue.setLoader(&loader);
+            
+            IO::Path::List paths;
+            paths.push_back(IO::Path("progs/armor.mdl"));
+            paths.push_back(IO::Path("progs/player.mdl"));
+            paths.push_back(IO::Path("models/items/armor.md2"));
+            
+            for (const IO::Path& path : paths)
+                ASSERT_TRUE(queue.enqueue(path));
+            ASSERT_FALSE(queue.enqueue(paths.front()));
+            ASSERT_TRUE(queue.hasPending());
+            
+            EntityModelLoadQueue::ResultList results;
+            while (results.size() < paths.size()) {
+                const EntityModelLoadQueue::ResultList collected = queue.collect();
+                results.insert(std::end(results), std::begin(collected), std::end(collected));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            
+            ASSERT_FALSE(queue.hasPending());
+            
+            for (EntityModelLoadQueue::Result& result : results) {
+                if (result.path.extension() == "mdl") {
+                    ASSERT_TRUE(result.model != NULL);
+                    ASSERT_TRUE(result.error.empty());
+                } else {
+                    ASSERT_TRUE(result.model == NULL);
+                    ASSERT_FALSE(result.error.empty());
+                }
+                delete result.model;
+            }
+        }
+        
+        TEST(EntityModelLoadQueueTest, waitFor) {
+            const TestEntityModelLoader loader;
+            EntityModelLoadQueue queue;
+            queue.setLoader(&loader);
+            
+            const IO::Path path("progs/armor.mdl");
+            ASSERT_TRUE(queue.enqueue(path));
+            queue.waitFor(path);
+            
+            // the model was either loaded by a worker or removed from the queue before it was started
+            EntityModelLoadQueue::ResultList results = queue.collect();
+            ASSERT_FALSE(queue.pending(path));
+            ASSERT_TRUE(results.size() <= 1u);
+            for (EntityModelLoadQueue::Result& result : results)
+                delete result.model;
+        }
+        
+        TEST(EntityModelLoadQueueTest, cancel) {
+            const TestEntityModelLoader loader;
+            EntityModelLoadQueue queue;
+            queue.setLoader(&loader);
+            
+            for (size_t i = 0; i < 100; ++i)
+                queue.enqueue(IO::Path("progs/model" + std::to_string(i) + ".mdl"));
+            
+            queue.cancel();
+            ASSERT_FALSE(queue.hasPending());
+            ASSERT_TRUE(queue.collect().empty());
+        }
+        
+        TEST(EntityModelLoadQueueTest, enqueueWithoutLoader) {
+            EntityModelLoadQueue queue;
+            ASSERT_FALSE(queue.enqueue(IO::Path("progs/armor.mdl")));
+            ASSERT_FALSE(queue.hasPending());
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Assets/TextureName.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureNameTest, internEqualNames) {
+            const TextureName name1("base_wall/concrete1");
+            const TextureName name2(String("base_wall/") + "concrete1");
+            
+            ASSERT_EQ(name1, name2);
+            ASSERT_EQ(&name1.name(), &name2.name());
+            ASSERT_EQ("base_wall/concrete1", name1.name());
+        }
+        
+        TEST(TextureNameTest, keyIgnoresCase) {
+            const TextureName lower("base_floor/tile2");
+            const TextureName upper("BASE_FLOOR/Tile2");
+            
+            ASSERT_NE(lower, upper);
+            ASSERT_EQ("BASE_FLOOR/Tile2", upper.name());
+            ASSERT_EQ(lower.key(), upper.key());
+            ASSERT_EQ(&lower.name(), lower.key());
+            ASSERT_EQ("base_floor/tile2", *upper.key());
+        }
+        
+        TEST(TextureNameTest, findKey) {
+            ASSERT_TRUE(TextureName::findKey("texturenametest_never_interned") == NULL);
+            
+            const TextureName name("TextureNameTest_Interned");
+            ASSERT_EQ(name.key(), TextureName::findKey("TextureNameTest_Interned"));
+            ASSERT_EQ(name.key(), TextureName::findKey("texturenametest_interned"));
+            ASSERT_EQ(name.key(), TextureName::findKey("TEXTURENAMETEST_INTERNED"));
+            ASSERT_TRUE(TextureName::findKey("texturenametest_never_interned") == NULL);
+        }
+        
+        TEST(TextureNameTest, symbolCount) {
+            const size_t count = TextureName::symbolCount();
+            
+            const TextureName name1("TextureNameTest_Count");
+            ASSERT_EQ(count + 2u, TextureName::symbolCount());
+            
+            const TextureName name2("TextureNameTest_Count");
+            const TextureName name3("texturenametest_count");
+            ASSERT_EQ(count + 2u, TextureName::symbolCount());
+            ASSERT_LT(0u, TextureName::memoryUsage());
+        }
+    }
+}
@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
@@ -147,7 +148,40 @@ namespace TrenchBroom {
             ASSERT_THROW(fs.openFile(Path("/amnet.cfg")), FileSystemException);
             ASSERT_THROW(fs.openFile(Path("/textures")), FileSystemException);
             
-            ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != NULL);
+            const MappedFile::Ptr file = fs.openFile(Path("amnet.cfg"));
+            ASSERT_TRUE(file != NULL);
+            ASSERT_EQ(447u, file->size());
+            ASSERT_EQ(String("//\r\n// my stuff\r\n//"), String(file->begin(), 19));
+        }
+        
+        TEST(DkPakFileSystemTest, openCompressedFile) {
+            // a literal run, a run of zeros, a run of one byte, a back reference and the end marker
+            const unsigned char compressed[] = { 0x02, 'a', 'b', 'c', 0x40, 0x80, 'z', 0xC0, 0x05, 0xFF };
+            const char expected[] = { 'a', 'b', 'c', 0, 0, 'z', 'z', 'a', 'b' };
+            
+            const size_t directoryAddress = 12 + sizeof(compressed);
+            const size_t size = directoryAddress + 0x48;
+            char* data = new char[size];
+            std::memset(data, 0, size);
+            
+            const int32_t header[] = { static_cast<int32_t>(directoryAddress), 0x48 };
+            std::memcpy(data, "PACK", 4);
+            std::memcpy(data + 4, header, sizeof(header));
+            std::memcpy(data + 12, compressed, sizeof(compressed));
+            
+            const int32_t entry[] = { 12, static_cast<int32_t>(sizeof(expected)), static_cast<int32_t>(sizeof(compressed)), 1 };
+            std::memcpy(data + directoryAddress, "test.bin", 8);
+            std::memcpy(data + directoryAddress + 0x38, entry, sizeof(entry));
+            
+            const Path pakPath("compressed.pak");
+            const DkPakFileSystem fs(pakPath, MappedFile::Ptr(new MappedFileBuffer(pakPath, data, size)));
+            
+            const MappedFile::Ptr file = fs.openFile(Path("test.bin"));
+            ASSERT_EQ(sizeof(expected), file->size());
+            ASSERT_EQ(0, std::memcmp(expected, file->begin(), sizeof(expected)));
+            
+            // opening the entry again must not inflate it again
+            ASSERT_EQ(file, fs.openFile(Path("test.bin")));
         }
     }
 }
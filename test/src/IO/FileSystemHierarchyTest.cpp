@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/DiskFileSystem.h"
+#include "IO/FileSystemHierarchy.h"
+#include "IO/IdPakFileSystem.h"
+#include "IO/MappedFile.h"
+
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST(FileSystemHierarchyTest, fileExists) {
+            const Path pak1Path = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/pak1.pak");
+            const Path pak3Path = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/pak3.pak");
+            
+            FileSystemHierarchy fs;
+            fs.addFileSystem(new IdPakFileSystem(pak1Path, Disk::openFile(pak1Path)));
+            fs.addFileSystem(new IdPakFileSystem(pak3Path, Disk::openFile(pak3Path)));
+            
+            ASSERT_TRUE(fs.fileExists(Path("amnet.cfg")));
+            ASSERT_TRUE(fs.fileExists(Path("textures/e1u1/box1_3.wal")));
+            ASSERT_TRUE(fs.fileExists(Path("TEXTURES/E1U1/Box1_3.wal")));
+            ASSERT_TRUE(fs.fileExists(Path("gfx/palette.lmp")));
+            ASSERT_TRUE(fs.fileExists(Path("GFX/Palette.LMP")));
+            
+            ASSERT_FALSE(fs.fileExists(Path("textures")));
+            ASSERT_FALSE(fs.fileExists(Path("gfx/palette.pcx")));
+            
+            ASSERT_TRUE(fs.directoryExists(Path("textures/e1u2")));
+            ASSERT_TRUE(fs.directoryExists(Path("gfx")));
+            ASSERT_FALSE(fs.directoryExists(Path("gfx/palette.lmp")));
+        }
+        
+        TEST(FileSystemHierarchyTest, openFileFromTopmostFileSystem) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/pak1.pak");
+            const MappedFile::Ptr lowerFile = Disk::openFile(pakPath);
+            const MappedFile::Ptr upperFile = Disk::openFile(pakPath);
+            assert(lowerFile != NULL);
+            assert(upperFile != NULL);
+            
+            FileSystemHierarchy fs;
+            fs.addFileSystem(new IdPakFileSystem(pakPath, lowerFile));
+            fs.addFileSystem(new IdPakFileSystem(pakPath, upperFile));
+            
+            const MappedFile::Ptr file = fs.openFile(Path("Pics/Tag1.pcx"));
+            ASSERT_TRUE(file != NULL);
+            ASSERT_TRUE(file->begin() >= upperFile->begin());
+            ASSERT_TRUE(file->end() <= upperFile->end());
+            
+            ASSERT_THROW(fs.openFile(Path("pics/tag3.pcx")), FileSystemException);
+        }
+        
+        TEST(FileSystemHierarchyTest, clear) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/pak3.pak");
+            
+            FileSystemHierarchy fs;
+            fs.addFileSystem(new IdPakFileSystem(pakPath, Disk::openFile(pakPath)));
+            ASSERT_TRUE(fs.fileExists(Path("gfx/palette.lmp")));
+            
+            fs.clear();
+            ASSERT_FALSE(fs.fileExists(Path("gfx/palette.lmp")));
+        }
+    }
+}
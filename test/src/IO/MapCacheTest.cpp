@@ -0,0 +1,177 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/MapCache.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <cstdio>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const String CachedMap("{\n"
+                                      "\"classname\" \"worldspawn\"\n"
+                                      "\"message\" \"cached\"\n"
+                                      "{\n"
+                                      "( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1\n"
+                                      "( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1\n"
+                                      "}\n"
+                                      "{\n"
+                                      "( 0 0 0 ) ( 0 64 0 ) ( 64 0 0 ) wood [ 1 0 0 8 ] [ 0 -1 0 16 ] 15 0.5 2\n"
+                                      "( 0 0 64 ) ( 64 0 64 ) ( 0 64 64 ) wood [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1\n"
+                                      "( 0 0 0 ) ( 64 0 0 ) ( 0 0 64 ) wood [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( 0 0 0 ) ( 0 0 64 ) ( 0 64 0 ) wood [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( 64 0 0 ) ( 0 64 0 ) ( 64 0 64 ) wood [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "}\n"
+                                      "}\n"
+                                      "{\n"
+                                      "\"classname\" \"func_group\"\n"
+                                      "\"_tb_type\" \"_tb_layer\"\n"
+                                      "\"_tb_name\" \"My Layer\"\n"
+                                      "\"_tb_id\" \"1\"\n"
+                                      "}\n"
+                                      "{\n"
+                                      "\"classname\" \"func_group\"\n"
+                                      "\"_tb_type\" \"_tb_group\"\n"
+                                      "\"_tb_name\" \"My Group\"\n"
+                                      "\"_tb_id\" \"2\"\n"
+                                      "\"_tb_layer\" \"1\"\n"
+                                      "}\n"
+                                      "{\n"
+                                      "\"classname\" \"func_door\"\n"
+                                      "\"_tb_group\" \"2\"\n"
+                                      "{\n"
+                                      "( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1\n"
+                                      "( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1\n"
+                                      "( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1\n"
+                                      "}\n"
+                                      "}\n");
+        
+        static String writeCache(const MapCache& cache, const Model::World* world, const BBox3& worldBounds) {
+            FILE* stream = std::tmpfile();
+            cache.write(world, worldBounds, stream);
+            
+            String result(static_cast<size_t>(std::ftell(stream)), '\0');
+            std::rewind(stream);
+            EXPECT_EQ(result.size(), std::fread(&result[0], 1, result.size(), stream));
+            std::fclose(stream);
+            return result;
+        }
+        
+        static void assertNodesEqual(const Model::Node* expected, const Model::Node* actual) {
+            ASSERT_EQ(expected->name(), actual->name());
+            ASSERT_EQ(expected->lineNumber(), actual->lineNumber());
+            ASSERT_EQ(expected->lineCount(), actual->lineCount());
+            ASSERT_EQ(expected->childCount(), actual->childCount());
+            
+            const Model::AttributableNode* expectedAttributable = dynamic_cast<const Model::AttributableNode*>(expected);
+            if (expectedAttributable != NULL) {
+                const Model::AttributableNode* actualAttributable = dynamic_cast<const Model::AttributableNode*>(actual);
+                ASSERT_TRUE(actualAttributable != NULL);
+                ASSERT_EQ(expectedAttributable->attributes().size(), actualAttributable->attributes().size());
+                for (size_t i = 0; i < expectedAttributable->attributes().size(); ++i) {
+                    ASSERT_EQ(expectedAttributable->attributes()[i].name(), actualAttributable->attributes()[i].name());
+                    ASSERT_EQ(expectedAttributable->attributes()[i].value(), actualAttributable->attributes()[i].value());
+                }
+            }
+            
+            const Model::Brush* expectedBrush = dynamic_cast<const Model::Brush*>(expected);
+            if (expectedBrush != NULL) {
+                const Model::Brush* actualBrush = dynamic_cast<const Model::Brush*>(actual);
+                ASSERT_TRUE(actualBrush != NULL);
+                ASSERT_EQ(expectedBrush->bounds(), actualBrush->bounds());
+                ASSERT_EQ(expectedBrush->vertexCount(), actualBrush->vertexCount());
+                ASSERT_EQ(expectedBrush->edgeCount(), actualBrush->edgeCount());
+                ASSERT_EQ(expectedBrush->faceCount(), actualBrush->faceCount());
+                
+                for (size_t i = 0; i < expectedBrush->faceCount(); ++i) {
+                    const Model::BrushFace* expectedFace = expectedBrush->faces()[i];
+                    const Model::BrushFace* actualFace = actualBrush->faces()[i];
+                    ASSERT_TRUE(actualFace->geometry() != NULL);
+                    ASSERT_EQ(expectedFace->boundary(), actualFace->boundary());
+                    ASSERT_EQ(expectedFace->attribs().textureName(), actualFace->attribs().textureName());
+                    ASSERT_EQ(expectedFace->attribs().offset(), actualFace->attribs().offset());
+                    ASSERT_EQ(expectedFace->attribs().scale(), actualFace->attribs().scale());
+                    ASSERT_EQ(expectedFace->attribs().rotation(), actualFace->attribs().rotation());
+                    ASSERT_EQ(expectedFace->textureXAxis(), actualFace->textureXAxis());
+                    ASSERT_EQ(expectedFace->textureYAxis(), actualFace->textureYAxis());
+                    ASSERT_EQ(expectedFace->polygon(), actualFace->polygon());
+                }
+            }
+            
+            for (size_t i = 0; i < expected->childCount(); ++i)
+                assertNodesEqual(expected->children()[i], actual->children()[i]);
+        }
+        
+        TEST(MapCacheTest, restoreWorld) {
+            const BBox3 worldBounds(8192);
+            
+            IO::TestParserStatus status;
+            WorldReader reader(CachedMap, NULL);
+            Model::World* world = reader.read(Model::MapFormat::Valve, worldBounds, status);
+            
+            const MapCache cache(CachedMap.data(), CachedMap.data() + CachedMap.size());
+            const String contents = writeCache(cache, world, worldBounds);
+            
+            Model::World* restored = cache.read(contents.data(), contents.data() + contents.size(), Model::MapFormat::Valve, worldBounds, NULL, status);
+            ASSERT_TRUE(restored != NULL);
+            ASSERT_EQ(2u, restored->childCount());
+            ASSERT_EQ("My Layer", restored->children().back()->name());
+            assertNodesEqual(world, restored);
+            
+            delete restored;
+            delete world;
+        }
+        
+        TEST(MapCacheTest, rejectStaleCache) {
+            const BBox3 worldBounds(8192);
+            
+            IO::TestParserStatus status;
+            WorldReader reader(CachedMap, NULL);
+            Model::World* world = reader.read(Model::MapFormat::Valve, worldBounds, status);
+            
+            const MapCache cache(CachedMap.data(), CachedMap.data() + CachedMap.size());
+            const String contents = writeCache(cache, world, worldBounds);
+            delete world;
+            
+            String changedMap = CachedMap;
+            changedMap[changedMap.find("cached")] = 'C';
+            const MapCache changedCache(changedMap.data(), changedMap.data() + changedMap.size());
+            ASSERT_TRUE(changedCache.read(contents.data(), contents.data() + contents.size(), Model::MapFormat::Valve, worldBounds, NULL, status) == NULL);
+            
+            ASSERT_TRUE(cache.read(contents.data(), contents.data() + contents.size(), Model::MapFormat::Standard, worldBounds, NULL, status) == NULL);
+            ASSERT_TRUE(cache.read(contents.data(), contents.data() + contents.size() - 1, Model::MapFormat::Valve, worldBounds, NULL, status) == NULL);
+        }
+    }
+}
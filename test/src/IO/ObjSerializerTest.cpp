@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StringUtils.h"
+#include "IO/NodeWriter.h"
+#include "IO/ObjSerializer.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <cstdio>
+
+namespace TrenchBroom {
+    namespace IO {
+        String exportObj(Model::World* world, const size_t maxWorkers) {
+            FILE* file = std::tmpfile();
+            NodeWriter(world, new ObjFileSerializer(file, maxWorkers)).writeMap();
+            
+            String result;
+            std::rewind(file);
+            char buffer[4096];
+            size_t count;
+            while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+                result.append(buffer, count);
+            std::fclose(file);
+            return result;
+        }
+        
+        size_t countLines(const String& str, const String& prefix) {
+            size_t result = 0;
+            for (const String& line : StringUtils::split(str, '\n')) {
+                if (StringUtils::isPrefix(line, prefix))
+                    ++result;
+            }
+            return result;
+        }
+        
+        TEST(ObjSerializerTest, writeCube) {
+            const BBox3 worldBounds(8192.0);
+            
+            Model::World map(Model::MapFormat::Standard, NULL, worldBounds);
+            Model::BrushBuilder builder(&map, worldBounds);
+            map.defaultLayer()->addChild(builder.createCube(64.0, "none"));
+            
+            const String result = exportObj(&map, 1);
+            ASSERT_EQ(8u, countLines(result, "v "));
+            ASSERT_EQ(6u, countLines(result, "vn "));
+            ASSERT_EQ(6u, countLines(result, "f "));
+            ASSERT_EQ(1u, countLines(result, "o entity0_brush0"));
+        }
+        
+        TEST(ObjSerializerTest, writeManyBrushesConcurrently) {
+            const BBox3 worldBounds(8192.0);
+            
+            Model::World map(Model::MapFormat::Standard, NULL, worldBounds);
+            Model::BrushBuilder builder(&map, worldBounds);
+            
+            // adjacent cubes share vertices, which must be deduplicated across the workers' chunks
+            for (size_t x = 0; x < 32; ++x) {
+                for (size_t y = 0; y < 32; ++y) {
+                    const Vec3 min(static_cast<FloatType>(x) * 32.0, static_cast<FloatType>(y) * 32.0, 0.0);
+                    map.defaultLayer()->addChild(builder.createCuboid(BBox3(min, min + Vec3(32.0, 32.0, 32.0)), "none"));
+                }
+            }
+            
+            const String sequential = exportObj(&map, 1);
+            const String concurrent = exportObj(&map, 4);
+            ASSERT_EQ(sequential, concurrent);
+            ASSERT_EQ(2u * 33u * 33u, countLines(concurrent, "v "));
+            ASSERT_EQ(32u * 32u * 6u, countLines(concurrent, "f "));
+        }
+    }
+}
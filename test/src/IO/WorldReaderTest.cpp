@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 
+#include "Exceptions.h"
 #include "IO/TestParserStatus.h"
 #include "IO/WorldReader.h"
 #include "Model/Brush.h"
@@ -38,6 +39,81 @@ namespace TrenchBroom {
             return NULL;
         }
         
+        class RecordingParserStatus : public ParserStatus {
+        private:
+            size_t m_cancelAfter;
+        public:
+            std::vector<double> progress;
+        public:
+            RecordingParserStatus(const size_t cancelAfter = 0) :
+            ParserStatus(NULL),
+            m_cancelAfter(cancelAfter) {}
+        private:
+            void doProgress(const double i_progress) {
+                progress.push_back(i_progress);
+                if (progress.size() == m_cancelAfter)
+                    throw OperationCancelledException("cancelled");
+            }
+        };
+        
+        static const String ProgressMap("{\n"
+                                        "\"classname\" \"worldspawn\"\n"
+                                        "{\n"
+                                        "( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1\n"
+                                        "( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1\n"
+                                        "( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1\n"
+                                        "}\n"
+                                        "}\n"
+                                        "{\n"
+                                        "\"classname\" \"func_door\"\n"
+                                        "\"_tb_layer\" \"1\"\n"
+                                        "{\n"
+                                        "( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1\n"
+                                        "( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1\n"
+                                        "( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1\n"
+                                        "( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1\n"
+                                        "}\n"
+                                        "}\n"
+                                        "{\n"
+                                        "\"classname\" \"func_group\"\n"
+                                        "\"_tb_type\" \"_tb_layer\"\n"
+                                        "\"_tb_name\" \"My Layer\"\n"
+                                        "\"_tb_id\" \"1\"\n"
+                                        "}\n");
+        
+        TEST(WorldReaderTest, reportProgress) {
+            BBox3 worldBounds(8192);
+            
+            RecordingParserStatus status;
+            WorldReader reader(ProgressMap, NULL);
+            
+            Model::World* world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            ASSERT_TRUE(world != NULL);
+            
+            // one report per brush and per entity, and a final one
+            ASSERT_EQ(6u, status.progress.size());
+            for (size_t i = 1; i < status.progress.size(); ++i)
+                ASSERT_LT(status.progress[i - 1], status.progress[i]);
+            ASSERT_DOUBLE_EQ(1.0, status.progress.back());
+            
+            delete world;
+        }
+        
+        TEST(WorldReaderTest, cancelParsing) {
+            BBox3 worldBounds(8192);
+            
+            // cancel after the func_door has been parsed, but before its layer is known
+            RecordingParserStatus status(4);
+            WorldReader reader(ProgressMap, NULL);
+            
+            ASSERT_THROW(reader.read(Model::MapFormat::Standard, worldBounds, status), OperationCancelledException);
+        }
+        
         TEST(WorldReaderTest, parseFailure_1424) {
             const String data("{"
                               "\"classname\" \"worldspawn\""
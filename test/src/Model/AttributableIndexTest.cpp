@@ -177,5 +177,38 @@ namespace TrenchBroom {
             
             delete entity1;
         }
+        
+        TEST(EntityAttributeIndexTest, removeAttributeWithSharedValue) {
+            AttributableNodeIndex index;
+            
+            Entity* entity1 = new Entity();
+            entity1->addOrUpdateAttribute("target", "value");
+            entity1->addOrUpdateAttribute("killtarget", "value");
+            
+            Entity* entity2 = new Entity();
+            entity2->addOrUpdateAttribute("target2", "value");
+            
+            index.addAttributableNode(entity1);
+            index.addAttributableNode(entity2);
+            
+            entity1->removeAttribute("target");
+            index.removeAttribute(entity1, "target", "value");
+            
+            ASSERT_TRUE(findExactExact(index, "target", "value").empty());
+            
+            AttributableNodeList attributables = findExactExact(index, "killtarget", "value");
+            ASSERT_EQ(1u, attributables.size());
+            ASSERT_TRUE(VectorUtils::contains(attributables, entity1));
+            
+            attributables = index.findAttributableNodes(AttributableNodeIndexQuery::prefix("target"), "value");
+            ASSERT_EQ(1u, attributables.size());
+            ASSERT_TRUE(VectorUtils::contains(attributables, entity2));
+            
+            attributables = index.findAttributableNodes(AttributableNodeIndexQuery::any(), "value");
+            ASSERT_EQ(2u, attributables.size());
+            
+            delete entity1;
+            delete entity2;
+        }
     }
 }
@@ -152,6 +152,33 @@ namespace TrenchBroom {
             ASSERT_TRUE(sources.empty());
         }
         
+        TEST(AttributableNodeLinkTest, testRemoveLinkByRemovingNumberedSourceAttributes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            Entity* source = world.createEntity();
+            Entity* target1 = world.createEntity();
+            Entity* target2 = world.createEntity();
+            world.defaultLayer()->addChild(source);
+            world.defaultLayer()->addChild(target1);
+            world.defaultLayer()->addChild(target2);
+            
+            source->addOrUpdateAttribute(AttributeNames::Target + "1", "target_name1");
+            source->addOrUpdateAttribute("origin", "0 0 0");
+            source->addOrUpdateAttribute(AttributeNames::Target + "2", "target_name2");
+            target1->addOrUpdateAttribute(AttributeNames::Targetname, "target_name1");
+            target2->addOrUpdateAttribute(AttributeNames::Targetname, "target_name2");
+            ASSERT_EQ(2u, source->linkTargets().size());
+            
+            source->removeNumberedAttribute(AttributeNames::Target);
+            
+            ASSERT_FALSE(source->hasAttribute(AttributeNames::Target + "1"));
+            ASSERT_FALSE(source->hasAttribute(AttributeNames::Target + "2"));
+            ASSERT_TRUE(source->hasAttribute("origin"));
+            ASSERT_TRUE(source->linkTargets().empty());
+            ASSERT_TRUE(target1->linkSources().empty());
+            ASSERT_TRUE(target2->linkSources().empty());
+        }
+        
         TEST(AttributableNodeLinkTest, testRemoveLinkByChangingTarget) {
             const BBox3 worldBounds(8192.0);
             World world(MapFormat::Standard, NULL, worldBounds);
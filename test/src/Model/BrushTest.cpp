@@ -744,6 +744,37 @@ namespace TrenchBroom {
             delete clone;
         }
         
+        TEST(BrushTest, cloneCopiesGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "left", "right", "front", "back", "top", "bottom");
+            
+            const Vec3 p8(+32.0, +32.0, +32.0);
+            const Vec3 p9(+16.0, +16.0, +32.0);
+            brush->moveVertices(worldBounds, Vec3::List(1, p8), p9 - p8);
+            
+            Brush* clone = brush->clone(worldBounds);
+            ASSERT_EQ(brush->faceCount(), clone->faceCount());
+            ASSERT_EQ(brush->vertexCount(), clone->vertexCount());
+            ASSERT_EQ(brush->edgeCount(), clone->edgeCount());
+            ASSERT_EQ(brush->bounds(), clone->bounds());
+            ASSERT_TRUE(clone->fullySpecified());
+            
+            for (const BrushVertex* vertex : brush->vertices())
+                ASSERT_TRUE(clone->hasVertex(vertex->position()));
+            
+            for (const BrushFace* face : clone->faces()) {
+                ASSERT_EQ(clone, face->brush());
+                ASSERT_TRUE(brush->findFace(face->boundary()) != NULL);
+                ASSERT_EQ(brush->findFace(face->boundary())->textureName(), face->textureName());
+            }
+            
+            delete clone;
+            delete brush;
+        }
+        
         TEST(BrushTest, clip) {
             const BBox3 worldBounds(4096.0);
             
@@ -2869,6 +2900,80 @@ namespace TrenchBroom {
             ASSERT_FALSE(brush->canSnapVertices(worldBounds, gridSize));
         }
         
+        TEST(BrushTest, integerPlanePoints) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "texture");
+            brush->transform(rotationMatrix(Vec3::PosZ, Math::radians(15.0)), false, worldBounds);
+            
+            Brush* expected = brush->clone(worldBounds);
+            expected->findIntegerPlanePoints(worldBounds);
+            
+            const BrushFaceList& faces = brush->faces();
+            const Vec3::List points = brush->integerPlanePoints();
+            ASSERT_EQ(3 * faces.size(), points.size());
+            
+            // computing the points does not modify the brush
+            bool allInteger = true;
+            for (const BrushFace* face : faces) {
+                for (size_t i = 0; i < 3; ++i)
+                    allInteger &= face->points()[i].isInteger();
+            }
+            ASSERT_FALSE(allInteger);
+            
+            brush->setPlanePoints(worldBounds, points);
+            ASSERT_TRUE(brush->fullySpecified());
+            ASSERT_EQ(expected->faceCount(), brush->faceCount());
+            
+            for (size_t i = 0; i < faces.size(); ++i) {
+                const BrushFace* face = faces[i];
+                const BrushFace* expectedFace = expected->faces()[i];
+                for (size_t j = 0; j < 3; ++j) {
+                    ASSERT_TRUE(face->points()[j].isInteger());
+                    ASSERT_VEC_EQ(expectedFace->points()[j], face->points()[j]);
+                }
+            }
+            
+            delete expected;
+            delete brush;
+        }
+        
+        TEST(BrushTest, snapVerticesToPrecomputedGeometry) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "texture");
+            brush->transform(rotationMatrix(Vec3::PosZ, Math::radians(15.0)), false, worldBounds);
+            
+            Brush* expected = brush->clone(worldBounds);
+            expected->snapVertices(worldBounds, 1);
+            
+            BrushGeometry geometry = brush->snappedGeometry(1);
+            ASSERT_EQ(expected->vertexCount(), geometry.vertexCount());
+            
+            // computing the geometry does not modify the brush
+            bool allInteger = true;
+            for (const BrushVertex* vertex : brush->vertices())
+                allInteger &= vertex->position().isInteger();
+            ASSERT_FALSE(allInteger);
+            
+            brush->snapVertices(worldBounds, 1, geometry);
+            ASSERT_TRUE(brush->fullySpecified());
+            ASSERT_EQ(expected->vertexCount(), brush->vertexCount());
+            ASSERT_EQ(expected->faceCount(), brush->faceCount());
+            
+            for (const BrushVertex* vertex : brush->vertices()) {
+                ASSERT_TRUE(vertex->position().isInteger());
+                ASSERT_TRUE(expected->hasVertex(vertex->position()));
+            }
+            
+            delete expected;
+            delete brush;
+        }
+        
         static void assertCannotSnap(const String& data) {
             assertCannotSnapTo(data, 1);
         }
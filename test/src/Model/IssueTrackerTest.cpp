@@ -0,0 +1,213 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Entity.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/IssueTracker.h"
+#include "Model/Layer.h"
+#include "Model/LinkTargetIssueGenerator.h"
+#include "Model/MapFormat.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/ModelTypes.h"
+#include "Model/World.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Model {
+        class UnsafeIssueGenerator : public IssueGenerator {
+        private:
+            class UnsafeIssue : public Issue {
+            public:
+                static const IssueType Type;
+            public:
+                UnsafeIssue(Node* node) : Issue(node) {}
+            private:
+                IssueType doGetType() const { return Type; }
+                const String doGetDescription() const { return "unsafe"; }
+            };
+            
+            mutable size_t m_count;
+        public:
+            UnsafeIssueGenerator() :
+            IssueGenerator(UnsafeIssue::Type, "Unsafe"),
+            m_count(0) {}
+        private:
+            bool doIsThreadSafe() const { return false; }
+            
+            void doGenerate(Entity* entity, IssueList& issues) const {
+                ++m_count;
+                issues.push_back(new UnsafeIssue(entity));
+            }
+        };
+        
+        const IssueType UnsafeIssueGenerator::UnsafeIssue::Type = Issue::freeType();
+        
+        TEST(IssueTrackerTest, collectIssues) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            
+            Entity* entity = world.createEntity();
+            world.defaultLayer()->addChild(entity);
+            
+            IssueTracker tracker;
+            tracker.reset(&world);
+            ASSERT_TRUE(tracker.hasDirtyNodes());
+            ASSERT_TRUE(tracker.update(world.registeredIssueGenerators(), 100));
+            ASSERT_FALSE(tracker.hasDirtyNodes());
+            
+            const IssueList issues = tracker.issues();
+            ASSERT_EQ(1u, issues.size());
+            ASSERT_EQ(entity, issues.front()->node());
+        }
+        
+        TEST(IssueTrackerTest, updateInSteps) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            
+            for (size_t i = 0; i < 10; ++i)
+                world.defaultLayer()->addChild(world.createEntity());
+            
+            IssueTracker tracker;
+            tracker.reset(&world);
+            
+            // world, default layer and ten entities
+            ASSERT_FALSE(tracker.update(world.registeredIssueGenerators(), 5));
+            ASSERT_FALSE(tracker.update(world.registeredIssueGenerators(), 5));
+            ASSERT_TRUE(tracker.update(world.registeredIssueGenerators(), 5));
+            ASSERT_EQ(10u, tracker.issues().size());
+        }
+        
+        TEST(IssueTrackerTest, invalidateChangedNodes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            
+            Entity* entity1 = world.createEntity();
+            Entity* entity2 = world.createEntity();
+            world.defaultLayer()->addChild(entity1);
+            world.defaultLayer()->addChild(entity2);
+            
+            IssueTracker tracker;
+            tracker.reset(&world);
+            tracker.update(world.registeredIssueGenerators(), 100);
+            ASSERT_EQ(2u, tracker.issues().size());
+            
+            entity1->addOrUpdateAttribute(AttributeNames::Classname, "light");
+            tracker.invalidateNodes(NodeList(1, entity1));
+            
+            // the entity and its ancestors
+            ASSERT_TRUE(tracker.hasDirtyNodes());
+            ASSERT_FALSE(tracker.update(world.registeredIssueGenerators(), 2));
+            ASSERT_TRUE(tracker.update(world.registeredIssueGenerators(), 1));
+            
+            const IssueList issues = tracker.issues();
+            ASSERT_EQ(1u, issues.size());
+            ASSERT_EQ(entity2, issues.front()->node());
+        }
+        
+        TEST(IssueTrackerTest, invalidateLinkedNodes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new LinkTargetIssueGenerator());
+            
+            Entity* source = world.createEntity();
+            source->addOrUpdateAttribute(AttributeNames::Classname, "trigger_once");
+            source->addOrUpdateAttribute(AttributeNames::Target, "door");
+            world.defaultLayer()->addChild(source);
+            
+            IssueTracker tracker;
+            tracker.reset(&world);
+            tracker.update(world.registeredIssueGenerators(), 100);
+            ASSERT_EQ(1u, tracker.issues().size());
+            
+            Entity* target = world.createEntity();
+            target->addOrUpdateAttribute(AttributeNames::Classname, "func_door");
+            target->addOrUpdateAttribute(AttributeNames::Targetname, "door");
+            world.defaultLayer()->addChild(target);
+            
+            // only the target was added, but the source is linked to it now
+            tracker.invalidateNodes(NodeList(1, target));
+            tracker.update(world.registeredIssueGenerators(), 100);
+            ASSERT_TRUE(tracker.issues().empty());
+        }
+        
+        TEST(IssueTrackerTest, removeNodes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            
+            Entity* entity = world.createEntity();
+            world.defaultLayer()->addChild(entity);
+            
+            IssueTracker tracker;
+            tracker.reset(&world);
+            tracker.update(world.registeredIssueGenerators(), 100);
+            ASSERT_EQ(1u, tracker.issues().size());
+            
+            tracker.invalidateNodes(NodeList(1, entity));
+            world.defaultLayer()->removeChild(entity);
+            tracker.removeNodes(NodeList(1, entity));
+            
+            tracker.update(world.registeredIssueGenerators(), 100);
+            ASSERT_TRUE(tracker.issues().empty());
+            delete entity;
+        }
+            
+        class CompareSeqId {
+        public:
+            bool operator()(const Issue* lhs, const Issue* rhs) const {
+                return lhs->seqId() < rhs->seqId();
+            }
+        };
+        
+        TEST(IssueTrackerTest, updateConcurrently) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            world.registerIssueGenerator(new MissingClassnameIssueGenerator());
+            world.registerIssueGenerator(new UnsafeIssueGenerator());
+            
+            const size_t entityCount = 4000;
+            EntityList entities;
+            for (size_t i = 0; i < entityCount; ++i) {
+                entities.push_back(world.createEntity());
+                world.defaultLayer()->addChild(entities.back());
+            }
+            
+            IssueTracker tracker(4);
+            tracker.reset(&world);
+            ASSERT_TRUE(tracker.update(world.registeredIssueGenerators(), entityCount + 2));
+            
+            IssueList issues = tracker.issues();
+            ASSERT_EQ(2 * entityCount, issues.size());
+            
+            // the issues are numbered in document order, regardless of the threads that generated them
+            std::sort(std::begin(issues), std::end(issues), CompareSeqId());
+            for (size_t i = 0; i < entityCount; ++i) {
+                ASSERT_EQ(entities[i], issues[2 * i]->node());
+                ASSERT_EQ(entities[i], issues[2 * i + 1]->node());
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "MemoryUsage.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+#include "Model/Layer.h"
+#include "Model/MapFormat.h"
+#include "Model/MeasureMemoryUsageVisitor.h"
+#include "Model/World.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(MeasureMemoryUsageVisitorTest, measureWorld) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            
+            Entity* entity = world.createEntity();
+            entity->addOrUpdateAttribute("classname", "info_player_start");
+            entity->addOrUpdateAttribute("origin", "0 0 0");
+            world.defaultLayer()->addChild(entity);
+            
+            BrushBuilder builder(&world, worldBounds);
+            Brush* brush = builder.createCube(64.0, "texture");
+            world.defaultLayer()->addChild(brush);
+            
+            MemoryUsage usage;
+            measureMemoryUsage(&world, usage);
+            
+            ASSERT_EQ(1u, usage.entry("World")->count);
+            ASSERT_EQ(1u, usage.entry("Layers")->count);
+            ASSERT_EQ(1u, usage.entry("Entities")->count);
+            ASSERT_EQ(1u, usage.entry("Brushes")->count);
+            ASSERT_EQ(6u, usage.entry("Brush faces")->count);
+            ASSERT_EQ(8u, usage.entry("Brush geometry vertices")->count);
+            ASSERT_EQ(12u, usage.entry("Brush geometry edges")->count);
+            ASSERT_EQ(24u, usage.entry("Brush geometry half edges")->count);
+            ASSERT_EQ(6u, usage.entry("Brush geometry faces")->count);
+            ASSERT_TRUE(usage.entry("Groups") == NULL);
+            
+            const size_t worldAttributes = world.attributes().size();
+            ASSERT_EQ(worldAttributes + 2u, usage.entry("Entity attributes")->count);
+            
+            size_t total = 0;
+            for (const MemoryUsage::Entry& entry : usage.entries())
+                total += entry.bytes;
+            ASSERT_EQ(total, usage.totalBytes());
+            ASSERT_LT(sizeof(World) + sizeof(Entity) + sizeof(Brush), total);
+        }
+        
+        static size_t attributeBytes(const AttributableNode* node) {
+            const EntityAttribute::List& attributes = node->attributes();
+            size_t bytes = attributes.capacity() * sizeof(EntityAttribute);
+            for (const EntityAttribute& attribute : attributes)
+                bytes += attribute.name().size() + attribute.value().size();
+            return bytes;
+        }
+        
+        TEST(MeasureMemoryUsageVisitorTest, measureAttributes) {
+            const BBox3 worldBounds(8192.0);
+            World world(MapFormat::Standard, NULL, worldBounds);
+            
+            Entity* entity = world.createEntity();
+            entity->addOrUpdateAttribute("classname", "info_player_start");
+            entity->addOrUpdateAttribute("origin", "0 0 0");
+            entity->addOrUpdateAttribute("angle", "90");
+            world.defaultLayer()->addChild(entity);
+            
+            MemoryUsage usage;
+            measureMemoryUsage(&world, usage);
+            
+            const MemoryUsage::Entry* entry = usage.entry("Entity attributes");
+            ASSERT_TRUE(entry != NULL);
+            ASSERT_EQ(world.attributes().size() + 3u, entry->count);
+            ASSERT_EQ(attributeBytes(&world) + attributeBytes(entity), entry->bytes);
+            ASSERT_LE(3u * sizeof(EntityAttribute), attributeBytes(entity));
+        }
+        
+        TEST(MeasureMemoryUsageVisitorTest, addToCategory) {
+            MemoryUsage usage;
+            usage.add("Nodes", 1, 100);
+            usage.add("Faces", 6, 600);
+            usage.add("Nodes", 2, 200);
+            
+            ASSERT_EQ(2u, usage.entries().size());
+            ASSERT_EQ("Nodes", usage.entries()[0].category);
+            ASSERT_EQ(3u, usage.entries()[0].count);
+            ASSERT_EQ(300u, usage.entries()[0].bytes);
+            ASSERT_EQ(900u, usage.totalBytes());
+        }
+    }
+}
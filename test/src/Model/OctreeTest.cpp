@@ -73,5 +73,26 @@ namespace TrenchBroom {
             octree.addObject(aBounds, a);
             ASSERT_THROW(octree.removeObject(b), OctreeException);
         }
+        
+        TEST(OctreeTest, findObjectsIntersectingBounds) {
+            const BBox3f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Octree<float,int> octree(bounds, minSize);
+            
+            const int a = 1;
+            const int b = 2;
+            const BBox3f aBounds(Vec3f(-100.0f, -100.0f, -100.0f), Vec3f(-90.0f, -90.0f, -90.0f));
+            const BBox3f bBounds(Vec3f(90.0f, 90.0f, 90.0f), Vec3f(100.0f, 100.0f, 100.0f));
+            octree.addObject(aBounds, a);
+            octree.addObject(bBounds, b);
+            
+            const Octree<float,int>::List aResult = octree.findObjects(BBox3f(Vec3f(-95.0f, -95.0f, -95.0f), Vec3f(-80.0f, -80.0f, -80.0f)));
+            ASSERT_TRUE(VectorUtils::contains(aResult, a));
+            ASSERT_FALSE(VectorUtils::contains(aResult, b));
+            
+            const Octree<float,int>::List bothResult = octree.findObjects(BBox3f(-100.0f, +100.0f));
+            ASSERT_TRUE(VectorUtils::contains(bothResult, a));
+            ASSERT_TRUE(VectorUtils::contains(bothResult, b));
+        }
     }
 }
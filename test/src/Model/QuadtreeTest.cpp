@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "VecMath.h"
+#include "Model/Quadtree.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(QuadtreeTest, insertObject) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const BBox2f aBounds(1.0f, 2.0f);
+            quadtree.addObject(aBounds, a);
+            ASSERT_TRUE(quadtree.containsObject(aBounds, a));
+        }
+        
+        TEST(QuadtreeTest, insertTooLargeObject) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const BBox2f aBounds(-129.0f, 2.0f);
+            ASSERT_THROW(quadtree.addObject(aBounds, a), OctreeException);
+        }
+        
+        TEST(QuadtreeTest, removeExistingObject) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const BBox2f aBounds(1.0f, 2.0f);
+            quadtree.addObject(aBounds, a);
+            
+            ASSERT_TRUE(quadtree.containsObject(aBounds, a));
+            quadtree.removeObject(a);
+            ASSERT_FALSE(quadtree.containsObject(aBounds, a));
+        }
+        
+        TEST(QuadtreeTest, removeNonExistingObject) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const int b = 2;
+            const BBox2f aBounds(1.0f, 2.0f);
+            quadtree.addObject(aBounds, a);
+            ASSERT_THROW(quadtree.removeObject(b), OctreeException);
+        }
+        
+        TEST(QuadtreeTest, updateObject) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const BBox2f aBounds(Vec2f(-100.0f, -100.0f), Vec2f(-90.0f, -90.0f));
+            const BBox2f newBounds(Vec2f(90.0f, 90.0f), Vec2f(100.0f, 100.0f));
+            quadtree.addObject(aBounds, a);
+            quadtree.updateObject(newBounds, a);
+            
+            ASSERT_FALSE(quadtree.containsObject(aBounds, a));
+            ASSERT_TRUE(quadtree.containsObject(newBounds, a));
+        }
+        
+        TEST(QuadtreeTest, findObjectsContainingPoint) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const int b = 2;
+            const BBox2f aBounds(Vec2f(-100.0f, -100.0f), Vec2f(-90.0f, -90.0f));
+            const BBox2f bBounds(Vec2f(90.0f, 90.0f), Vec2f(100.0f, 100.0f));
+            quadtree.addObject(aBounds, a);
+            quadtree.addObject(bBounds, b);
+            
+            const Quadtree<float,int>::List result = quadtree.findObjects(Vec2f(-95.0f, -95.0f));
+            ASSERT_TRUE(VectorUtils::contains(result, a));
+            ASSERT_FALSE(VectorUtils::contains(result, b));
+        }
+        
+        TEST(QuadtreeTest, findObjectsIntersectingBounds) {
+            const BBox2f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Quadtree<float,int> quadtree(bounds, minSize);
+            
+            const int a = 1;
+            const int b = 2;
+            const BBox2f aBounds(Vec2f(-100.0f, -100.0f), Vec2f(-90.0f, -90.0f));
+            const BBox2f bBounds(Vec2f(90.0f, 90.0f), Vec2f(100.0f, 100.0f));
+            quadtree.addObject(aBounds, a);
+            quadtree.addObject(bBounds, b);
+            
+            const Quadtree<float,int>::List aResult = quadtree.findObjects(BBox2f(Vec2f(-95.0f, -95.0f), Vec2f(-80.0f, -80.0f)));
+            ASSERT_TRUE(VectorUtils::contains(aResult, a));
+            ASSERT_FALSE(VectorUtils::contains(aResult, b));
+            
+            const Quadtree<float,int>::List bothResult = quadtree.findObjects(BBox2f(-100.0f, +100.0f));
+            ASSERT_TRUE(VectorUtils::contains(bothResult, a));
+            ASSERT_TRUE(VectorUtils::contains(bothResult, b));
+        }
+    }
+}
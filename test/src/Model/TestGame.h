@@ -44,7 +44,7 @@ namespace TrenchBroom {
             size_t doMaxPropertyLength() const;
             
             World* doNewMap(MapFormat::Type format, const BBox3& worldBounds) const;
-            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, Logger* logger) const;
+            World* doLoadMap(MapFormat::Type format, const BBox3& worldBounds, const IO::Path& path, IO::ParserStatus& status, Logger* logger) const;
             void doWriteMap(World* world, const IO::Path& path) const;
             void doExportMap(World* world, Model::ExportFormat format, const IO::Path& path) const;
             
@@ -56,5 +56,32 @@ namespace TrenchBroom {
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
+        
+        void assertBatchedTexCoords(const TexCoordSystem& coordSystem, const BrushFaceAttributes& attribs) {
+            Vec3::List points;
+            points.push_back(Vec3(0.0, 0.0, 0.0));
+            points.push_back(Vec3(16.0, -32.0, 8.0));
+            points.push_back(Vec3(-123.5, 77.25, 1024.0));
+            points.push_back(Vec3(3.0, 5.0, -7.0));
+            points.push_back(Vec3(0.1, 0.2, 0.3));
+            
+            Vec2f::List result(points.size());
+            coordSystem.getTexCoords(&points.front(), points.size(), attribs, &result.front());
+            
+            for (size_t i = 0; i < points.size(); ++i)
+                ASSERT_EQ(coordSystem.getTexCoords(points[i], attribs), result[i]);
+        }
+        
+        TEST(TexCoordSystemTest, batchedTexCoordsMatchSingleTexCoords) {
+            BrushFaceAttributes attribs("");
+            attribs.setOffset(Vec2f(3.0f, -7.5f));
+            attribs.setScale(Vec2f(0.5f, 2.0f));
+            
+            const ParaxialTexCoordSystem paraxial(Vec3::PosZ, attribs);
+            assertBatchedTexCoords(paraxial, attribs);
+            
+            const ParallelTexCoordSystem parallel(Vec3(1.0, 1.0, 0.0).normalized(), Vec3(0.0, 0.0, 1.0));
+            assertBatchedTexCoords(parallel, attribs);
+        }
     }
 }
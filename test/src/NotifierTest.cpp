@@ -47,6 +47,8 @@ namespace TrenchBroom {
         MOCK_METHOD0(notify0, void());
         MOCK_METHOD1(notify1, void(const int&));
         MOCK_METHOD2(notify2, void(const int&, const int&));
+        MOCK_METHOD1(notifyList, void(const std::vector<int>&));
+        MOCK_METHOD1(notify1List, void(const std::vector<int>&));
     };
     
     TEST(NotifierTest, testAddRemoveObservers) {
@@ -114,4 +116,66 @@ namespace TrenchBroom {
         obs.notify1(2);
         obs.notify2(1, 2);
     }
+    
+    TEST(NotifierTest, testCoalesceNotifications) {
+        typedef std::vector<int> List;
+        
+        Observer o;
+        Notifier1<const List&> notifier;
+        notifier.addObserver(&o, &Observer::notifyList);
+        
+        CoalescingNotifier<int> coalescing(notifier);
+        
+        EXPECT_CALL(o, notifyList(List({ 1, 2 })));
+        coalescing(List({ 1, 2 }));
+        
+        coalescing.beginBatch();
+        coalescing(List({ 3, 1 }));
+        coalescing.beginBatch();
+        coalescing(List({ 1, 4, 5 }));
+        coalescing.endBatch();
+        coalescing.discard(List({ 5 }));
+        
+        EXPECT_CALL(o, notifyList(List({ 3, 1, 4 })));
+        coalescing.endBatch();
+        ASSERT_FALSE(coalescing.batching());
+    }
+    
+    TEST(NotifierTest, testCoalesceBeforeNotifications) {
+        typedef std::vector<int> List;
+        
+        Observer o;
+        Notifier1<const List&> before;
+        Notifier1<const List&> after;
+        before.addObserver(&o, &Observer::notify1List);
+        after.addObserver(&o, &Observer::notifyList);
+        
+        CoalescingNotifier<int> coalescing(after);
+        coalescing.beginBatch();
+        
+        const List items1({ 1, 2 });
+        const List items2({ 2, 3 });
+        const List items3({ 2 });
+        
+        EXPECT_CALL(o, notify1List(List({ 1, 2 })));
+        {
+            CoalescingNotifier<int>::NotifyBeforeAndAfter notify(before, coalescing, items1);
+        }
+        
+        EXPECT_CALL(o, notify1List(List({ 3 })));
+        {
+            CoalescingNotifier<int>::NotifyBeforeAndAfter notify(before, coalescing, items2);
+        }
+        
+        EXPECT_CALL(o, notifyList(List({ 1, 2, 3 })));
+        coalescing.flush();
+        
+        EXPECT_CALL(o, notify1List(List({ 2 })));
+        {
+            CoalescingNotifier<int>::NotifyBeforeAndAfter notify(before, coalescing, items3);
+        }
+        
+        EXPECT_CALL(o, notifyList(List({ 2 })));
+        coalescing.endBatch();
+    }
 }
@@ -145,6 +145,42 @@ TEST(PolyhedronTest, swap) {
     ASSERT_EQ(original.bounds(), rhs.bounds());
 }
 
+TEST(PolyhedronTest, initWithTopology) {
+    const Polyhedron3d original(BBox3d(8.0));
+    
+    Vec3d::List positions;
+    std::map<const Vertex*, size_t> indices;
+    const Vertex* firstVertex = original.vertices().front();
+    const Vertex* currentVertex = firstVertex;
+    do {
+        indices[currentVertex] = positions.size();
+        positions.push_back(currentVertex->position());
+        currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+    
+    std::vector<size_t> faceSizes;
+    std::vector<size_t> faceIndices;
+    const Face* firstFace = original.faces().front();
+    const Face* currentFace = firstFace;
+    do {
+        faceSizes.push_back(currentFace->boundary().size());
+        for (const HalfEdge* halfEdge : currentFace->boundary())
+            faceIndices.push_back(indices[halfEdge->origin()]);
+        currentFace = currentFace->next();
+    } while (currentFace != firstFace);
+    
+    Polyhedron3d::Callback callback;
+    const Polyhedron3d restored(positions, faceSizes, faceIndices, callback);
+    ASSERT_EQ(original, restored);
+    ASSERT_EQ(original.bounds(), restored.bounds());
+    ASSERT_EQ(original.edgeCount(), restored.edgeCount());
+    
+    // dropping a face leaves the polyhedron open
+    faceIndices.resize(faceIndices.size() - faceSizes.back());
+    faceSizes.pop_back();
+    ASSERT_THROW(Polyhedron3d(positions, faceSizes, faceIndices, callback), GeometryException);
+}
+
 TEST(PolyhedronTest, convexHullWithFailingPoints) {
     const Vec3d p1(-64.0,    -45.5049, -34.4752);
     const Vec3d p2(-64.0,    -43.6929, -48.0);
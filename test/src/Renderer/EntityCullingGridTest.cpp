@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "Model/Entity.h"
+#include "Model/EntityAttributes.h"
+#include "Renderer/EntityCullingGrid.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static Model::Entity* createEntity(const String& origin) {
+            Model::Entity* entity = new Model::Entity();
+            entity->addOrUpdateAttribute(Model::AttributeNames::Origin, origin);
+            return entity;
+        }
+        
+        TEST(EntityCullingGridTest, findEntitiesInFrustum) {
+            Model::EntityList entities;
+            entities.push_back(createEntity("0 0 0"));
+            entities.push_back(createEntity("2000 0 0"));
+            entities.push_back(createEntity("-3000 0 0"));
+            entities.push_back(createEntity("0 996 0"));
+            
+            EntityCullingGrid grid;
+            grid.build(entities);
+            ASSERT_EQ(4u, grid.entityCount());
+            
+            const Plane3f frustumPlanes[4] = {
+                Plane3f(1000.0f, Vec3f::PosX),
+                Plane3f(1000.0f, Vec3f::NegX),
+                Plane3f(1000.0f, Vec3f::PosY),
+                Plane3f(1000.0f, Vec3f::NegY)
+            };
+            
+            Model::EntityList result;
+            grid.findEntities(frustumPlanes, Vec3f::Null, Vec3f::PosX, 0.0f, result);
+            ASSERT_EQ(2u, result.size());
+            ASSERT_TRUE(VectorUtils::contains(result, entities[0]));
+            ASSERT_TRUE(VectorUtils::contains(result, entities[3]));
+            
+            VectorUtils::clearAndDelete(entities);
+        }
+        
+        TEST(EntityCullingGridTest, findEntitiesWithinDistance) {
+            Model::EntityList entities;
+            entities.push_back(createEntity("0 0 0"));
+            entities.push_back(createEntity("2000 0 0"));
+            entities.push_back(createEntity("-3000 0 0"));
+            
+            EntityCullingGrid grid;
+            grid.build(entities);
+            
+            const Plane3f frustumPlanes[4] = {
+                Plane3f(5000.0f, Vec3f::PosX),
+                Plane3f(5000.0f, Vec3f::NegX),
+                Plane3f(5000.0f, Vec3f::PosY),
+                Plane3f(5000.0f, Vec3f::NegY)
+            };
+            
+            Model::EntityList result;
+            grid.findEntities(frustumPlanes, Vec3f::Null, Vec3f::PosX, 1500.0f, result);
+            ASSERT_EQ(2u, result.size());
+            ASSERT_TRUE(VectorUtils::contains(result, entities[0]));
+            ASSERT_TRUE(VectorUtils::contains(result, entities[2]));
+            
+            grid.clear();
+            ASSERT_EQ(0u, grid.entityCount());
+            
+            VectorUtils::clearAndDelete(entities);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/RenderProfiler.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST(RenderProfilerTest, disabledProfilerRecordsNothing) {
+            RenderProfiler profiler;
+            profiler.beginFrame("View");
+            profiler.beginSection("Section");
+            RenderProfiler::countDrawCall(3);
+            profiler.endSection();
+            profiler.endFrame();
+            
+            ASSERT_TRUE(profiler.views().empty());
+            ASSERT_TRUE(profiler.lastFrame("View").empty());
+        }
+        
+        TEST(RenderProfilerTest, recordNestedSections) {
+            RenderProfiler profiler;
+            profiler.setEnabled(true);
+            
+            profiler.beginFrame("View");
+            RenderProfiler::countUpload(64);
+            {
+                RenderProfiler::Scope outer(&profiler, "Outer");
+                RenderProfiler::countDrawCall(3);
+                {
+                    RenderProfiler::Scope inner(&profiler, "Inner");
+                    RenderProfiler::countDrawCall(6);
+                    RenderProfiler::countTextureBind();
+                }
+            }
+            RenderProfiler::Scope ignored(NULL, "Ignored");
+            profiler.endFrame();
+            
+            const StringList views = profiler.views();
+            ASSERT_EQ(1u, views.size());
+            ASSERT_EQ(String("View"), views.front());
+            
+            const RenderProfiler::SectionList& sections = profiler.lastFrame("View");
+            ASSERT_EQ(3u, sections.size());
+            
+            ASSERT_EQ(String("Frame"), sections[0].name);
+            ASSERT_EQ(0u, sections[0].depth);
+            ASSERT_EQ(2u, sections[0].counters.drawCalls);
+            ASSERT_EQ(9u, sections[0].counters.vertices);
+            ASSERT_EQ(64u, sections[0].counters.uploadedBytes);
+            ASSERT_EQ(1u, sections[0].counters.textureBinds);
+            ASSERT_FALSE(sections[0].hasGpuTime());
+            
+            ASSERT_EQ(String("Outer"), sections[1].name);
+            ASSERT_EQ(1u, sections[1].depth);
+            ASSERT_EQ(2u, sections[1].counters.drawCalls);
+            ASSERT_EQ(0u, sections[1].counters.uploadedBytes);
+            
+            ASSERT_EQ(String("Inner"), sections[2].name);
+            ASSERT_EQ(2u, sections[2].depth);
+            ASSERT_EQ(1u, sections[2].counters.drawCalls);
+            ASSERT_EQ(6u, sections[2].counters.vertices);
+            ASSERT_EQ(1u, sections[2].counters.textureBinds);
+            
+            ASSERT_LE(sections[2].cpuTime, sections[1].cpuTime);
+            ASSERT_LE(sections[1].cpuTime, sections[0].cpuTime);
+            
+            profiler.setEnabled(false);
+            ASSERT_TRUE(profiler.lastFrame("View").empty());
+        }
+    }
+}
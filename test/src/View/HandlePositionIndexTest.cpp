@@ -0,0 +1,116 @@
+
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "VecMath.h"
+#include "View/HandlePositionIndex.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace View {
+        Vec3::List makeGrid(size_t count);
+        Vec3::List makeGrid(const size_t count) {
+            Vec3::List result;
+            for (size_t x = 0; x < count; ++x) {
+                for (size_t y = 0; y < count; ++y) {
+                    for (size_t z = 0; z < count; ++z)
+                        result.push_back(Vec3(static_cast<FloatType>(x), static_cast<FloatType>(y), static_cast<FloatType>(z)));
+                }
+            }
+            return result;
+        }
+        
+        TEST(HandlePositionIndexTest, findInEmptyIndex) {
+            HandlePositionIndex index;
+            ASSERT_TRUE(index.empty());
+            
+            const auto all = [](const BBox3& /* bounds */) { return true; };
+            const auto allPositions = [](const Vec3& /* position */) { return true; };
+            ASSERT_TRUE(index.find(all, allPositions).empty());
+        }
+        
+        TEST(HandlePositionIndexTest, findAll) {
+            const Vec3::List positions = makeGrid(8);
+            
+            HandlePositionIndex index;
+            index.build(positions);
+            ASSERT_EQ(positions.size(), index.size());
+            
+            const auto all = [](const BBox3& /* bounds */) { return true; };
+            const auto allPositions = [](const Vec3& /* position */) { return true; };
+            Vec3::List found = index.find(all, allPositions);
+            
+            Vec3::List expected = positions;
+            std::sort(std::begin(found), std::end(found));
+            std::sort(std::begin(expected), std::end(expected));
+            ASSERT_EQ(expected, found);
+        }
+        
+        TEST(HandlePositionIndexTest, findInBox) {
+            const Vec3::List positions = makeGrid(8);
+            
+            HandlePositionIndex index;
+            index.build(positions);
+            
+            const BBox3 query(Vec3(1.5, 2.5, 3.5), Vec3(3.5, 4.5, 5.5));
+            size_t visitedNodes = 0;
+            const auto boundsTest = [&](const BBox3& bounds) { ++visitedNodes; return bounds.intersects(query); };
+            const auto positionTest = [&](const Vec3& position) { return query.contains(position); };
+            Vec3::List found = index.find(boundsTest, positionTest);
+            
+            Vec3::List expected;
+            for (const Vec3& position : positions) {
+                if (query.contains(position))
+                    expected.push_back(position);
+            }
+            
+            std::sort(std::begin(found), std::end(found));
+            std::sort(std::begin(expected), std::end(expected));
+            ASSERT_EQ(8u, expected.size());
+            ASSERT_EQ(expected, found);
+            ASSERT_LT(visitedNodes, positions.size() / 16);
+        }
+        
+        TEST(HandlePositionIndexTest, findDuplicatePositions) {
+            Vec3::List positions(100, Vec3(1.0, 2.0, 3.0));
+            positions.push_back(Vec3(5.0, 5.0, 5.0));
+            
+            HandlePositionIndex index;
+            index.build(positions);
+            
+            const BBox3 query(Vec3(0.0, 0.0, 0.0), Vec3(4.0, 4.0, 4.0));
+            const auto boundsTest = [&](const BBox3& bounds) { return bounds.intersects(query); };
+            const auto positionTest = [&](const Vec3& position) { return query.contains(position); };
+            ASSERT_EQ(100u, index.find(boundsTest, positionTest).size());
+        }
+        
+        TEST(HandlePositionIndexTest, clear) {
+            HandlePositionIndex index;
+            index.build(makeGrid(4));
+            ASSERT_FALSE(index.empty());
+            
+            index.clear();
+            ASSERT_TRUE(index.empty());
+            ASSERT_EQ(0u, index.size());
+        }
+    }
+}
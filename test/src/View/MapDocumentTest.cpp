@@ -30,6 +30,8 @@
 #include "Model/World.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
+#include "View/VertexHandleManager.h"
+#include "View/VertexTool.h"
 
 namespace TrenchBroom {
     namespace View {
@@ -166,5 +168,82 @@ namespace TrenchBroom {
             
             document->setTexture(nullptr);
         }
+        
+        TEST_F(MapDocumentTest, pasteCopiedWorldBrush) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+            
+            const String str = document->serializeSelectedNodes();
+            ASSERT_EQ(PT_Node, document->paste(str));
+            
+            const Model::NodeList& selectedNodes = document->selectedNodes().nodes();
+            ASSERT_EQ(1u, selectedNodes.size());
+            
+            Model::Node* clone = selectedNodes.front();
+            ASSERT_NE(brush, clone);
+            ASSERT_EQ(document->currentParent(), clone->parent());
+            ASSERT_EQ(brush->bounds(), clone->bounds());
+        }
+        
+        TEST_F(MapDocumentTest, pasteCopiedEntityBrush) {
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            
+            Model::Entity* entity = new Model::Entity();
+            entity->addOrUpdateAttribute("classname", "func_door");
+            document->addNode(entity, document->currentParent());
+            
+            Model::Brush* brush1 = builder.createCuboid(BBox3(Vec3(0, 0, 0), Vec3(32, 64, 64)), "texture");
+            Model::Brush* brush2 = builder.createCuboid(BBox3(Vec3(32, 0, 0), Vec3(64, 64, 64)), "texture");
+            document->addNode(brush1, entity);
+            document->addNode(brush2, entity);
+            document->select(brush1);
+            
+            const String str = document->serializeSelectedNodes();
+            ASSERT_EQ(PT_Node, document->paste(str));
+            
+            const Model::NodeList& selectedNodes = document->selectedNodes().nodes();
+            ASSERT_EQ(1u, selectedNodes.size());
+            
+            Model::Node* brushClone = selectedNodes.front();
+            Model::Node* entityClone = brushClone->parent();
+            ASSERT_NE(entity, entityClone);
+            ASSERT_EQ(document->currentParent(), entityClone->parent());
+            ASSERT_EQ(1u, entityClone->childCount());
+            ASSERT_EQ(brush1->bounds(), brushClone->bounds());
+            ASSERT_EQ(2u, entity->childCount());
+        }
+        
+        static void checkHandleCounts(const VertexHandleManager& handleManager, const Model::Brush* brush) {
+            ASSERT_EQ(brush->vertexCount(), handleManager.totalVertexCount());
+            ASSERT_EQ(brush->edgeCount(), handleManager.totalEdgeCount());
+            ASSERT_EQ(brush->faceCount(), handleManager.totalSelectedFaceCount());
+        }
+        
+        TEST_F(MapDocumentTest, undoRedoVertexMoveKeepsHandleCounts) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+            
+            VertexTool tool(document);
+            ASSERT_TRUE(tool.activate());
+            checkHandleCounts(tool.handleManager(), brush);
+            
+            Model::VertexToBrushesMap vertices;
+            vertices[Vec3(16.0, 16.0, 16.0)].insert(brush);
+            ASSERT_TRUE(document->moveVertices(vertices, Vec3(0.0, 0.0, 16.0)).success);
+            checkHandleCounts(tool.handleManager(), brush);
+            
+            document->undoLastCommand();
+            checkHandleCounts(tool.handleManager(), brush);
+            
+            document->redoNextCommand();
+            checkHandleCounts(tool.handleManager(), brush);
+            
+            document->undoLastCommand();
+            checkHandleCounts(tool.handleManager(), brush);
+            
+            tool.deactivate();
+        }
     }
 }